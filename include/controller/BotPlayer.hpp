@@ -0,0 +1,155 @@
+#pragma once
+
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+#include "core/MoveGenerator.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tetris::controller {
+
+// Fixed set of helper threads for bot searches. One pool can be shared by
+// any number of bots; concurrent parallelFor() calls are serialized.
+class BotWorkerPool {
+public:
+    // `helperThreads` extra threads; 0 runs every task on the caller.
+    explicit BotWorkerPool(unsigned helperThreads = defaultHelperThreads());
+    ~BotWorkerPool();
+
+    BotWorkerPool(const BotWorkerPool&) = delete;
+    BotWorkerPool& operator=(const BotWorkerPool&) = delete;
+
+    // Distinct `slot` values a task may see (helpers + calling thread).
+    std::size_t slotCount() const noexcept { return workers_.size() + 1; }
+
+    // Runs task(index, slot) for every index in [0, count) on the helpers
+    // and the calling thread, and returns once all of them have finished.
+    // Tasks running at the same time never share a slot.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& task);
+
+    static unsigned defaultHelperThreads() noexcept;
+
+private:
+    std::vector<std::thread> workers_;
+
+    std::mutex runMutex_; // one parallelFor at a time
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    const std::function<void(std::size_t, std::size_t)>* task_{nullptr};
+    std::size_t count_{0};
+    std::atomic<std::size_t> next_{0};
+    std::size_t busy_{0};
+    std::uint64_t generation_{0};
+    bool stopping_{false};
+
+    void workerLoop(std::size_t slot);
+    void drain(std::size_t slot);
+};
+
+// Heuristic weights; a board scores the weighted sum of its features.
+struct BotWeights {
+    double aggregateHeight{-0.510066};
+    double linesCleared{0.760666};
+    double holes{-0.35663};
+    double bumpiness{-0.184483};
+};
+
+struct BotConfig {
+    // Boards kept per search level
+    int beamWidth{8};
+    // Preview pieces searched after the active one (capped by the game's preview)
+    int lookahead{1};
+    // Wall-clock limit for one search. The active piece's placements are
+    // always scored, so the bot still moves when the budget is exhausted.
+    std::chrono::microseconds thinkBudget{2000};
+    // Time between placements when driven through update()
+    std::chrono::milliseconds placementInterval{250};
+    BotWeights weights{};
+};
+
+// Computer player. Enumerates reachable placements with MoveGenerator,
+// beam-searches them over the active piece plus `lookahead` preview
+// pieces, and plays the best one through the controller's handleAction.
+template <typename GameT>
+class BasicBotPlayer {
+public:
+    using Controller = BasicGameController<GameT>;
+    using Duration = typename Controller::Duration;
+    using Clock = typename Controller::Clock;
+    using BoardT = typename GameT::BoardType;
+
+    // The pool is optional and not owned; without one the search runs on
+    // the calling thread.
+    explicit BasicBotPlayer(BotConfig config = {}, BotWorkerPool* pool = nullptr);
+
+    // Advances the bot's clock and plays at most one piece whenever
+    // placementInterval has elapsed. Returns true if a piece was played.
+    bool update(GameT& game, Controller& controller, Duration elapsed);
+
+    // Same, with an outside deadline (e.g. one budget shared by several
+    // bots): the search also stops at `deadline`, and a piece that comes
+    // due after it has passed is not searched but stays due for the next
+    // call.
+    bool update(GameT& game, Controller& controller, Duration elapsed,
+                typename Clock::time_point deadline);
+
+    // Searches and immediately plays the active piece.
+    // Returns false if there is no active piece or the game is not running.
+    bool playPiece(GameT& game, Controller& controller);
+
+    // Picks a placement for the active piece and writes the inputs that
+    // reach it (ending in HardDrop) to `out`, without touching the game.
+    // The search ends at thinkBudget or `deadline`, whichever comes first;
+    // the first level is always searched so there is a move to play.
+    bool plan(const GameT& game, std::vector<InputAction>& out);
+    bool plan(const GameT& game, std::vector<InputAction>& out,
+              typename Clock::time_point deadline);
+
+    const BotConfig& config() const noexcept { return config_; }
+
+    // Pieces fully searched by the last plan() (1 = active piece only)
+    int lastSearchDepth() const noexcept { return lastDepth_; }
+
+private:
+    struct Node {
+        BoardT board;
+        double score;
+        int lines;       // lines cleared along the path so far
+        int firstMove;   // index into the root placements
+        std::uint32_t order{0}; // position among its level's candidates, breaks score ties
+    };
+
+    BotConfig config_;
+    BotWorkerPool* pool_;
+    Duration accumulated_{0};
+    int lastDepth_{0};
+
+    std::vector<tetris::core::MoveGenerator> generators_; // one per pool slot
+    std::vector<Node> beam_;
+    std::vector<std::vector<Node>> children_; // per beam node, merged in order
+    std::vector<Node> merged_;
+    std::vector<tetris::core::Tetromino> pieces_; // active piece, then the searched preview
+    std::vector<InputAction> inputs_;
+
+    double evaluate(const BoardT& board, int lines) const noexcept;
+    void expand(const Node& parent, const tetris::core::Tetromino& piece,
+                tetris::core::MoveGenerator& generator, bool root, std::vector<Node>& out) const;
+    void selectBeam();
+    void forEach(std::size_t count, const std::function<void(std::size_t, std::size_t)>& task);
+};
+
+using BotPlayer = BasicBotPlayer<tetris::core::GameState>;
+using DynamicBotPlayer = BasicBotPlayer<tetris::core::DynamicGameState>;
+
+extern template class BasicBotPlayer<tetris::core::GameState>;
+extern template class BasicBotPlayer<tetris::core::DynamicGameState>;
+
+} // namespace tetris::controller
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace tetris::controller {
+
+// Turns variable frame times into a whole number of fixed simulation ticks.
+//
+// Frame time is accumulated in integer nanoseconds scaled so that a tick is
+// an exact integer amount, so no rounding error builds up: after N seconds
+// of real time, floor(N * ticksPerSecond) ticks have been due, whatever the
+// frame rate was. Two peers fed the same wall time therefore run the same
+// number of ticks.
+//
+// At most `maxCatchUpTicks` can be pending at once; time beyond that (a
+// long hitch, a debugger break) is dropped and counted instead of being
+// simulated in one burst.
+//
+//     clock.accumulate(frameTime);
+//     while (clock.step()) {
+//         controller.update(clock.lastTickDuration());
+//     }
+//     render(clock.alpha());
+class FixedTimestep {
+public:
+    using Nanoseconds  = std::chrono::nanoseconds;
+    using Milliseconds = std::chrono::milliseconds;
+
+    static constexpr std::uint32_t DefaultTicksPerSecond = 240;
+    static constexpr std::uint32_t DefaultMaxCatchUpTicks = 24; // 100 ms at 240 Hz
+
+    // `ticksPerSecond` ticks of 1/ticksPerSecond s each (>= 1).
+    explicit FixedTimestep(std::uint32_t ticksPerSecond = DefaultTicksPerSecond,
+                           std::uint32_t maxCatchUpTicks = DefaultMaxCatchUpTicks);
+
+    // Ticks of a whole number of milliseconds (>= 1), e.g. a lockstep tick.
+    static FixedTimestep withPeriod(Milliseconds period,
+                                    std::uint32_t maxCatchUpTicks = DefaultMaxCatchUpTicks);
+
+    // Add real time that passed since the last call.
+    void accumulate(Nanoseconds frameTime);
+    void accumulateSeconds(float frameSeconds);
+
+    // Ticks due but not run yet (never more than maxCatchUpTicks()).
+    std::uint32_t pending() const noexcept;
+
+    // Mark `count` pending ticks as run (clamped to pending()). A caller
+    // that could not run every pending tick keeps the rest for later.
+    void consume(std::uint32_t count) noexcept;
+
+    // Consume one pending tick; false if none is due.
+    bool step() noexcept;
+
+    // Ticks run since construction or reset().
+    std::uint64_t tick() const noexcept { return tick_; }
+
+    // Simulated time at the start of `tick`, rounded down to whole
+    // milliseconds. Consecutive differences add up exactly, so feeding
+    // them to a millisecond-based controller does not drift.
+    Milliseconds timeAt(std::uint64_t tick) const noexcept;
+    Milliseconds elapsed() const noexcept { return timeAt(tick_); }
+    Milliseconds lastTickDuration() const noexcept;
+
+    // Fraction of the next tick already accumulated, in [0, 1): how far
+    // rendering sits between the last simulated tick and the next one.
+    float alpha() const noexcept;
+
+    std::uint32_t maxCatchUpTicks() const noexcept { return maxCatchUp_; }
+
+    // Ticks skipped by the catch-up bound.
+    std::uint64_t droppedTicks() const noexcept { return dropped_; }
+
+    void reset() noexcept;
+
+private:
+    FixedTimestep(std::uint64_t scale, std::uint64_t unitsPerTick, std::uint32_t maxCatchUpTicks);
+
+    // One nanosecond is `scale_` accumulator units; one tick is
+    // `unitsPerTick_` units.
+    std::uint64_t scale_;
+    std::uint64_t unitsPerTick_;
+    std::uint32_t maxCatchUp_;
+
+    std::uint64_t accumulated_{0}; // includes the pending ticks
+    std::uint64_t tick_{0};
+    std::uint64_t dropped_{0};
+};
+
+} // namespace tetris::controller
@@ -1,23 +1,37 @@
 #pragma once
 
 #include "core/GameState.hpp"
+#include "core/Span.hpp"
 #include "controller/InputAction.hpp"
 #include <chrono>
+#include <cstddef>
 
 namespace tetris::controller {
 
-class GameController {
+// Drives a BasicGameState (input + gravity timing).
+template <typename GameT>
+class BasicGameController {
 public:
     using Clock = std::chrono::steady_clock;
     using Duration = std::chrono::milliseconds;
 
     // Controller does not own the GameState; caller keeps it alive.
-    explicit GameController(tetris::core::GameState& game);
+    explicit BasicGameController(GameT& game);
 
     // Called by UI or main loop when some input happens
     // Handle a single discrete player action (e.g. key press).
     void handleAction(InputAction  action);
 
+    // Handle a batch of actions (e.g. everything a client sent since the
+    // last frame) in one pass through GameState::applyCommands(). Actions
+    // must be in timestamp order; one stamped earlier than an action before
+    // it is stale and rejected. If `accepted` is not empty it receives one
+    // flag per action (see applyCommands; PauseResume counts when it
+    // toggles). Returns the number accepted. Throws std::length_error if
+    // `accepted` is non-empty but shorter than `actions`.
+    std::size_t handleActions(core::Span<const TimedInputAction> actions,
+                              core::Span<bool> accepted = {});
+
     // Called periodically with elapsed time since last call.
     // It accumulates time and performs gravity ticks when the
     // accumulated time exceeds the current gravity interval.
@@ -26,9 +40,27 @@ public:
     // Reset timing accumulator (e.g. when game is reset)
     void resetTiming();
 
+    // Gravity time accumulated toward the next tick. Saved and restored
+    // together with the game when rolling a simulation back.
+    Duration accumulatedTime() const noexcept { return accumulated_; }
+    void restoreTiming(Duration accumulated) noexcept { accumulated_ = accumulated; }
+
+    // How far the game is toward its next gravity step, in [0, 1]: the
+    // accumulated time plus `ahead` (time that passed but was not fed to
+    // update() yet, e.g. FixedTimestep::alpha() of a tick), over the
+    // gravity interval. 0 when the game is not running. For drawing the
+    // falling piece between rows; the game itself only moves whole rows.
+    float gravityProgress(std::chrono::duration<float, std::milli> ahead = {}) const noexcept;
+
 private:
-    tetris::core::GameState& game_;
+    GameT& game_;
     Duration accumulated_{0};
 };
 
+using GameController = BasicGameController<tetris::core::GameState>;
+using DynamicGameController = BasicGameController<tetris::core::DynamicGameState>;
+
+extern template class BasicGameController<tetris::core::GameState>;
+extern template class BasicGameController<tetris::core::DynamicGameState>;
+
 } // namespace tetris::controller
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace tetris::controller {
 
 // Discrete player input actions.
@@ -14,4 +16,11 @@ enum class InputAction {
     PauseResume
 };
 
+// An action stamped with when it was made (e.g. the sender's clientTick),
+// for GameController::handleActions().
+struct TimedInputAction {
+    InputAction action{InputAction::MoveLeft};
+    std::uint64_t timestamp{0};
+};
+
 } // namespace tetris::controller
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Board.hpp"
+#include "LevelManager.hpp"
+#include "PieceQueue.hpp"
+#include "ScoreManager.hpp"
+#include "Tetromino.hpp"
+#include "TetrominoFactory.hpp"
+#include "GameState.hpp"
+#include "controller/InputAction.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace tetris::core {
+
+// Headless engine that runs many standard 20 x 10 games side by side.
+// State is kept as structure-of-arrays: all boards in one contiguous block
+// of row masks, all active pieces in parallel arrays, all scores together.
+// Every game follows exactly the rules of GameState driven by a
+// GameController: same inputs, same seed and same elapsed times give the
+// same boards, pieces, scores and levels.
+//
+// All storage is sized in the constructor; stepping never allocates.
+class BatchSimulator {
+public:
+    using Duration = std::chrono::milliseconds;
+    using RowBits = std::uint16_t;
+
+    static constexpr int Rows = 20;
+    static constexpr int Cols = 10;
+    static constexpr RowBits FullRow = (RowBits{1} << Cols) - 1;
+
+    explicit BatchSimulator(std::size_t games, int startingLevel = 0);
+
+    std::size_t size() const noexcept { return status_.size(); }
+
+    // Equivalent of GameState::setSeed(seed) + start() for one game / all games
+    void start(std::size_t game, std::uint64_t seed);
+    void startAll(std::uint64_t firstSeed); // game i gets firstSeed + i
+
+    // Equivalent of GameController::handleAction
+    void applyAction(std::size_t game, tetris::controller::InputAction action);
+
+    // Equivalent of GameController::update for one game / every game
+    void update(std::size_t game, Duration elapsed);
+    void updateAll(Duration elapsed);
+
+    // ---- Per-game queries ----
+    GameStatus status(std::size_t game) const noexcept { return static_cast<GameStatus>(status_[game]); }
+    std::uint64_t score(std::size_t game) const noexcept { return scores_[game].score(); }
+    int level(std::size_t game) const noexcept { return levels_[game].level(); }
+    std::uint64_t linesCleared(std::size_t game) const noexcept { return levels_[game].totalLinesCleared(); }
+    std::uint64_t lockedPieces(std::size_t game) const noexcept { return lockedPieces_[game]; }
+    std::optional<Tetromino> activeTetromino(std::size_t game) const;
+
+    // Occupancy of one row (bit c = column c)
+    RowBits rowMask(std::size_t game, int row) const noexcept { return rows_[game * Rows + row]; }
+    std::optional<TetrominoType> cellType(std::size_t game, int row, int col) const noexcept {
+        return BoardTypes::decodeType(codes_[(game * Rows + row) * Cols + col]);
+    }
+
+    // Contiguous row masks of every game, game-major (Rows entries per game)
+    const RowBits* rowData() const noexcept { return rows_.data(); }
+
+private:
+    int startingLevel_;
+
+    // Boards
+    std::vector<RowBits> rows_;
+    std::vector<BoardTypes::CellCode> codes_;
+
+    // Active pieces
+    std::vector<std::uint8_t> hasPiece_;
+    std::vector<TetrominoType> pieceType_;
+    std::vector<Rotation> pieceRot_;
+    std::vector<std::int8_t> pieceRow_;
+    std::vector<std::int8_t> pieceCol_;
+
+    // Rules state
+    std::vector<std::uint8_t> status_;
+    std::vector<ScoreManager> scores_;
+    std::vector<LevelManager> levels_;
+    std::vector<std::uint64_t> lockedPieces_;
+    std::vector<Duration::rep> gravity_;
+
+    // Piece sequence
+    std::vector<TetrominoFactory> factories_;
+    std::vector<PieceQueue> queues_;
+
+    bool canPlace(std::size_t game, TetrominoType type, Rotation rot, int row, int col) const noexcept;
+    bool tryMove(std::size_t game, int dRow, int dCol) noexcept;
+    bool tryRotate(std::size_t game, bool clockwise) noexcept;
+    int dropDistance(std::size_t game) const noexcept;
+    bool spawn(std::size_t game);
+    void lockAndClear(std::size_t game);
+    bool tick(std::size_t game);
+    void hardDrop(std::size_t game);
+    bool running(std::size_t game) const noexcept {
+        return status_[game] == static_cast<std::uint8_t>(GameStatus::Running);
+    }
+};
+
+} // namespace tetris::core
@@ -2,6 +2,10 @@
 
 #include "Types.hpp"
 #include "Tetromino.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <optional>
 
@@ -12,45 +16,231 @@ enum class CellState : std::uint8_t {
     Filled
 };
 
-class Board {
+// Marks a BasicBoard dimension that is only known at runtime.
+inline constexpr int DynamicExtent = -1;
+
+// Types and limits shared by every board size.
+struct BoardTypes {
+    // Packed occupancy of one row: bit `c` is set when column `c` is filled.
+    using RowMask = std::uint32_t;
+
+    // Set of row indices: bit `r` is set when row `r` is a member.
+    using RowSet = std::uint64_t;
+
+    // Largest board the packed representations can hold.
+    static constexpr int MaxRows = 64;
+    static constexpr int MaxCols = 32;
+
+    // Outcome of a line clear.
+    struct LineClear {
+        int count{0};
+        RowSet rows{0}; // pre-clear indices of the removed rows
+
+        bool contains(int row) const noexcept { return (rows >> row) & 1U; }
+    };
+
+    // Zobrist-style hash of the board contents (occupancy + cell types).
+    using Hash = std::uint64_t;
+
+    // Modification counter used for dirty-row tracking. Every mutation
+    // advances the board epoch and stamps the rows it touched. A board sees
+    // a handful of mutations per piece, so 32 bits do not wrap in practice.
+    using Epoch = std::uint32_t;
+
+    // One byte per cell recording which tetromino filled it:
+    // 0 = empty or unknown type, otherwise TetrominoType + 1.
+    using CellCode = std::uint8_t;
+    static constexpr CellCode NoType = 0;
+
+    static constexpr CellCode encodeType(TetrominoType type) noexcept {
+        return static_cast<CellCode>(static_cast<CellCode>(type) + 1U);
+    }
+    static constexpr std::optional<TetrominoType> decodeType(CellCode code) noexcept {
+        if (code == NoType) return std::nullopt;
+        return static_cast<TetrominoType>(code - 1U);
+    }
+
+    // Read-only view of one row: occupancy bits plus the row's cell codes,
+    // which are contiguous in memory (row r + 1 follows row r). No bounds
+    // checks; meant for consumers that sweep the whole board.
+    struct RowView {
+        RowMask bits{0};
+        const CellCode* codes{nullptr};
+        int cols{0};
+
+        bool filled(int col) const noexcept { return (bits >> col) & 1U; }
+        std::optional<TetrominoType> type(int col) const noexcept { return decodeType(codes[col]); }
+    };
+};
+
+namespace detail {
+
+// Fixed-size storage: everything lives inline, dimensions are constants.
+template <int Rows, int Cols>
+struct BoardStorage {
+    static_assert(Rows > 0 && Cols > 0, "Board dimensions must be positive");
+    static_assert(Rows <= BoardTypes::MaxRows && Cols <= BoardTypes::MaxCols,
+                  "Board is limited to 64 rows and 32 columns");
+
+    BoardStorage(int rows, int cols) {
+        if (rows != Rows || cols != Cols) {
+            throw std::invalid_argument("Board dimensions do not match the fixed board size");
+        }
+    }
+
+    static constexpr int rows() noexcept { return Rows; }
+    static constexpr int cols() noexcept { return Cols; }
+
+    std::array<BoardTypes::RowMask, Rows> rowBits{};
+    std::array<BoardTypes::CellCode, Rows * Cols> typeGrid{};
+    std::array<int, Cols> surface{};
+    std::array<BoardTypes::Epoch, Rows> rowEpoch{};
+    std::array<BoardTypes::Hash, Rows> rowHash{};
+};
+
+// Runtime-sized storage for custom boards.
+template <>
+struct BoardStorage<DynamicExtent, DynamicExtent> {
+    BoardStorage(int rows, int cols) : rowCount{rows}, colCount{cols} {
+        if (rows <= 0 || cols <= 0) {
+            throw std::invalid_argument("Board dimensions must be positive");
+        }
+        if (rows > BoardTypes::MaxRows || cols > BoardTypes::MaxCols) {
+            throw std::invalid_argument("Board is limited to 64 rows and 32 columns");
+        }
+        rowBits.resize(static_cast<std::size_t>(rows));
+        typeGrid.resize(static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols));
+        surface.resize(static_cast<std::size_t>(cols));
+        rowEpoch.resize(static_cast<std::size_t>(rows));
+        rowHash.resize(static_cast<std::size_t>(rows));
+    }
+
+    int rows() const noexcept { return rowCount; }
+    int cols() const noexcept { return colCount; }
+
+    int rowCount;
+    int colCount;
+    std::vector<BoardTypes::RowMask> rowBits;
+    std::vector<BoardTypes::CellCode> typeGrid;
+    std::vector<int> surface;
+    std::vector<BoardTypes::Epoch> rowEpoch;
+    std::vector<BoardTypes::Hash> rowHash;
+};
+
+} // namespace detail
+
+// Playfield of `Rows` x `Cols` cells. With both dimensions fixed the board
+// keeps all of its state inline (no heap allocation, compile-time index
+// math); BasicBoard<DynamicExtent, DynamicExtent> takes its size at runtime.
+template <int Rows, int Cols>
+class BasicBoard : public BoardTypes {
 public:
-    Board(int rows, int cols);
+    BasicBoard(int rows, int cols);
 
-    int rows() const noexcept { return rows_; }
-    int cols() const noexcept { return cols_; }
+    int rows() const noexcept { return storage_.rows(); }
+    int cols() const noexcept { return storage_.cols(); }
 
     CellState cell(int row, int col) const;
     void setCell(int row, int col, CellState state);
 
+    // Fill a cell with a known piece type (setCell(Filled) leaves it untyped)
+    void fillCell(int row, int col, TetrominoType type);
+
     // If the cell is filled, returns which tetromino type filled it (if known).
     // This is used by GUIs to render colored locked blocks.
     std::optional<TetrominoType> cellType(int row, int col) const;
 
+    // Raw occupancy bits of a row (no bounds check).
+    RowMask rowMask(int row) const noexcept { return storage_.rowBits[row]; }
+
+    // Occupancy and types of a whole row in one read (no bounds check).
+    RowView row(int row) const noexcept {
+        return RowView{storage_.rowBits[row], storage_.typeGrid.data() + index(row, 0), cols()};
+    }
+
+    // Mask with the low cols() bits set, i.e. the value of a full row.
+    RowMask fullRowMask() const noexcept { return fullRow_; }
+
+    // Height of the column skyline: number of rows from the bottom up to
+    // and including the highest filled cell (0 for an empty column).
+    int columnHeight(int col) const;
+
+    // Number of rows the tetromino can fall from its current position before
+    // it would collide. Uses the skyline and the piece's column profile, so
+    // it costs O(piece width) instead of one canPlace per row.
+    // Returns 0 if the piece cannot be placed where it is.
+    int dropDistance(const Tetromino& tetromino) const noexcept;
+
     // Check if tetromino can be placed (no collision with walls or filled cells)
     bool canPlace(const Tetromino& tetromino) const noexcept;
 
     // Lock tetromino into the board (mark its blocks as Filled)
     void lockTetromino(const Tetromino& tetromino);
 
+    // Remove every full row in a single compaction pass (each surviving
+    // row moves at most once) and report which rows were removed.
+    LineClear clearLines();
+
     // Clear full lines, return number of cleared lines
-    int clearFullLines();
+    int clearFullLines() { return clearLines().count; }
+
+    // Empty every cell in place (keeps the storage, no reallocation)
+    void clear() noexcept;
+
+    // 64-bit hash of occupancy and cell types, kept up to date
+    // incrementally: O(1) per changed cell, O(rows) per line clear.
+    // Equal boards of the same size always have equal hashes; an empty
+    // board hashes to 0.
+    Hash hash() const noexcept { return hash_; }
+
+    // Dirty-row tracking. Each consumer remembers the epoch() it last synced
+    // at and asks for the rows changed since then; any number of consumers
+    // can follow the same board independently. A fresh board starts at
+    // epoch 1 with every row stamped, so dirtyRowsSince(0) is every row.
+    Epoch epoch() const noexcept { return epoch_; }
+    RowSet dirtyRowsSince(Epoch since) const noexcept;
 
     // True if any filled cell is in the "spawn zone"
     bool isGameOver() const noexcept;
 
 private:
-    int rows_;
-    int cols_;
-    std::vector<CellState> grid_; // rows_ * cols_
-    std::vector<std::optional<TetrominoType>> typeGrid_; // same size as grid_
+    detail::BoardStorage<Rows, Cols> storage_;
+    RowMask fullRow_;
+    Epoch epoch_{0};
+    Hash hash_{0};
 
     int index(int row, int col) const noexcept {
-        return row * cols_ + col;
+        return row * cols() + col;
     }
 
+    static RowMask bit(int col) noexcept {
+        return RowMask{1} << col;
+    }
+
+    // Start a new epoch / stamp a range of rows with the current one
+    void beginChange() noexcept { ++epoch_; }
+    void markRows(int first, int last) noexcept;
+
+    // Flip one filled cell (column + type code) in or out of the hash
+    void toggleCellHash(int row, int col, CellCode code) noexcept;
+    void rebuildHash() noexcept;
+
+    // Recompute the skyline for one column / for every column
+    void rebuildSurface(int col) noexcept;
+    void rebuildSurface() noexcept;
+
     bool isInside(int row, int col) const noexcept {
-        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+        return row >= 0 && row < rows() && col >= 0 && col < cols();
     }
 };
 
+// Board sized at runtime (custom game sizes, tools, tests)
+using Board = BasicBoard<DynamicExtent, DynamicExtent>;
+
+// The standard 20 x 10 playfield
+using StandardBoard = BasicBoard<20, 10>;
+
+extern template class BasicBoard<DynamicExtent, DynamicExtent>;
+extern template class BasicBoard<20, 10>;
+
 } // namespace tetris::core
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "BatchSimulator.hpp"
+#include "Tetromino.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace tetris::core {
+
+// Bulk queries over many boards stored as BatchSimulator lays them out:
+// BatchSimulator::Rows 16-bit row masks per board, boards back to back
+// (see BatchSimulator::rowData()). Each kernel has a scalar version and,
+// where the build allows, SSE2 and AVX2 versions that produce identical
+// output.
+//
+// SSE2 is available on every x86-64 build. AVX2 is compiled in only when
+// the compiler targets it (TETRIS_ENABLE_AVX2 in CMake).
+enum class KernelIsa : std::uint8_t {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// True if `isa` was compiled into this build.
+bool kernelIsaAvailable(KernelIsa isa) noexcept;
+
+// Widest instruction set compiled into this build.
+KernelIsa bestKernelIsa() noexcept;
+
+// out[b] bit r is set when row r of board b is full.
+void batchFullRows(const BatchSimulator::RowBits* boards, std::size_t count,
+                   std::uint32_t* out, KernelIsa isa = bestKernelIsa()) noexcept;
+
+// out[b] = 1 when `piece` (same pose on every board) overlaps a filled
+// cell of board b or leaves the board, 0 when it fits.
+void batchCollisions(const BatchSimulator::RowBits* boards, std::size_t count,
+                     const Tetromino& piece, std::uint8_t* out,
+                     KernelIsa isa = bestKernelIsa()) noexcept;
+
+// out[b * Cols + c] = height of column c of board b (0 = empty column,
+// Rows = filled up to the top row), like Board::columnHeight.
+void batchColumnHeights(const BatchSimulator::RowBits* boards, std::size_t count,
+                        std::uint8_t* out, KernelIsa isa = bestKernelIsa()) noexcept;
+
+} // namespace tetris::core
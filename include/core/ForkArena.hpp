@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tetris::core {
+
+// Bump allocator over caller-owned memory, used for speculative copies
+// (GameState::fork). Nothing is freed individually: reset() drops every
+// object at once, so only trivially destructible types belong here.
+class ForkArena {
+public:
+    ForkArena(void* buffer, std::size_t bytes) noexcept
+        : base_{static_cast<unsigned char*>(buffer)}
+        , capacity_{bytes}
+    {
+    }
+
+    // Aligned block of `size` bytes, or nullptr when the arena is full
+    void* allocate(std::size_t size, std::size_t align) noexcept {
+        const auto start = reinterpret_cast<std::uintptr_t>(base_) + used_;
+        const auto aligned = (start + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+        const std::size_t end = static_cast<std::size_t>(aligned - reinterpret_cast<std::uintptr_t>(base_)) + size;
+        if (end > capacity_) {
+            return nullptr;
+        }
+        used_ = end;
+        return base_ + (end - size);
+    }
+
+    void reset() noexcept { used_ = 0; }
+
+    std::size_t used() const noexcept { return used_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    unsigned char* base_;
+    std::size_t capacity_;
+    std::size_t used_{0};
+};
+
+} // namespace tetris::core
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Tetromino.hpp"
+#include "Types.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace tetris::core {
+
+enum class GameEventKind : std::uint8_t {
+    PieceSpawned, // piece at its spawn position
+    PieceLocked,  // piece at the position it locked in
+    LinesCleared, // lines + rows
+    LevelUp,      // level
+    GameOver
+};
+
+// One thing that happened in a game. Kept to 16 bytes so the log adds
+// little to a GameState copy or fork.
+struct GameEvent {
+    GameEventKind kind{GameEventKind::PieceSpawned};
+    TetrominoType piece{TetrominoType::I}; // PieceSpawned / PieceLocked
+    Rotation rotation{Rotation::R0};       // PieceSpawned / PieceLocked
+    std::int8_t row{0};                    // piece origin
+    std::int8_t col{0};
+    std::uint8_t lines{0};                 // LinesCleared: rows removed
+    std::uint16_t level{0};                // LevelUp: new level
+    BoardTypes::RowSet rows{0};            // LinesCleared: pre-clear row indices
+
+    Position origin() const noexcept { return Position{row, col}; }
+    Tetromino tetromino() const noexcept { return Tetromino{piece, rotation, origin()}; }
+};
+
+// Fixed-size ring of the most recent game events; recording never
+// allocates. Every event gets the next sequence number. Like the board's
+// dirty-row epochs, each consumer keeps its own cursor (the head() it last
+// read up to), so rules, encoders and renderers can follow one game
+// independently. A consumer that falls more than Capacity events behind
+// loses the oldest ones; it can tell by comparing its cursor to oldest().
+class GameEventLog {
+public:
+    using Sequence = std::uint64_t;
+
+    // A piece produces at most four events (spawn, lock, lines, level),
+    // so this covers several pieces between reads.
+    static constexpr std::size_t Capacity = 32;
+
+    void push(const GameEvent& event) noexcept {
+        events_[head_ % Capacity] = event;
+        ++head_;
+    }
+
+    // Sequence number the next event will get.
+    Sequence head() const noexcept { return head_; }
+
+    // Oldest sequence number still held.
+    Sequence oldest() const noexcept { return head_ > Capacity ? head_ - Capacity : 0; }
+
+    // Calls fn(const GameEvent&) for every held event with sequence >= from,
+    // oldest first, and returns the cursor for the next call.
+    template <typename Fn>
+    Sequence forEachSince(Sequence from, Fn&& fn) const {
+        for (Sequence s = std::max(from, oldest()); s < head_; ++s) {
+            fn(events_[s % Capacity]);
+        }
+        return head_;
+    }
+
+private:
+    std::array<GameEvent, Capacity> events_{};
+    Sequence head_{0};
+};
+
+} // namespace tetris::core
@@ -3,9 +3,15 @@
 #include "Board.hpp"
 #include "Tetromino.hpp"
 #include "TetrominoFactory.hpp"
+#include "PieceQueue.hpp"
+#include "Span.hpp"
 #include "ScoreManager.hpp"
 #include "LevelManager.hpp"
+#include "ForkArena.hpp"
+#include "GameEvents.hpp"
+#include <new>
 #include <optional>
+#include <type_traits>
 
 namespace tetris::core {
 
@@ -16,13 +22,38 @@ enum class GameStatus {
     GameOver
 };
 
-class GameState {
+// Piece actions for BasicGameState::applyCommands(), in the same order as
+// the first six controller InputActions.
+enum class PieceCommand : std::uint8_t {
+    MoveLeft,
+    MoveRight,
+    SoftDrop,
+    HardDrop,
+    RotateCW,
+    RotateCCW
+};
+
+// Game rules on top of a board type. Use the GameState alias for the
+// standard 20 x 10 game (fixed-size board, no heap allocation) and
+// DynamicGameState for custom sizes.
+template <typename BoardT>
+class BasicGameState {
 public:
-    GameState(int rows = 20, int cols = 10, int startingLevel = 0);
+    using BoardType = BoardT;
 
-    const Board& board() const noexcept { return board_; }
+    BasicGameState(int rows = 20, int cols = 10, int startingLevel = 0);
+
+    const BoardT& board() const noexcept { return board_; }
     const std::optional<Tetromino>& activeTetromino() const noexcept { return activeTetromino_; }
-    const std::optional<Tetromino>& nextTetromino() const noexcept { return nextTetromino_; }
+    // Next piece at its spawn position (nullopt before start / after reset)
+    std::optional<Tetromino> nextTetromino() const noexcept;
+
+    // Upcoming piece types, next first; previewDepth() entries while a game is on.
+    Span<const TetrominoType> preview() const noexcept { return queue_.preview(); }
+    int previewDepth() const noexcept { return queue_.depth(); }
+
+    // 1..7 pieces (throws std::invalid_argument otherwise)
+    void setPreviewDepth(int depth);
 
     std::uint64_t score() const noexcept { return scoreManager_.score(); }
     int level() const noexcept { return levelManager_.level(); }
@@ -47,30 +78,97 @@ public:
     void rotateClockwise();
     void rotateCounterClockwise();
 
+    // Applies `commands` in order, with the same result as calling the
+    // matching methods above one by one. The status is checked once per
+    // piece and the active piece is moved in a local copy that is written
+    // back before each lock and at the end. If `accepted` is not empty it
+    // receives one flag per command: true for a move or rotation that fit,
+    // a soft drop that moved, and any hard drop. Commands that arrive once
+    // the game is not running are rejected. Returns the number accepted.
+    // Throws std::length_error if `accepted` is non-empty but shorter than
+    // `commands`.
+    std::size_t applyCommands(Span<const PieceCommand> commands, Span<bool> accepted = {});
+
     int gravityIntervalMs() const noexcept;
 
+    // Piece sequence seed. Setting it restarts the piece sequence, so
+    // setSeed(s) followed by start() always deals the same pieces.
+    void setSeed(std::uint64_t seed);
+    std::uint64_t seed() const noexcept { return factory_.seed(); }
+
     // number of times a piece has been locked (since last reset).
     std::uint64_t lockedPieces() const noexcept { return lockedPieces_; }
+
+    // Spawns, locks, line clears, level-ups and game over, as they happen.
+    // Follow it with a cursor instead of diffing counters between steps.
+    // The log survives reset() (sequence numbers keep increasing) and is
+    // not part of snapshots; copying a game copies its log.
+    const GameEventLog& events() const noexcept { return events_; }
+
+    // Independent copy of this game placed in `arena`, for what-if search.
+    // Only for fixed-size boards, where the whole state is trivially
+    // copyable: a fork is a single memcpy and never allocates. Returns
+    // nullptr when the arena is full; ForkArena::reset() drops all forks.
+    template <typename B = BoardT, std::enable_if_t<std::is_trivially_copyable_v<B>, int> = 0>
+    BasicGameState* fork(ForkArena& arena) const {
+        void* slot = arena.allocate(sizeof(BasicGameState), alignof(BasicGameState));
+        return slot ? new (slot) BasicGameState(*this) : nullptr;
+    }
+
+    // Binary snapshot of everything needed to continue the game exactly:
+    // board cells and types, active piece, queued pieces, RNG and bag
+    // position, score, level, line count, lockedPieces() and status.
+    // Little-endian behind a magic + version header; a standard 20 x 10
+    // game takes under 200 bytes.
+    static constexpr std::uint8_t SnapshotVersion = 1;
+    static constexpr std::size_t MaxSnapshotBytes =
+        75 + PieceQueue::Capacity + (BoardTypes::MaxRows * BoardTypes::MaxCols) / 2;
+
+    // Exact size saveSnapshot() will write for this game
+    std::size_t snapshotSize() const noexcept;
+
+    // Writes the snapshot to the front of `out` and returns its size.
+    // Throws std::length_error if `out` is smaller than snapshotSize().
+    std::size_t saveSnapshot(Span<std::uint8_t> out) const;
+
+    // Restores a snapshot taken from a game with the same board size, without
+    // allocating. Throws std::invalid_argument on a bad header, an unknown
+    // version, a board size mismatch or corrupt data; the game is left
+    // unchanged in that case.
+    void loadSnapshot(Span<const std::uint8_t> in);
+
 private:
-    Board board_;
+    BoardT board_;
     TetrominoFactory factory_;
     ScoreManager scoreManager_;
     LevelManager levelManager_;
 
+    PieceQueue queue_;
+
     std::optional<Tetromino> activeTetromino_;
-    std::optional<Tetromino> nextTetromino_;
 
     GameStatus status_{GameStatus::NotStarted};
 
     // monotonic counter of locked tetrominoes.
     std::uint64_t lockedPieces_{0};
 
+    GameEventLog events_;
+
+    Position spawnPosition() const noexcept { return Position{0, board_.cols() / 2}; }
     bool spawnNewTetromino();
     void lockActiveTetrominoAndProcessLines();
+    void recordPiece(GameEventKind kind, const Tetromino& piece) noexcept;
+    void endGame() noexcept; // status_ = GameOver + event
 
     // Helper to try move active tetromino by dx, dy
     bool tryMove(int dRow, int dCol);
     bool tryRotate(bool clockwise);
 };
 
+using GameState = BasicGameState<StandardBoard>;
+using DynamicGameState = BasicGameState<Board>;
+
+extern template class BasicGameState<StandardBoard>;
+extern template class BasicGameState<Board>;
+
 } // namespace tetris::core
@@ -16,6 +16,12 @@ public:
 
     void reset(int startingLevel = 0);
 
+    // Set level and line count directly (snapshot restore)
+    void restore(int level, std::uint64_t totalLinesCleared) noexcept {
+        level_ = level;
+        totalLinesCleared_ = totalLinesCleared;
+    }
+
     int gravityIntervalMs() const noexcept;
 
 private:
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Span.hpp"
+#include "Tetromino.hpp"
+#include "controller/InputAction.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace tetris::core {
+
+// A distinct final position of a piece: where it locks after the shortest
+// input sequence that reaches it.
+struct Placement {
+    Tetromino piece{TetrominoType::I, Rotation::R0, Position{}}; // pose at lock time
+    int inputCount{0};       // length of the shortest path, final HardDrop included
+    std::uint16_t from{0};   // generator node HardDrop is pressed from (see MoveGenerator::path)
+};
+
+// Enumerates every distinct placement the active piece can reach with the
+// game's movement rules (MoveLeft/MoveRight/SoftDrop/RotateCW/RotateCCW,
+// rotations without kicks, then HardDrop). Breadth-first search over
+// (rotation, row, col) states, so every path found is a shortest one.
+//
+// All buffers are owned by the generator and reused between calls; keep one
+// generator per thread and call generate() as often as needed.
+class MoveGenerator {
+public:
+    MoveGenerator();
+
+    // Placements reachable from `piece`'s current pose on `board`. Poses
+    // that cover the same cells (e.g. I in R0 vs R180) are reported once.
+    // Empty if the piece does not fit where it is. The span stays valid
+    // until the next generate() call.
+    template <typename BoardT>
+    Span<const Placement> generate(const BoardT& board, const Tetromino& piece);
+
+    // Shortest input sequence for a placement from the last generate(),
+    // ending with HardDrop. `out` is cleared first.
+    void path(const Placement& placement, std::vector<tetris::controller::InputAction>& out) const;
+
+private:
+    static constexpr int MaxNodes = 4 * BoardTypes::MaxRows * BoardTypes::MaxCols;
+    static constexpr std::uint8_t NoAction = 0xFF;
+
+    int rows_{0};
+    int cols_{0};
+    std::uint32_t generation_{0};
+
+    // Per node (rotation, row, col). Stamps equal to generation_ mean
+    // "visited in this search", so nothing needs clearing between calls.
+    std::array<std::uint32_t, MaxNodes> visited_{};
+    std::array<std::uint32_t, MaxNodes> landed_{};
+    std::array<std::uint16_t, MaxNodes> parent_{};
+    std::array<std::uint8_t, MaxNodes> action_{};
+    std::array<std::uint16_t, MaxNodes> depth_{};
+    std::array<std::uint16_t, MaxNodes> queue_{};
+
+    std::vector<Placement> placements_;
+
+    int encode(int rot, int row, int col) const noexcept { return (rot * rows_ + row) * cols_ + col; }
+    void beginSearch();
+};
+
+} // namespace tetris::core
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Types.hpp"
+#include "Span.hpp"
+#include "TetrominoFactory.hpp"
+#include <array>
+#include <cstdint>
+
+namespace tetris::core {
+
+// Fixed-capacity queue of upcoming piece types. The queue always holds at
+// least depth() pieces once filled; it is topped up from the factory one
+// whole bag (7 pieces) at a time. Every slot is stored twice, at i and
+// i + Capacity, so the upcoming pieces are always one contiguous run and
+// preview() never copies.
+class PieceQueue {
+public:
+    static constexpr int MinDepth = 1;
+    static constexpr int MaxDepth = 7;
+    static constexpr int BatchSize = 7;
+    static constexpr int Capacity = MaxDepth + BatchSize;
+
+    explicit PieceQueue(int depth = 1);
+
+    int depth() const noexcept { return depth_; }
+    int size() const noexcept { return count_; }
+
+    // Throws std::invalid_argument outside [MinDepth, MaxDepth]
+    void setDepth(int depth);
+
+    // Drop every queued piece
+    void clear() noexcept;
+
+    // Top up to at least depth() pieces
+    void fill(TetrominoFactory& factory);
+
+    // Take the front piece and top up again
+    TetrominoType pop(TetrominoFactory& factory);
+
+    // The next depth() pieces, front first (empty before the first fill)
+    Span<const TetrominoType> preview() const noexcept;
+
+    // Every queued piece, front first (size() entries; for snapshots)
+    Span<const TetrominoType> pending() const noexcept;
+
+    // Replace the queue with `pieces`, front first. Throws
+    // std::invalid_argument for a bad depth or more than Capacity pieces.
+    void restore(int depth, Span<const TetrominoType> pieces);
+
+private:
+    std::array<TetrominoType, 2 * Capacity> slots_{};
+    std::uint8_t head_{0};
+    std::uint8_t count_{0};
+    std::uint8_t depth_{1};
+
+    void push(TetrominoType type) noexcept;
+};
+
+} // namespace tetris::core
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace tetris::core {
+
+// PCG32 (XSH-RR variant): 16 bytes of state, fast, and fully determined by
+// its seed, so the same seed gives the same sequence on every platform.
+// Satisfies UniformRandomBitGenerator.
+class Pcg32 {
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr std::uint64_t DefaultStream = 0xDA3E39CB94B95BDBULL;
+
+    explicit Pcg32(std::uint64_t seed = 0, std::uint64_t stream = DefaultStream) noexcept {
+        reseed(seed, stream);
+    }
+
+    void reseed(std::uint64_t seed, std::uint64_t stream = DefaultStream) noexcept {
+        state_ = 0;
+        inc_ = (stream << 1U) | 1U;
+        next();
+        state_ += seed;
+        next();
+    }
+
+    std::uint32_t next() noexcept {
+        const std::uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + inc_;
+        const auto xorshifted = static_cast<std::uint32_t>(((old >> 18U) ^ old) >> 27U);
+        const auto rot = static_cast<std::uint32_t>(old >> 59U);
+        return (xorshifted >> rot) | (xorshifted << ((32U - rot) & 31U));
+    }
+
+    // Uniform value in [0, bound), without modulo bias (Lemire's method).
+    std::uint32_t bounded(std::uint32_t bound) noexcept {
+        std::uint64_t m = static_cast<std::uint64_t>(next()) * bound;
+        auto low = static_cast<std::uint32_t>(m);
+        if (low < bound) {
+            const std::uint32_t threshold = (0U - bound) % bound;
+            while (low < threshold) {
+                m = static_cast<std::uint64_t>(next()) * bound;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32U);
+    }
+
+    // Raw generator state (for snapshots)
+    struct State {
+        std::uint64_t state;
+        std::uint64_t inc;
+    };
+    State state() const noexcept { return State{state_, inc_}; }
+    void restore(const State& s) noexcept {
+        state_ = s.state;
+        inc_ = s.inc | 1U; // the increment must stay odd
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return 0xFFFFFFFFU; }
+    result_type operator()() noexcept { return next(); }
+
+private:
+    std::uint64_t state_{0};
+    std::uint64_t inc_{1};
+};
+
+// 7-bag piece randomizer: every run of 7 pieces is a shuffled permutation
+// of all 7 types. Deterministic for a given seed.
+class SevenBagRandomizer {
+public:
+    explicit SevenBagRandomizer(std::uint64_t seed = 0) noexcept;
+
+    // Restart the sequence for `seed` (discards the current bag)
+    void reseed(std::uint64_t seed) noexcept;
+
+    TetrominoType next() noexcept;
+
+    // Generator plus the partly dealt bag (for snapshots)
+    struct State {
+        Pcg32::State rng;
+        std::array<TetrominoType, 7> bag;
+        std::uint8_t index; // 0..7
+    };
+    State state() const noexcept { return State{rng_.state(), bag_, index_}; }
+    void restore(const State& s) noexcept {
+        rng_.restore(s.rng);
+        bag_ = s.bag;
+        index_ = s.index;
+    }
+
+private:
+    Pcg32 rng_;
+    std::array<TetrominoType, 7> bag_{};
+    std::uint8_t index_{7}; // next unused bag slot; 7 = bag empty
+
+    void refill() noexcept;
+};
+
+} // namespace tetris::core
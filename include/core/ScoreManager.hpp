@@ -18,6 +18,9 @@ public:
 
     void reset() noexcept { score_ = 0; }
 
+    // Set the score directly (snapshot restore)
+    void restore(std::uint64_t score) noexcept { score_ = score; }
+
 private:
     std::uint64_t score_{0};
 };
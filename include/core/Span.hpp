@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tetris::core {
+
+// Non-owning view of a contiguous range (stand-in for C++20 std::span).
+template <typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_{data}, size_{size} {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    constexpr T& front() const noexcept { return data_[0]; }
+
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+private:
+    T* data_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace tetris::core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Types.hpp"
+#include "TetrominoShapes.hpp"
 #include <array>
 
 // Namespace for Tetris core types
@@ -9,7 +10,7 @@ namespace tetris::core {
 // Represents a Tetromino piece in Tetris
 class Tetromino {
 public:
-    static constexpr int BlockCount = 4;
+    static constexpr int BlockCount = ShapeInfo::BlockCount;
 
     using Shape = std::array<Position, BlockCount>;
 
@@ -23,6 +24,9 @@ public:
     void rotateClockwise() noexcept;
     void rotateCounterClockwise() noexcept;
 
+    // Precomputed geometry for the current type + rotation
+    const ShapeInfo& shape() const noexcept { return shapeInfo(type_, rotation_); }
+
     // Positions of the 4 blocks in board coordinates
     Shape blocks() const noexcept;
 
@@ -30,9 +34,6 @@ private:
     TetrominoType type_;
     Rotation rotation_;
     Position origin_; // position of the piece on the board (pivot or reference)
-
-    // For a given type + rotation, returns block offsets relative to origin (0,0)
-    static Shape shapeFor(TetrominoType type, Rotation rotation) noexcept;
 };
 
 } // namespace tetris::core
@@ -2,18 +2,46 @@
 
 #include "Types.hpp"
 #include "Tetromino.hpp"
-#include <random>
+#include "Random.hpp"
+#include <cstdint>
 
 namespace tetris::core {
 
+// Produces the piece sequence for one game (7-bag on a seeded PCG32).
+// The same seed always yields the same sequence.
 class TetrominoFactory {
 public:
+    // Seeded from std::random_device
     TetrominoFactory();
+    explicit TetrominoFactory(std::uint64_t seed);
+
+    // Restart the sequence from `seed`
+    void setSeed(std::uint64_t seed) noexcept;
+    std::uint64_t seed() const noexcept { return seed_; }
+
+    // Next piece type in the sequence
+    TetrominoType nextType() noexcept { return randomizer_.next(); }
 
     // Create next random piece with given origin
     Tetromino createRandom(Position origin);
+
+    // Position in the sequence (for snapshots)
+    struct State {
+        std::uint64_t seed;
+        SevenBagRandomizer::State randomizer;
+    };
+    State state() const noexcept { return State{seed_, randomizer_.state()}; }
+    void restore(const State& s) noexcept {
+        seed_ = s.seed;
+        randomizer_.restore(s.randomizer);
+    }
+
+    // Fresh non-deterministic seed (for games that don't need a fixed one)
+    static std::uint64_t randomSeed();
+
 private:
-    std::mt19937 rng_;
+    std::uint64_t seed_;
+    SevenBagRandomizer randomizer_;
 };
 
 } // namespace tetris::core
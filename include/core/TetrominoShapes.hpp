@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tetris::core {
+
+// Geometry of one tetromino type in one rotation. Everything is derived at
+// compile time from the block offsets, so movement, collision and rendering
+// code only does table lookups.
+struct ShapeInfo {
+    static constexpr int BlockCount = 4;
+    static constexpr int MaxSpan = 4; // a piece never covers more than 4 rows/cols
+
+    // Block offsets relative to the piece origin
+    std::array<Position, BlockCount> blocks{};
+
+    // Bounding box of the offsets (inclusive)
+    int minRow{};
+    int maxRow{};
+    int minCol{};
+    int maxCol{};
+    int height{};
+    int width{};
+
+    // rowMasks[i]: blocks on row (minRow + i), bit j = column (minCol + j)
+    std::array<std::uint8_t, MaxSpan> rowMasks{};
+
+    // Column profile, index j = column (minCol + j):
+    // lowest (largest) and highest (smallest) row offset used in that column.
+    std::array<std::int8_t, MaxSpan> colBottom{};
+    std::array<std::int8_t, MaxSpan> colTop{};
+
+    // Lowest rotation of the same type with exactly the same block offsets
+    // (e.g. R180 of I/S/Z, every rotation of O). Poses that differ only in
+    // these rotations cover the same cells.
+    std::uint8_t canonicalRotation{};
+};
+
+namespace detail {
+
+using RotationOffsets = std::array<Position, ShapeInfo::BlockCount>;
+
+// Block offsets for every type (enum order) and rotation (R0..R270).
+inline constexpr std::array<std::array<RotationOffsets, 4>, 7> kShapeOffsets{{
+    // I
+    {{
+        {{ {0, -1}, {0, 0}, {0, 1}, {0, 2} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {2, 0} }},
+        {{ {0, -1}, {0, 0}, {0, 1}, {0, 2} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {2, 0} }},
+    }},
+    // O
+    {{
+        {{ {0, 0}, {0, 1}, {1, 0}, {1, 1} }},
+        {{ {0, 0}, {0, 1}, {1, 0}, {1, 1} }},
+        {{ {0, 0}, {0, 1}, {1, 0}, {1, 1} }},
+        {{ {0, 0}, {0, 1}, {1, 0}, {1, 1} }},
+    }},
+    // T
+    {{
+        {{ {0, -1}, {0, 0}, {0, 1}, {1, 0} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {0, 1} }},
+        {{ {0, -1}, {0, 0}, {0, 1}, {-1, 0} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {0, -1} }},
+    }},
+    // L
+    {{
+        {{ {0, -1}, {0, 0}, {0, 1}, {1, 1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {1, -1} }},
+        {{ {0, -1}, {0, 0}, {0, 1}, {-1, -1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {-1, 1} }},
+    }},
+    // J
+    {{
+        {{ {0, -1}, {0, 0}, {0, 1}, {1, -1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {-1, -1} }},
+        {{ {0, -1}, {0, 0}, {0, 1}, {-1, 1} }},
+        {{ {-1, 0}, {0, 0}, {1, 0}, {1, 1} }},
+    }},
+    // S
+    {{
+        {{ {0, 0}, {0, 1}, {1, -1}, {1, 0} }},
+        {{ {-1, 0}, {0, 0}, {0, 1}, {1, 1} }},
+        {{ {0, 0}, {0, 1}, {1, -1}, {1, 0} }},
+        {{ {-1, 0}, {0, 0}, {0, 1}, {1, 1} }},
+    }},
+    // Z
+    {{
+        {{ {0, -1}, {0, 0}, {1, 0}, {1, 1} }},
+        {{ {-1, 1}, {0, 0}, {0, 1}, {1, 0} }},
+        {{ {0, -1}, {0, 0}, {1, 0}, {1, 1} }},
+        {{ {-1, 1}, {0, 0}, {0, 1}, {1, 0} }},
+    }},
+}};
+
+constexpr ShapeInfo makeShapeInfo(const RotationOffsets& blocks)
+{
+    ShapeInfo s{};
+    s.blocks = blocks;
+
+    s.minRow = s.maxRow = blocks[0].row;
+    s.minCol = s.maxCol = blocks[0].col;
+    for (const auto& b : blocks) {
+        s.minRow = b.row < s.minRow ? b.row : s.minRow;
+        s.maxRow = b.row > s.maxRow ? b.row : s.maxRow;
+        s.minCol = b.col < s.minCol ? b.col : s.minCol;
+        s.maxCol = b.col > s.maxCol ? b.col : s.maxCol;
+    }
+    s.height = s.maxRow - s.minRow + 1;
+    s.width  = s.maxCol - s.minCol + 1;
+
+    for (int j = 0; j < ShapeInfo::MaxSpan; ++j) {
+        s.colBottom[j] = INT8_MIN;
+        s.colTop[j]    = INT8_MAX;
+    }
+
+    for (const auto& b : blocks) {
+        const int i = b.row - s.minRow;
+        const int j = b.col - s.minCol;
+        s.rowMasks[i] = static_cast<std::uint8_t>(s.rowMasks[i] | (1U << j));
+        if (b.row > s.colBottom[j]) s.colBottom[j] = static_cast<std::int8_t>(b.row);
+        if (b.row < s.colTop[j])    s.colTop[j]    = static_cast<std::int8_t>(b.row);
+    }
+    return s;
+}
+
+constexpr bool sameOffsets(const RotationOffsets& a, const RotationOffsets& b)
+{
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].row != b[i].row || a[i].col != b[i].col) return false;
+    }
+    return true;
+}
+
+constexpr std::array<ShapeInfo, 7 * 4> makeShapeTable()
+{
+    std::array<ShapeInfo, 7 * 4> table{};
+    for (std::size_t type = 0; type < 7; ++type) {
+        for (std::size_t rot = 0; rot < 4; ++rot) {
+            table[type * 4 + rot] = makeShapeInfo(kShapeOffsets[type][rot]);
+        }
+        for (std::size_t rot = 0; rot < 4; ++rot) {
+            std::size_t canonical = rot;
+            for (std::size_t other = 0; other < rot && canonical == rot; ++other) {
+                if (sameOffsets(kShapeOffsets[type][other], kShapeOffsets[type][rot])) {
+                    canonical = other;
+                }
+            }
+            table[type * 4 + rot].canonicalRotation = static_cast<std::uint8_t>(canonical);
+        }
+    }
+    return table;
+}
+
+} // namespace detail
+
+inline constexpr std::array<ShapeInfo, 7 * 4> kShapeTable = detail::makeShapeTable();
+
+// Table lookup for a type + rotation (no branching).
+constexpr const ShapeInfo& shapeInfo(TetrominoType type, Rotation rotation) noexcept
+{
+    return kShapeTable[static_cast<std::size_t>(type) * 4 + static_cast<std::size_t>(rotation)];
+}
+
+} // namespace tetris::core
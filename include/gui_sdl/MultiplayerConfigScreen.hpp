@@ -23,6 +23,8 @@ private:
     int modeIndex_{0}; // 0=TimeAttack, 1=SharedTurns
     int timeLimitSec_{180};
     int piecesPerTurn_{1};
+    bool lockstep_{false};
+    int rollbackWindow_{0};
     int roleIndex_{0}; // 0 = Host, 1 = Join
 };
 
@@ -3,9 +3,13 @@
 #include "gui_sdl/Screen.hpp"
 #include "network/MultiplayerConfig.hpp"
 #include "network/MessageTypes.hpp"
+#include "network/LockstepSession.hpp"
+#include "network/RollbackSession.hpp"
+#include "network/ClientPredictor.hpp"
 #include "core/GameState.hpp"
 #include "core/Types.hpp"
 #include "controller/GameController.hpp"
+#include "controller/FixedTimestep.hpp"
 
 #include <imgui.h>     // ImDrawList / ImU32 / ImVec2
 #include <optional>
@@ -50,15 +54,46 @@ private:
     // -------- SharedTurns (host authoritative + HUD) --------
     tetris::net::PlayerId turnPlayerId_ = 1;     // host starts by default
     std::uint32_t piecesLeftThisTurn_ = 0;       // init from cfg_.piecesPerTurn in ctor
-    bool boardHashInit_ = false;
-    std::uint32_t lastBoardHash_ = 0;
+    tetris::core::GameEventLog::Sequence sharedEventCursor_ = 0; // sharedGame_ locks counted up to here
 
     // in SharedTurns, used to decide who caused the GameOver (last input applier)
     tetris::net::PlayerId lastActionPlayerId_ = 1;
 
     void updateSharedTurnsTurnHost();
 
-    static std::uint32_t boardHash(const tetris::core::Board& b);
+    // Host: seed every local GameState with the seed sent in StartGame
+    void seedGamesFromHost();
+
+    // -------- Lockstep / rollback (cfg_.lockstep on the host, StartGame on clients) --------
+    // Both peers simulate every game from exchanged inputs and copy the
+    // results into the games below for rendering; no StateUpdates are sent.
+    // TimeAttack with a rollback window uses rollback_, which predicts the
+    // opponent's inputs instead of waiting for them. The host still
+    // decides and announces the match result.
+    std::unique_ptr<tetris::net::LockstepSession> lockstep_;
+    std::unique_ptr<tetris::net::RollbackSession> rollback_;
+    tetris::controller::FixedTimestep lockstepClock_; // replaced in startLockstep
+
+    void startLockstep(std::uint64_t seed, std::uint32_t tickMs, std::uint32_t inputDelayTicks,
+                       std::uint32_t rollbackWindowTicks, tetris::net::PlayerId localId);
+
+    // Feeds received frames, runs the ticks that are due, sends our frames
+    // and copies the simulated games out. Returns true if anything arrived.
+    bool updateLockstep(float dtSeconds);
+    template <typename SessionT>
+    bool stepInputSession(SessionT& session, float dtSeconds);
+
+    std::optional<tetris::net::Tick> desyncTick() const;
+
+    // -------- Client-side prediction (TimeAttack with StateUpdates) --------
+    // The client draws its own board from predictor_, which applies inputs
+    // at once and is corrected by each StateUpdate. The host acks the last
+    // clientTick it applied to the opponent's game, and the game time
+    // since it did (see SnapshotTimingDTO).
+    tetris::net::ClientPredictor predictor_;
+    bool predicting_ = false;
+    std::optional<tetris::net::Tick> lastOppInputTick_;
+    tetris::controller::GameController::Duration oppSinceInput_{0};
 
     // -------- Disconnect / net quality --------
     bool hostDisconnected_ = false;       // client: detected host is gone
@@ -97,6 +132,11 @@ private:
     tetris::core::GameState sharedGame_;
     tetris::controller::GameController sharedCtrl_;
 
+    // Gravity for the host games and the client's prediction, in fixed
+    // ticks so both sides step the same way whatever the frame rate.
+    // matchElapsedSec_ follows its simulated time.
+    tetris::controller::FixedTimestep simClock_;
+
     float oppInputAcc_ = 0.0f;
 
     // ---------- INPUT ----------
@@ -107,6 +147,13 @@ private:
                            tetris::controller::InputAction action);
 
     void applyRemoteInputsHost();
+
+    // Remote inputs received this frame, applied in one handleActions() call.
+    // flushRemoteBatch returns the newest clientTick that took effect.
+    std::vector<tetris::controller::TimedInputAction> remoteBatch_;
+    std::unique_ptr<bool[]> remoteAccepted_;
+    std::size_t remoteAcceptedCapacity_ = 0;
+    std::optional<tetris::net::Tick> flushRemoteBatch(tetris::controller::GameController& gc);
     void stepOpponentAI(float dtSeconds);
 
     // ---------- SNAPSHOT (host -> StateUpdate) ----------
@@ -134,7 +181,8 @@ private:
                            ImVec2 topLeft,
                            float cell,
                            bool border,
-                           bool drawActive) const;
+                           bool drawActive,
+                           const tetris::controller::GameController* gravity = nullptr) const;
 
     // --- Hold-to-repeat (same feel as SinglePlayer) ---
     float softDropHoldAccSec_ = 0.0f;
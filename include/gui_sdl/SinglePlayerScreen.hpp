@@ -3,6 +3,7 @@
 #include "gui_sdl/Screen.hpp"
 #include "core/GameState.hpp"
 #include "controller/GameController.hpp"
+#include "controller/FixedTimestep.hpp"
 
 namespace tetris::gui_sdl {
 
@@ -51,6 +52,7 @@ private:
 private:
     tetris::core::GameState gameState_;
     tetris::controller::GameController controller_;
+    tetris::controller::FixedTimestep clock_; // gravity runs in fixed ticks
 
     // Soft drop hold
     float softDropHoldAccumulatorSec_{0.0f};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+#include "network/MessageTypes.hpp"
+#include "core/GameState.hpp"
+#include "core/Span.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+namespace tetris::net {
+
+// Client-side prediction for a host-authoritative game (TimeAttack).
+//
+// The client keeps its own copy of its GameState and applies each input
+// as soon as it is sent, so the piece moves without waiting a round trip.
+// Inputs stay pending until the host acknowledges their clientTick. When
+// a StateUpdate brings the authoritative game (a GameState snapshot) and
+// the last clientTick the host applied, reconcile() restores that state
+// and replays the inputs the host has not seen yet, with the gravity that
+// ran around them since the snapshot was taken.
+//
+// Time is the sum of update() calls since reset(). Each input remembers
+// when it was applied; the host reports how long after applying the acked
+// input it took the snapshot, which places the snapshot on this timeline
+// without the clocks having to agree (see SnapshotTimingDTO).
+class ClientPredictor {
+public:
+    using GameState      = tetris::core::GameState;
+    using GameController = tetris::controller::GameController;
+    using InputAction    = tetris::controller::InputAction;
+    using Duration       = GameController::Duration;
+
+    ClientPredictor();
+
+    ClientPredictor(const ClientPredictor&) = delete;
+    ClientPredictor& operator=(const ClientPredictor&) = delete;
+
+    // Start a fresh predicted game with the match's piece seed.
+    void reset(std::uint64_t seed);
+
+    // Apply an input locally; `clientTick` is the tick it was sent with
+    // (increasing across calls).
+    void applyLocal(InputAction action, Tick clientTick);
+
+    // Local gravity between authoritative updates.
+    void update(Duration elapsed);
+
+    // Adopt the host's game and replay inputs newer than `ackedTick`
+    // (all pending inputs if the host has not applied any yet). With
+    // `timing`, gravity is replayed from the snapshot up to now, between
+    // the inputs as they were applied locally; without it only the inputs
+    // are. Returns false, leaving the prediction untouched, if the snapshot
+    // is invalid.
+    bool reconcile(tetris::core::Span<const std::uint8_t> snapshot,
+                   std::optional<Tick> ackedTick,
+                   const std::optional<SnapshotTimingDTO>& timing = std::nullopt);
+
+    const GameState& game() const noexcept { return m_game; }
+    const GameController& controller() const noexcept { return m_controller; }
+
+    // Inputs sent but not acknowledged yet.
+    std::size_t pendingInputs() const noexcept { return m_pending.size(); }
+
+    // Reconciliations where the replayed state differed from the
+    // prediction (a visible correction).
+    std::uint64_t corrections() const noexcept { return m_corrections; }
+
+private:
+    struct PendingInput {
+        Tick clientTick;
+        InputAction action;
+        Duration appliedAt;
+    };
+
+    GameState m_game;
+    GameController m_controller;
+    std::deque<PendingInput> m_pending;
+    Duration m_time{0};       // local game time, see above
+    Duration m_ackedAt{0};    // when the newest acked input was applied
+    std::uint64_t m_corrections{0};
+};
+
+} // namespace tetris::net
@@ -44,6 +44,7 @@ public:
 
     // Delegate to host input queue.
     std::vector<InputActionMessage> consumePendingInputs();
+    void consumePendingInputs(std::vector<InputActionMessage>& out);
 
     // For SharedTurns, only the "current" player is allowed to send
     // effective inputs. For other modes (e.g. TimeAttack), all players
@@ -54,6 +55,13 @@ public:
     // current authoritative game state.
     void broadcastStateUpdate(const StateUpdate& update);
 
+    // Broadcast an already built message (e.g. a StateUpdate the caller
+    // refills in place), without copying it.
+    void broadcast(const Message& msg);
+
+    // The rules' mode (the configured one if there are no rules).
+    GameMode mode() const;
+
     bool isStarted()  const { return m_started; }
     bool isFinished() const { return m_finished; }
 
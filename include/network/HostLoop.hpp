@@ -1,14 +1,19 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <cstdint>
 #include <string>
 
 #include "network/HostGameSession.hpp"
 #include "network/MessageTypes.hpp"
+#include "network/StateUpdateMapper.hpp"
 #include "core/GameState.hpp"
 #include "core/MatchRules.hpp"
+#include "controller/BotPlayer.hpp"
 #include "controller/GameController.hpp"
 
 namespace tetris::net {
@@ -25,18 +30,36 @@ public:
     using GameStateMap      = std::unordered_map<PlayerId, tetris::core::GameState*>;
     using GameControllerMap = std::unordered_map<PlayerId, tetris::controller::GameController*>;
     using PlayerNameMap     = std::unordered_map<PlayerId, std::string>;
+    using BotMap            = std::unordered_map<PlayerId, tetris::controller::BotPlayer*>;
 
     HostLoop(HostGameSession& session,
              const GameStateMap& gameStates,
              const GameControllerMap& controllers,
              const PlayerNameMap& playerNames);
 
+    // Computer-controlled players (e.g. empty TimeAttack slots, load tests).
+    // Each bot plays through its player's GameController; not owned.
+    // All bots of a step share `thinkBudget`: a bot whose piece comes due
+    // once it is spent waits for a later step, and the bot that goes first
+    // rotates so none is starved.
+    void setBots(const BotMap& bots,
+                 std::chrono::microseconds thinkBudget = std::chrono::microseconds{2000});
+
     // One step of the host loop:
-    // - consumes input messages and forwards them to controllers
+    // - consumes input messages and hands each player's to its controller
+    //   as one batch
+    // - lets bots act, all of them within one think budget (see setBots);
+    //   a step overruns it by at most the first search level of the last
+    //   bot that started
     // - ticks all controllers with `elapsed` time
     // - builds PlayerSnapshot list and asks HostGameSession::update
-    // - detects new locked pieces and notifies HostGameSession
-    // - periodically builds and broadcasts StateUpdate to all clients
+    // - notifies HostGameSession of every piece locked since the last step
+    // - periodically builds and broadcasts StateUpdate to all clients,
+    //   with the last applied clientTick, game snapshot and its timing for
+    //   each player that predicts (see isPredictingPlayer)
+    //
+    // Once every buffer has grown to its working size, a step that does
+    // not finish the match allocates nothing (bots aside).
     //
     // Returns:
     //   - empty vector if match still running
@@ -50,19 +73,62 @@ private:
     GameControllerMap m_controllers;
     PlayerNameMap     m_playerNames;
 
-    // Tracks last known lockedPieces() for each player to detect new locks.
-    std::unordered_map<PlayerId, std::uint64_t> m_lastLockedPieces;
+    // Bots in PlayerId order, so the rotation does not depend on hashing
+    std::vector<std::pair<PlayerId, tetris::controller::BotPlayer*>> m_bots;
+    std::chrono::microseconds m_botBudget{0};
+    std::size_t m_nextBot{0}; // index of the bot that goes first next step
+
+    // Newest clientTick applied per player (rejected and stale inputs do
+    // not count); sent back in StateUpdate so predicting clients know
+    // which inputs the host has seen.
+    std::unordered_map<PlayerId, Tick> m_lastInputTick;
+
+    // Game time since each player's last applied input (since the loop
+    // started before the first), sent with the snapshots (SnapshotTimingDTO).
+    std::unordered_map<PlayerId, Duration> m_sinceInput;
+
+    // Per-step buffers, reused across steps so a running match does not
+    // allocate: inputs taken from the host, inputs of one player being
+    // applied, and the snapshots handed to the rules.
+    std::vector<InputActionMessage> m_inputMessages;
+    std::vector<tetris::controller::TimedInputAction> m_actionBatch;
+    std::unique_ptr<bool[]> m_accepted; // handleActions' flags for m_actionBatch
+    std::size_t m_acceptedCapacity{0};
+    std::vector<tetris::core::PlayerSnapshot> m_snapshots;
+
+    // Event cursor per player: GameState::events() read up to here.
+    // With the player's lockedPieces() at that point: when more events
+    // arrive between steps than the log holds (a long batch of hard
+    // drops), the count tells how many PieceLocked events were lost.
+    struct EventCursor {
+        tetris::core::GameEventLog::Sequence next{0};
+        std::uint64_t lockedPieces{0};
+    };
+    std::unordered_map<PlayerId, EventCursor> m_eventCursor;
+
+    // StateUpdate message refilled in place on every broadcast, so its
+    // players, names, cells and snapshots keep their storage. Player i is
+    // always the i-th game of m_gameStates (the map does not change after
+    // construction); its DTO is refreshed from the board's dirty rows since
+    // m_boardCaches[i] so unchanged rows are not re-exported.
+    Message m_stateMessage;
+    std::vector<StateUpdateMapper::BoardCache> m_boardCaches;
 
     // Accumulator used to send StateUpdate at a fixed interval
     // (e.g. ~20 Hz) instead of every physics step.
     Duration m_stateUpdateAccumulator_{Duration{0}};
 
-    // Detect newly locked pieces and notify rules via HostGameSession.
+    // Notify rules via HostGameSession once per PieceLocked event.
     // SharedTurnRules uses this to rotate turns; TimeAttackRules ignores it.
     void handlePieceLocks(const std::vector<tetris::core::PlayerSnapshot>& snapshots);
 
     // Build and broadcast a StateUpdate so all clients can redraw.
     void sendStateUpdate(Tick currentTick);
+
+    // A TimeAttack player whose inputs arrive over the network, i.e.
+    // neither the host's own nor a bot. Only these predict their game (in
+    // SharedTurns nobody does), so only their DTOs carry a snapshot.
+    bool isPredictingPlayer(PlayerId pid) const;
 };
 
 } // namespace tetris::net
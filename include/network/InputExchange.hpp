@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "network/MessageTypes.hpp"
+#include "controller/InputAction.hpp"
+
+namespace tetris::net {
+
+// Frame and hash bookkeeping shared by LockstepSession and
+// RollbackSession: the sorted player list, the local frames sent once per
+// tick, the outgoing message queue, and the exchange of periodic
+// LockstepHash values with desync detection.
+//
+// What a session does with the frames (wait for them, or predict and
+// roll back) is up to it: sendLocalFrames() and receive() hand every
+// local and remote frame to a callback.
+class InputExchange {
+public:
+    using InputAction = tetris::controller::InputAction;
+
+    // `players` is sorted and deduplicated; throws std::invalid_argument
+    // if `localId` is not in it. Error messages start with `owner`, a
+    // string literal naming the session. Local frames start at
+    // `firstLocalFrame` (earlier ones are empty by definition).
+    InputExchange(const char* owner, PlayerId localId, std::vector<PlayerId> players,
+                  Tick firstLocalFrame);
+
+    const std::vector<PlayerId>& players() const noexcept { return m_players; }
+    PlayerId localId() const noexcept { return m_localId; }
+
+    // Index of `player` in players(); throws std::out_of_range if unknown.
+    std::size_t playerIndex(PlayerId player) const;
+    std::size_t localIndex() const noexcept { return m_localIndex; }
+
+    // Queue a local action for the next local frame.
+    void addLocalInput(InputAction action) { m_pendingLocal.push_back(action); }
+
+    // Send the local frames up to and including `lastTick`, the first one
+    // with the queued actions. `keep(frame)` sees each before it is sent.
+    template <typename KeepFn>
+    void sendLocalFrames(Tick lastTick, KeepFn&& keep);
+
+    // LockstepInputs from a known remote player go to
+    // `onFrame(playerIndex, inputs)`; LockstepHash from a remote player is
+    // compared with ours. Anything else is ignored.
+    template <typename FrameFn>
+    void receive(const Message& msg, FrameFn&& onFrame);
+
+    // Record and send our hash for `tick`, then compare remote hashes up
+    // to it. Ticks must increase from call to call.
+    void recordHash(Tick tick, std::uint64_t hash);
+
+    // First tick at which a remote hash differed from ours, if any.
+    std::optional<Tick> desyncTick() const noexcept { return m_desyncTick; }
+
+    // Messages produced since the last call, in send order.
+    void takeOutgoing(std::vector<Message>& out);
+
+private:
+    const char* m_owner;
+    PlayerId m_localId;
+    std::vector<PlayerId> m_players; // sorted
+    std::size_t m_localIndex{0};
+
+    Tick m_nextLocalFrame{0}; // first local frame tick not sent yet
+    std::vector<InputAction> m_pendingLocal;
+
+    // Our hashes waiting for the matching remote ones, and remote hashes
+    // that arrived before we hashed their tick.
+    std::map<Tick, std::uint64_t> m_localHashes;
+    std::multimap<Tick, std::uint64_t> m_remoteHashes;
+    std::optional<Tick> m_hashedThrough;
+    std::optional<Tick> m_desyncTick;
+
+    std::vector<Message> m_outgoing;
+
+    std::optional<std::size_t> findPlayer(PlayerId player) const;
+    void receiveHash(const LockstepHash& hash);
+    void checkHashes();
+};
+
+template <typename KeepFn>
+void InputExchange::sendLocalFrames(Tick lastTick, KeepFn&& keep)
+{
+    for (; m_nextLocalFrame <= lastTick; ++m_nextLocalFrame) {
+        LockstepInputs frame{ m_localId, m_nextLocalFrame, {} };
+        frame.actions.swap(m_pendingLocal);
+        keep(std::as_const(frame));
+
+        Message msg;
+        msg.kind = MessageKind::LockstepInputs;
+        msg.payload = std::move(frame);
+        m_outgoing.push_back(std::move(msg));
+    }
+}
+
+template <typename FrameFn>
+void InputExchange::receive(const Message& msg, FrameFn&& onFrame)
+{
+    if (const auto* inputs = std::get_if<LockstepInputs>(&msg.payload)) {
+        if (inputs->playerId == m_localId) {
+            return;
+        }
+        if (const auto index = findPlayer(inputs->playerId)) {
+            onFrame(*index, *inputs);
+        }
+        return;
+    }
+
+    if (const auto* hash = std::get_if<LockstepHash>(&msg.payload)) {
+        if (hash->playerId != m_localId) {
+            receiveHash(*hash);
+        }
+    }
+}
+
+} // namespace tetris::net
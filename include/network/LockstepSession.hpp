@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "network/InputExchange.hpp"
+#include "network/MessageTypes.hpp"
+#include "core/GameState.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+namespace tetris::net {
+
+// Deterministic lockstep simulation of a whole match.
+//
+// Every peer runs the same LockstepSession: same players, same seed, same
+// config. Peers only exchange inputs: each peer sends one LockstepInputs
+// per simulation tick listing its actions for that tick (often none), and
+// a tick is simulated once the frames of every player for it are known.
+// Since all peers apply the same inputs in the same order to GameStates
+// seeded identically, they all reach the same state without any board
+// traffic.
+//
+// Local inputs are scheduled `inputDelayTicks` ahead so that frames reach
+// the other peers before they need them. Every `hashIntervalTicks` ticks
+// each peer sends a LockstepHash of its match state; a mismatch with a
+// remote hash marks the session as desynced.
+//
+// The session does not do any I/O: received messages are fed through
+// receive(), and messages to send are collected with takeOutgoing().
+class LockstepSession {
+public:
+    using GameState      = tetris::core::GameState;
+    using GameController = tetris::controller::GameController;
+    using InputAction    = tetris::controller::InputAction;
+
+    struct Config {
+        GameMode mode{GameMode::TimeAttack};
+        std::uint32_t piecesPerTurn{1};      // SharedTurns
+        std::uint32_t tickMs{16};            // simulated time per tick (>= 1)
+        std::uint32_t inputDelayTicks{3};
+        std::uint32_t hashIntervalTicks{60}; // 0 = never exchange hashes
+    };
+
+    // `players` are every participant (local one included); order does
+    // not matter, inputs are always applied in ascending PlayerId order.
+    LockstepSession(PlayerId localId, std::vector<PlayerId> players,
+                    std::uint64_t seed, Config config);
+
+    LockstepSession(const LockstepSession&) = delete;
+    LockstepSession& operator=(const LockstepSession&) = delete;
+
+    // Queue a local action; it is sent with the next local frame and
+    // applied at that frame's tick on every peer.
+    void addLocalInput(InputAction action);
+
+    // Feed a message from a peer. LockstepInputs and LockstepHash are
+    // consumed, anything else is ignored. Frames for ticks that were
+    // already simulated are dropped.
+    void receive(const Message& msg);
+
+    // Simulate up to `maxTicks` ticks whose inputs are complete.
+    // Returns how many ticks ran (0 while waiting for a remote frame).
+    int advance(int maxTicks = 1);
+
+    // Messages produced since the last call, in send order.
+    void takeOutgoing(std::vector<Message>& out) { m_exchange.takeOutgoing(out); }
+
+    // Next tick to simulate (= ticks simulated so far).
+    Tick tick() const noexcept { return m_tick; }
+    std::uint64_t elapsedMs() const noexcept { return m_tick * m_config.tickMs; }
+
+    // True when the frame of `player` for the next tick is missing.
+    bool waitingFor(PlayerId player) const;
+
+    const Config& config() const noexcept { return m_config; }
+    const std::vector<PlayerId>& players() const noexcept { return m_exchange.players(); }
+    PlayerId localId() const noexcept { return m_exchange.localId(); }
+
+    // TimeAttack: one game per player. SharedTurns: every player maps to
+    // the single shared game.
+    const GameState& game(PlayerId player) const;
+
+    // SharedTurns: whose inputs are applied and how many pieces remain.
+    PlayerId turnPlayerId() const noexcept { return m_turnPlayer; }
+    std::uint32_t piecesLeftThisTurn() const noexcept { return m_piecesLeft; }
+
+    // Hash of everything the simulation depends on (boards, pieces,
+    // scores, piece sequence, turn state).
+    std::uint64_t stateHash() const;
+
+    // First tick at which a remote hash differed from ours, if any.
+    bool desynced() const noexcept { return desyncTick().has_value(); }
+    std::optional<Tick> desyncTick() const noexcept { return m_exchange.desyncTick(); }
+
+private:
+    struct PlayerGame {
+        explicit PlayerGame(std::uint64_t seed);
+
+        GameState game;
+        GameController controller;
+    };
+
+    using Frame = std::vector<InputAction>;
+
+    InputExchange m_exchange;
+    Config m_config;
+
+    // One entry per player (TimeAttack) or a single shared game
+    std::vector<std::unique_ptr<PlayerGame>> m_games;
+
+    Tick m_tick{0};
+
+    // Received and local frames not simulated yet, per player index
+    std::vector<std::map<Tick, Frame>> m_frames;
+
+    // SharedTurns
+    PlayerId m_turnPlayer{0};
+    std::uint32_t m_piecesLeft{0};
+
+    std::size_t playerIndex(PlayerId player) const { return m_exchange.playerIndex(player); }
+    PlayerGame& gameFor(std::size_t playerIndex);
+    const PlayerGame& gameFor(std::size_t playerIndex) const;
+
+    bool frameReady(std::size_t playerIndex, Tick tick) const;
+    void sendLocalFrames();
+    void simulateTick();
+    void updateTurn(tetris::core::GameEventLog::Sequence eventsBefore);
+};
+
+} // namespace tetris::net
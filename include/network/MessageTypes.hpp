@@ -28,7 +28,9 @@ enum class MessageKind : std::uint8_t {
     PlayerLeft,     
     Error,
     RematchDecision,
-    KeepAlive
+    KeepAlive,
+    LockstepInputs,
+    LockstepHash
 };
 
 // ---------- Individual message payloads ----------
@@ -47,6 +49,15 @@ struct StartGame {
     std::uint32_t timeLimitSeconds; // TimeAttack
     std::uint32_t piecesPerTurn;    // SharedTurns
     Tick startTick;
+    std::optional<std::uint64_t> pieceSeed{}; // piece sequence seed, if the host shares one
+
+    // Lockstep mode (see LockstepSession): simulated milliseconds per tick
+    // and input delay in ticks. 0 = host-authoritative StateUpdate mode.
+    std::uint32_t lockstepTickMs{0};
+    std::uint32_t inputDelayTicks{0};
+    // > 0: TimeAttack runs a RollbackSession with this window instead of
+    // waiting for every frame (only meaningful with lockstepTickMs).
+    std::uint32_t rollbackWindowTicks{0};
 };
 
 struct InputActionMessage {
@@ -66,6 +77,15 @@ struct BoardDTO {
     std::vector<BoardCellDTO> cells;
 };
 
+// When a PlayerStateDTO's gameSnapshot was taken, in the host's game time:
+// how long after the host applied lastInputTick (after the game started if
+// it has applied none), and the gravity time the player's controller had
+// accumulated toward its next tick.
+struct SnapshotTimingDTO {
+    std::uint32_t sinceInputMs{};
+    std::uint32_t gravityMs{};
+};
+
 struct PlayerStateDTO {
     PlayerId id{};
     std::string name;
@@ -74,6 +94,15 @@ struct PlayerStateDTO {
     int score{};
     int level{};
     bool isAlive{true};
+
+    // Client-side prediction (see ClientPredictor): the last clientTick of
+    // this player's InputActionMessages the host has applied, and the
+    // player's whole game as GameState::saveSnapshot() bytes, with its
+    // timing so the client can replay gravity from the same point. All are
+    // optional; peers that do not predict ignore them.
+    std::optional<Tick> lastInputTick;
+    std::vector<std::uint8_t> gameSnapshot;
+    std::optional<SnapshotTimingDTO> snapshotTiming;
 };
 
 struct StateUpdate {
@@ -124,6 +153,24 @@ struct RematchDecision {
 // "no messages => disconnected" heuristics during post-match/lobby.
 struct KeepAlive {};
 
+// --- Lockstep mode ---
+// Each peer sends exactly one LockstepInputs per simulation tick, with all
+// of its actions for that tick (possibly none): receiving it tells the
+// other peers that the player's input for `tick` is final.
+struct LockstepInputs {
+    PlayerId playerId{};
+    Tick tick{};
+    std::vector<tetris::controller::InputAction> actions;
+};
+
+// Periodic hash of the simulated match after `tick` ticks; peers compare
+// them to detect desyncs.
+struct LockstepHash {
+    PlayerId playerId{};
+    Tick tick{};
+    std::uint64_t hash{};
+};
+
 // ---------- Message envelope ----------
 
 using MessagePayload = std::variant<
@@ -136,7 +183,9 @@ using MessagePayload = std::variant<
     PlayerLeft,    
     ErrorMessage,
     RematchDecision,
-    KeepAlive
+    KeepAlive,
+    LockstepInputs,
+    LockstepHash
 >;
 
 struct Message {
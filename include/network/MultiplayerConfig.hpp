@@ -16,6 +16,16 @@ struct MultiplayerConfig {
     std::uint32_t timeLimitSeconds{180};  // used for TimeAttack (0 = no limit)
     std::uint32_t piecesPerTurn{1};       // used for SharedTurns (>=1)
 
+    std::uint64_t pieceSeed{0};           // piece sequence seed (0 = fresh random seed per match)
+
+    // Lockstep: peers exchange only inputs and simulate every game locally
+    // (see LockstepSession) instead of the host streaming StateUpdates.
+    bool lockstep{false};
+    std::uint32_t lockstepTickMs{16};     // simulated time per tick
+    std::uint32_t inputDelayTicks{3};     // local inputs apply this many ticks later
+    std::uint32_t rollbackWindowTicks{0}; // TimeAttack: > 0 = predict remote inputs and roll back
+                                          // up to this many ticks (see RollbackSession)
+
     std::string hostAddress{"127.0.0.1"}; // used when joining
     std::uint16_t port{5000};             // TCP/UDP port, host or join
 };
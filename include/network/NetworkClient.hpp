@@ -5,6 +5,7 @@
 #include <functional>
 #include <mutex>
 #include <chrono>
+#include <vector>
 
 #include "network/INetworkSession.hpp"
 #include "network/MessageTypes.hpp"
@@ -25,6 +26,10 @@ public:
 
     void sendRematchDecision(bool wantsRematch);
 
+    // Lockstep mode: send a LockstepInputs / LockstepHash produced by the
+    // local LockstepSession (other kinds are ignored).
+    void sendLockstep(const Message& msg);
+
     bool isJoined() const;
     std::optional<PlayerId> playerId() const;
 
@@ -61,6 +66,10 @@ public:
     std::optional<PlayerLeft>   consumePlayerLeft();
     std::optional<ErrorMessage> consumeError();
 
+    // Lockstep messages from the other peers (relayed by the host), in
+    // arrival order; returns them once then clears the queue.
+    std::vector<Message> consumeLockstepMessages();
+
     // For UI: detect liveness even if no StateUpdate is flowing.
     std::chrono::milliseconds timeSinceLastHeard() const;
 
@@ -87,6 +96,8 @@ private:
     std::optional<PlayerLeft> m_lastPlayerLeft;
     std::optional<ErrorMessage> m_lastError;
 
+    std::vector<Message> m_lockstepQueue;
+
     std::chrono::steady_clock::time_point m_lastHeardFromHost{};
 };
 
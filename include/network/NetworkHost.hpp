@@ -31,6 +31,15 @@ public:
 
     std::vector<InputActionMessage> consumeInputQueue();
 
+    // Same, swapping the queue into `out` (cleared first) so a caller that
+    // keeps `out` around recycles both buffers instead of allocating.
+    void consumeInputQueue(std::vector<InputActionMessage>& out);
+
+    // Lockstep mode: LockstepInputs / LockstepHash sent by clients. Each one
+    // is relayed to the other clients on arrival and queued here for the
+    // host's own LockstepSession.
+    std::vector<Message> consumeLockstepMessages();
+
     std::size_t playerCount() const { return m_players.size(); }
     std::vector<LobbyPlayer> getLobbyPlayers() const;
 
@@ -46,6 +55,10 @@ public:
     bool isMatchStarted() const { return m_matchStarted; }
 
     void startMatch();
+
+    // Piece seed announced in the last StartGame; the host seeds its
+    // GameStates with it so every player gets the same piece sequence.
+    std::uint64_t matchSeed() const;
     void onMatchFinished(); // resets m_matchStarted so StartGame can be sent again
 
     void broadcast(const Message& msg);
@@ -70,9 +83,18 @@ private:
     MultiplayerConfig m_config;
     std::unordered_map<PlayerId, PlayerInfo> m_players;
     std::vector<InputActionMessage> m_inputQueue;
+    std::vector<Message> m_lockstepQueue;
+
+    // Spare send lists for broadcast() and poll()'s keepalive, so sending
+    // does not allocate. A call takes the list out under m_mutex and puts
+    // it back when done: a re-entrant or concurrent call (e.g. a handler
+    // that broadcasts) finds it gone and starts a list of its own.
+    std::vector<INetworkSessionPtr> m_broadcastTargets;
+    std::vector<INetworkSessionPtr> m_keepAliveTargets;
 
     bool m_matchStarted{false};
     Tick m_startTick{0};
+    std::uint64_t m_matchSeed{0};
 
     PlayerId m_nextPlayerId{2}; // Starts at 2 to reserve 1 to the host
 
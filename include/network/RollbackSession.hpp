@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "network/InputExchange.hpp"
+#include "network/MessageTypes.hpp"
+#include "core/GameState.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+namespace tetris::net {
+
+// Rollback simulation of a versus match (one game per player).
+//
+// Uses the same wire messages as LockstepSession (one LockstepInputs per
+// player per tick, periodic LockstepHash), but never waits for a remote
+// frame: a missing frame is predicted as "no input" and the match keeps
+// running. The state before each of the last `rollbackWindowTicks` ticks
+// is kept in a ring of GameState copies. When a frame arrives for a tick
+// already simulated and it has inputs, the session restores the state
+// before that tick and re-simulates up to the present with the real
+// inputs. Remote actions therefore land at the tick they were made, so
+// both peers see the same boards.
+//
+// If a peer falls more than the window behind, advance() stops until
+// its frames arrive. Hashes are taken only from fully confirmed ticks.
+class RollbackSession {
+public:
+    using GameState      = tetris::core::GameState;
+    using GameController = tetris::controller::GameController;
+    using InputAction    = tetris::controller::InputAction;
+
+    struct Config {
+        std::uint32_t tickMs{16};              // simulated time per tick (>= 1)
+        std::uint32_t inputDelayTicks{1};      // local inputs apply this many ticks later
+        std::uint32_t rollbackWindowTicks{8};  // max ticks re-simulated (>= 1)
+        std::uint32_t hashIntervalTicks{60};   // 0 = never exchange hashes
+    };
+
+    RollbackSession(PlayerId localId, std::vector<PlayerId> players,
+                    std::uint64_t seed, Config config);
+
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    // Queue a local action for the next local frame.
+    void addLocalInput(InputAction action);
+
+    // Feed LockstepInputs / LockstepHash from a peer; other kinds are
+    // ignored. A late frame with inputs schedules a rollback that runs
+    // at the start of the next advance().
+    void receive(const Message& msg);
+
+    // Roll back if needed, then simulate up to `maxTicks` new ticks.
+    // Returns how many new ticks ran.
+    int advance(int maxTicks = 1);
+
+    // Messages produced since the last call, in send order.
+    void takeOutgoing(std::vector<Message>& out) { m_exchange.takeOutgoing(out); }
+
+    Tick tick() const noexcept { return m_tick; }
+    std::uint64_t elapsedMs() const noexcept { return m_tick * m_config.tickMs; }
+
+    // Every tick before this one was simulated with real inputs only (a
+    // late frame waiting for the next advance() counts as not replayed).
+    Tick confirmedTick() const noexcept;
+    std::uint64_t confirmedElapsedMs() const noexcept { return confirmedTick() * m_config.tickMs; }
+
+    const Config& config() const noexcept { return m_config; }
+    const std::vector<PlayerId>& players() const noexcept { return m_exchange.players(); }
+    PlayerId localId() const noexcept { return m_exchange.localId(); }
+
+    // Live game, including ticks where remote input was predicted.
+    const GameState& game(PlayerId player) const;
+
+    // The game as of confirmedTick(). Unlike game(), no late frame can
+    // change it any more, so decisions that are sent to peers (game over,
+    // final scores) should be taken from here.
+    const GameState& confirmedGame(PlayerId player) const;
+
+    std::uint64_t stateHash() const;
+
+    bool desynced() const noexcept { return desyncTick().has_value(); }
+    std::optional<Tick> desyncTick() const noexcept { return m_exchange.desyncTick(); }
+
+    // Rollbacks done so far and the deepest one, in ticks.
+    std::uint64_t rollbacks() const noexcept { return m_rollbacks; }
+    Tick maxRollbackTicks() const noexcept { return m_maxRollback; }
+
+private:
+    using Frame = std::vector<InputAction>;
+
+    struct SavedTick {
+        std::vector<GameState> games;
+        std::vector<GameController::Duration> timing;
+    };
+
+    InputExchange m_exchange;
+    Config m_config;
+
+    // Live games, index = player index. GameState is kept by value in a
+    // vector sized once, so controllers can hold references to it.
+    std::vector<GameState> m_games;
+    std::vector<GameController> m_controllers;
+
+    // m_ring[t % size]: state before tick t, for the last window ticks
+    std::vector<SavedTick> m_ring;
+
+    Tick m_tick{0};
+
+    // Known frames per player, and the first tick whose frame is not
+    // known yet (every earlier frame is).
+    std::vector<std::map<Tick, Frame>> m_frames;
+    std::vector<Tick> m_nextUnknown;
+
+    std::optional<Tick> m_rollbackFrom;
+    std::uint64_t m_rollbacks{0};
+    Tick m_maxRollback{0};
+
+    Tick m_nextHashTick{0};
+
+    std::size_t playerIndex(PlayerId player) const { return m_exchange.playerIndex(player); }
+    SavedTick& saved(Tick tick) { return m_ring[tick % m_ring.size()]; }
+
+    void noteFrame(std::size_t playerIndex, Tick tick, Frame actions);
+    void sendLocalFrames();
+    void save(Tick tick);
+    void restore(Tick tick);
+    void simulate(Tick tick);
+    void rollback();
+    void recordConfirmedHashes();
+};
+
+} // namespace tetris::net
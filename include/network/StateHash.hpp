@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/GameState.hpp"
+
+namespace tetris::net {
+
+// FNV-1a helpers for the match hashes peers compare to detect desyncs.
+// Values are mixed byte by byte in little-endian order, so hashes are
+// the same on every platform.
+constexpr std::uint64_t StateHashSeed = 0xCBF29CE484222325ULL;
+
+inline std::uint64_t mixStateHash(std::uint64_t h, const std::uint8_t* data, std::size_t size) noexcept
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= data[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+inline std::uint64_t mixStateHash(std::uint64_t h, std::uint64_t value) noexcept
+{
+    for (int i = 0; i < 8; ++i) {
+        h ^= static_cast<std::uint8_t>(value >> (8 * i));
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// Mixes the game's binary snapshot: board, pieces, RNG, score, level...
+inline std::uint64_t mixStateHash(std::uint64_t h, const tetris::core::GameState& game)
+{
+    std::array<std::uint8_t, tetris::core::GameState::MaxSnapshotBytes> buffer{};
+    const std::size_t size =
+        game.saveSnapshot(tetris::core::Span<std::uint8_t>{buffer.data(), buffer.size()});
+    return mixStateHash(h, buffer.data(), size);
+}
+
+} // namespace tetris::net
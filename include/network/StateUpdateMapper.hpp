@@ -16,6 +16,31 @@ public:
     static PlayerStateDTO toPlayerDTO(PlayerId playerId,
                                       const std::string& playerName,
                                       const tetris::core::GameState& gs);
+
+    // Which board a DTO's cells were last exported from, and that board's
+    // epoch at the time. Epochs are per board, so the board is recorded
+    // too: a DTO refreshed from any other board is exported in full. The
+    // board is identified by address; reset the cache after assigning
+    // another board into the same object. A default value forces a full
+    // export.
+    struct BoardCache {
+        const tetris::core::StandardBoard* board{nullptr};
+        tetris::core::StandardBoard::Epoch epoch{0};
+    };
+
+    // Refresh a DTO built earlier for the same game. Scalars are always
+    // rewritten; board cells only for rows the board changed since
+    // `cache`, which is then advanced to the board's current epoch.
+    static void updatePlayerDTO(PlayerStateDTO& dto,
+                                BoardCache& cache,
+                                PlayerId playerId,
+                                const std::string& playerName,
+                                const tetris::core::GameState& gs);
+
+    // Store the full game in dto.gameSnapshot for client-side prediction.
+    // Reuses the vector's storage, so repeated calls do not reallocate.
+    static void writeGameSnapshot(PlayerStateDTO& dto,
+                                  const tetris::core::GameState& gs);
 };
 
 } // namespace tetris::net
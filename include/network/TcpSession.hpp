@@ -5,19 +5,23 @@
     #include <atomic> 
     #include <thread>  
     #include <mutex> 
+    #include <vector>
 
     #include "network/INetworkSession.hpp"
+    #include "network/WireCodec.hpp"
 
     namespace tetris::net {
 
     class TcpServer;
 
-    // Concrete INetworkSession using a TCP socket and line-based protocol.
+    // Concrete INetworkSession using a TCP socket.
     // It runs a background thread that:
     //   - reads bytes from the socket
-    //   - splits on '\n'
-    //   - parses each line as a serialized Message
+    //   - splits them into text lines or binary frames (see WireCodec)
+    //   - parses each one as a Message
     //   - invokes the registered MessageHandler.
+    // Client sessions offer the binary codec on connect; both ends use it
+    // if the host accepts, and stay on text lines with older peers.
     // `poll()` is a no-op; the session is event-driven.
     class TcpSession : public INetworkSession {
     public:
@@ -38,17 +42,27 @@
 
     private:
         // Constructed internally with an already-connected socket.
-        explicit TcpSession(int socketFd);
+        // The connecting side offers the binary codec.
+        explicit TcpSession(int socketFd, bool offerBinary = false);
 
         friend class TcpServer;
 
         void readLoop();
         void closeSocket();
 
+        // Writes all of `bytes`; m_sendMutex must be held.
+        void writeAll(const std::vector<std::uint8_t>& bytes);
+
         int m_socket{-1};
         std::atomic<bool> m_connected{false};
         std::thread m_thread;
 
+        // Writes come from the game thread and from handlers on the read
+        // thread; the mutex keeps their bytes from interleaving.
+        WireCodec m_codec;
+        std::mutex m_sendMutex;
+        std::vector<std::uint8_t> m_sendBuffer;
+
         MessageHandler m_handler;
         std::mutex m_handlerMutex;
     };
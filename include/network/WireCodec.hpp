@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "network/MessageTypes.hpp"
+
+namespace tetris::net {
+
+// Framing and codec choice for one stream connection, kept apart from the
+// socket so it can be tested without one (TcpSession only moves bytes).
+//
+// A connection starts on the text protocol: one serialize()d message per
+// '\n'-terminated line. The connecting side offers the binary codec with
+// the line "CODEC;<BinaryWireVersion>"; a peer that supports it answers
+// with the same line and sends binary frames (see BinarySerialization.hpp)
+// from then on, and the offering side switches when it reads the answer.
+// Peers from before the binary codec cannot parse the line and drop it, so
+// with them both sides stay on text. Received data may mix text lines and
+// binary frames at any point, so neither side depends on when the other
+// switches.
+//
+// encode() may be called from any thread as long as the caller serializes
+// its writes; receive() only from the connection's reader.
+class WireCodec {
+public:
+    // Appends the offer to `out`. The connecting side sends it before
+    // anything else.
+    void offerBinary(std::vector<std::uint8_t>& out);
+
+    // Appends `msg` as a text line or a binary frame, depending on what
+    // has been agreed so far.
+    void encode(const Message& msg, std::vector<std::uint8_t>& out) const;
+
+    // Consumes received bytes. Complete messages are appended to
+    // `messages` and an answer to an offer, if one is due, to `reply`;
+    // an incomplete line or frame is kept for the next call. Returns false
+    // if a binary frame header is corrupt: the stream cannot be resynced
+    // and the connection should be closed.
+    bool receive(const char* data, std::size_t size,
+                 std::vector<Message>& messages,
+                 std::vector<std::uint8_t>& reply);
+
+    bool sendsBinary() const noexcept { return m_binary; }
+
+private:
+    void handleCodecLine(const std::string& line, std::vector<std::uint8_t>& reply);
+
+    std::string m_received; // bytes not yet consumed
+    bool m_offered{false};
+    std::atomic<bool> m_binary{false};
+};
+
+} // namespace tetris::net
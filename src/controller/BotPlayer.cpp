@@ -0,0 +1,334 @@
+#include "controller/BotPlayer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace tetris::controller {
+
+using tetris::core::MoveGenerator;
+using tetris::core::Tetromino;
+
+// ----------------------------
+// BotWorkerPool
+// ----------------------------
+
+unsigned BotWorkerPool::defaultHelperThreads() noexcept {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+BotWorkerPool::BotWorkerPool(unsigned helperThreads) {
+    workers_.reserve(helperThreads);
+    for (unsigned i = 0; i < helperThreads; ++i) {
+        workers_.emplace_back([this, slot = i + 1] { workerLoop(slot); });
+    }
+}
+
+BotWorkerPool::~BotWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void BotWorkerPool::parallelFor(std::size_t count,
+                                const std::function<void(std::size_t, std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> run{runMutex_};
+    if (workers_.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        task_ = &task;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        busy_ = workers_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+}
+
+void BotWorkerPool::workerLoop(std::size_t slot) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        drain(slot);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            --busy_;
+        }
+        done_.notify_one();
+    }
+}
+
+void BotWorkerPool::drain(std::size_t slot) {
+    for (std::size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+        (*task_)(i, slot);
+    }
+}
+
+// ----------------------------
+// BasicBotPlayer
+// ----------------------------
+
+namespace {
+
+int bitCount(std::uint32_t x) noexcept {
+    int n = 0;
+    for (; x != 0; x &= x - 1) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+template <typename GameT>
+BasicBotPlayer<GameT>::BasicBotPlayer(BotConfig config, BotWorkerPool* pool)
+    : config_{config}
+    , pool_{pool}
+    , generators_(pool ? pool->slotCount() : 1)
+{
+    config_.beamWidth = std::max(config_.beamWidth, 1);
+    config_.lookahead = std::max(config_.lookahead, 0);
+}
+
+template <typename GameT>
+bool BasicBotPlayer<GameT>::update(GameT& game, Controller& controller, Duration elapsed) {
+    return update(game, controller, elapsed, Clock::time_point::max());
+}
+
+template <typename GameT>
+bool BasicBotPlayer<GameT>::update(GameT& game, Controller& controller, Duration elapsed,
+                                   typename Clock::time_point deadline) {
+    if (game.status() != core::GameStatus::Running) {
+        return false;
+    }
+
+    accumulated_ += elapsed;
+    if (accumulated_ < config_.placementInterval || Clock::now() >= deadline) {
+        return false;
+    }
+    // One piece per call keeps each step's cost within one think budget;
+    // time beyond a single interval is dropped rather than replayed.
+    accumulated_ = std::min(accumulated_ - config_.placementInterval, config_.placementInterval);
+    if (!plan(game, inputs_, deadline)) {
+        return false;
+    }
+    for (InputAction action : inputs_) {
+        controller.handleAction(action);
+    }
+    return true;
+}
+
+template <typename GameT>
+bool BasicBotPlayer<GameT>::playPiece(GameT& game, Controller& controller) {
+    if (game.status() != core::GameStatus::Running || !plan(game, inputs_)) {
+        return false;
+    }
+    for (InputAction action : inputs_) {
+        controller.handleAction(action);
+    }
+    return true;
+}
+
+template <typename GameT>
+bool BasicBotPlayer<GameT>::plan(const GameT& game, std::vector<InputAction>& out) {
+    return plan(game, out, Clock::time_point::max());
+}
+
+template <typename GameT>
+void BasicBotPlayer<GameT>::selectBeam() {
+    // Best beamWidth candidates, ties in candidate order. partial_sort
+    // needs no scratch buffer, unlike stable_sort.
+    for (std::size_t i = 0; i < merged_.size(); ++i) {
+        merged_[i].order = static_cast<std::uint32_t>(i);
+    }
+    const std::size_t keep = std::min(merged_.size(), static_cast<std::size_t>(config_.beamWidth));
+    std::partial_sort(merged_.begin(), merged_.begin() + static_cast<std::ptrdiff_t>(keep), merged_.end(),
+                      [](const Node& a, const Node& b) {
+                          return a.score != b.score ? a.score > b.score : a.order < b.order;
+                      });
+    merged_.erase(merged_.begin() + static_cast<std::ptrdiff_t>(keep), merged_.end());
+    beam_.swap(merged_);
+}
+
+template <typename GameT>
+bool BasicBotPlayer<GameT>::plan(const GameT& game, std::vector<InputAction>& out,
+                                 typename Clock::time_point deadline) {
+    out.clear();
+    lastDepth_ = 0;
+    const auto& active = game.activeTetromino();
+    if (!active) {
+        return false;
+    }
+    const auto now = Clock::now();
+    if (deadline - now > config_.thinkBudget) {
+        deadline = now + config_.thinkBudget;
+    }
+
+    // Pieces to search: the active one, then preview pieces at the spawn pose
+    pieces_.assign(1, *active);
+    if (const auto next = game.nextTetromino()) {
+        const auto preview = game.preview();
+        const std::size_t depth = std::min<std::size_t>(config_.lookahead, preview.size());
+        for (std::size_t i = 0; i < depth; ++i) {
+            pieces_.emplace_back(preview[i], next->rotation(), next->origin());
+        }
+    }
+
+    // Root level always runs so there is a move even with no budget left
+    merged_.clear();
+    expand(Node{game.board(), 0.0, 0, -1}, pieces_[0], generators_[0], true, merged_);
+    if (merged_.empty()) {
+        out.push_back(InputAction::HardDrop);
+        return true;
+    }
+    selectBeam();
+    int best = beam_.front().firstMove;
+    lastDepth_ = 1;
+
+    // Captured by reference so the task fits std::function's inline storage
+    struct LevelSearch {
+        const Tetromino* piece;
+        typename Clock::time_point deadline;
+        std::atomic<bool> timedOut{false};
+    } search{nullptr, deadline};
+
+    for (std::size_t level = 1; level < pieces_.size(); ++level) {
+        if (Clock::now() >= deadline) {
+            break;
+        }
+        search.piece = &pieces_[level];
+        children_.resize(beam_.size());
+        forEach(beam_.size(), [this, &search](std::size_t i, std::size_t slot) {
+            children_[i].clear();
+            if (search.timedOut.load(std::memory_order_relaxed) || Clock::now() >= search.deadline) {
+                search.timedOut.store(true, std::memory_order_relaxed);
+                return;
+            }
+            expand(beam_[i], *search.piece, generators_[slot], false, children_[i]);
+        });
+        if (search.timedOut.load()) {
+            break; // a partial level would favour whichever nodes ran first
+        }
+
+        merged_.clear();
+        for (std::size_t i = 0; i < beam_.size(); ++i) {
+            merged_.insert(merged_.end(), children_[i].begin(), children_[i].end());
+        }
+        if (merged_.empty()) {
+            break; // every line tops out; keep the previous level's choice
+        }
+        selectBeam();
+        best = beam_.front().firstMove;
+        lastDepth_ = static_cast<int>(level) + 1;
+    }
+
+    // The generator is deterministic, so regenerating the root gives the
+    // same placement order and a path for `best`.
+    MoveGenerator& generator = generators_[0];
+    const auto placements = generator.generate(game.board(), pieces_[0]);
+    generator.path(placements[static_cast<std::size_t>(best)], out);
+    return true;
+}
+
+template <typename GameT>
+void BasicBotPlayer<GameT>::expand(const Node& parent, const Tetromino& piece,
+                                   MoveGenerator& generator, bool root,
+                                   std::vector<Node>& out) const {
+    const auto placements = generator.generate(parent.board, piece);
+    for (std::size_t i = 0; i < placements.size(); ++i) {
+        Node child{parent.board, 0.0, parent.lines, root ? static_cast<int>(i) : parent.firstMove};
+        child.board.lockTetromino(placements[i].piece);
+        child.lines += child.board.clearFullLines();
+        child.score = evaluate(child.board, child.lines);
+        out.push_back(std::move(child));
+    }
+}
+
+template <typename GameT>
+double BasicBotPlayer<GameT>::evaluate(const BoardT& board, int lines) const noexcept {
+    const int rows = board.rows();
+    const int cols = board.cols();
+
+    // One pass from the top: a column's height is set by its first filled
+    // cell, and every empty cell under a covered column is a hole.
+    std::array<int, core::BoardTypes::MaxCols> heights{};
+    typename BoardT::RowMask covered = 0;
+    int holes = 0;
+    for (int r = 0; r < rows; ++r) {
+        const auto mask = board.rowMask(r);
+        holes += bitCount(covered & ~mask);
+        if (const auto fresh = mask & ~covered) {
+            for (int c = 0; c < cols; ++c) {
+                if ((fresh >> c) & 1U) {
+                    heights[c] = rows - r;
+                }
+            }
+        }
+        covered |= mask;
+    }
+
+    int aggregate = 0;
+    int bumpiness = 0;
+    for (int c = 0; c < cols; ++c) {
+        aggregate += heights[c];
+        if (c + 1 < cols) {
+            bumpiness += std::abs(heights[c] - heights[c + 1]);
+        }
+    }
+
+    const BotWeights& w = config_.weights;
+    double score = w.aggregateHeight * aggregate + w.linesCleared * lines
+                 + w.holes * holes + w.bumpiness * bumpiness;
+    if (board.isGameOver()) {
+        score -= 1e9;
+    }
+    return score;
+}
+
+template <typename GameT>
+void BasicBotPlayer<GameT>::forEach(std::size_t count,
+                                    const std::function<void(std::size_t, std::size_t)>& task) {
+    if (pool_) {
+        pool_->parallelFor(count, task);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        task(i, 0);
+    }
+}
+
+template class BasicBotPlayer<tetris::core::GameState>;
+template class BasicBotPlayer<tetris::core::DynamicGameState>;
+
+} // namespace tetris::controller
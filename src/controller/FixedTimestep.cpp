@@ -0,0 +1,96 @@
+#include "controller/FixedTimestep.hpp"
+
+#include <algorithm>
+
+namespace tetris::controller {
+
+namespace {
+
+constexpr std::uint64_t kNanosPerSecond = 1'000'000'000ull;
+constexpr std::uint64_t kNanosPerMilli = 1'000'000ull;
+
+} // namespace
+
+FixedTimestep::FixedTimestep(std::uint32_t ticksPerSecond, std::uint32_t maxCatchUpTicks)
+    : FixedTimestep(std::max<std::uint32_t>(1u, ticksPerSecond), kNanosPerSecond, maxCatchUpTicks) {}
+
+FixedTimestep::FixedTimestep(std::uint64_t scale, std::uint64_t unitsPerTick, std::uint32_t maxCatchUpTicks)
+    : scale_(scale)
+    , unitsPerTick_(unitsPerTick)
+    , maxCatchUp_(std::max<std::uint32_t>(1u, maxCatchUpTicks)) {}
+
+FixedTimestep FixedTimestep::withPeriod(Milliseconds period, std::uint32_t maxCatchUpTicks) {
+    const auto ms = static_cast<std::uint64_t>(std::max<Milliseconds::rep>(1, period.count()));
+    return FixedTimestep(1u, ms * kNanosPerMilli, maxCatchUpTicks);
+}
+
+void FixedTimestep::accumulate(Nanoseconds frameTime) {
+    if (frameTime.count() <= 0) {
+        return;
+    }
+
+    // ns * scale_ units, split into whole ticks and a remainder so a long
+    // hitch cannot overflow the product.
+    const auto ns = static_cast<std::uint64_t>(frameTime.count());
+    const std::uint64_t q = ns / unitsPerTick_;
+    const std::uint64_t r = ns % unitsPerTick_;
+    std::uint64_t due = q * scale_ + (r * scale_) / unitsPerTick_;
+
+    accumulated_ += (r * scale_) % unitsPerTick_;
+    due += accumulated_ / unitsPerTick_;
+    accumulated_ %= unitsPerTick_;
+
+    if (due > maxCatchUp_) {
+        dropped_ += due - maxCatchUp_;
+        due = maxCatchUp_;
+    }
+    accumulated_ += due * unitsPerTick_;
+}
+
+void FixedTimestep::accumulateSeconds(float frameSeconds) {
+    accumulate(std::chrono::duration_cast<Nanoseconds>(std::chrono::duration<float>(frameSeconds)));
+}
+
+std::uint32_t FixedTimestep::pending() const noexcept {
+    return static_cast<std::uint32_t>(accumulated_ / unitsPerTick_);
+}
+
+void FixedTimestep::consume(std::uint32_t count) noexcept {
+    count = std::min(count, pending());
+    accumulated_ -= std::uint64_t{count} * unitsPerTick_;
+    tick_ += count;
+}
+
+bool FixedTimestep::step() noexcept {
+    if (accumulated_ < unitsPerTick_) {
+        return false;
+    }
+    accumulated_ -= unitsPerTick_;
+    ++tick_;
+    return true;
+}
+
+FixedTimestep::Milliseconds FixedTimestep::timeAt(std::uint64_t tick) const noexcept {
+    // tick * unitsPerTick_ / scale_ is nanoseconds; split the product so
+    // long matches do not overflow it.
+    const std::uint64_t perMs = scale_ * kNanosPerMilli;
+    const std::uint64_t whole = (tick / perMs) * unitsPerTick_;
+    const std::uint64_t rest = (tick % perMs) * unitsPerTick_ / perMs;
+    return Milliseconds{static_cast<Milliseconds::rep>(whole + rest)};
+}
+
+FixedTimestep::Milliseconds FixedTimestep::lastTickDuration() const noexcept {
+    return tick_ == 0 ? Milliseconds{0} : timeAt(tick_) - timeAt(tick_ - 1);
+}
+
+float FixedTimestep::alpha() const noexcept {
+    return static_cast<float>(accumulated_ % unitsPerTick_) / static_cast<float>(unitsPerTick_);
+}
+
+void FixedTimestep::reset() noexcept {
+    accumulated_ = 0;
+    tick_ = 0;
+    dropped_ = 0;
+}
+
+} // namespace tetris::controller
@@ -1,13 +1,27 @@
 #include "controller/GameController.hpp"
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
 namespace tetris::controller {
 
-GameController::GameController(tetris::core::GameState& game)
+static_assert(static_cast<int>(InputAction::MoveLeft) == static_cast<int>(core::PieceCommand::MoveLeft)
+              && static_cast<int>(InputAction::MoveRight) == static_cast<int>(core::PieceCommand::MoveRight)
+              && static_cast<int>(InputAction::SoftDrop) == static_cast<int>(core::PieceCommand::SoftDrop)
+              && static_cast<int>(InputAction::HardDrop) == static_cast<int>(core::PieceCommand::HardDrop)
+              && static_cast<int>(InputAction::RotateCW) == static_cast<int>(core::PieceCommand::RotateCW)
+              && static_cast<int>(InputAction::RotateCCW) == static_cast<int>(core::PieceCommand::RotateCCW),
+              "InputAction and PieceCommand must list piece actions in the same order");
+
+template <typename GameT>
+BasicGameController<GameT>::BasicGameController(GameT& game)
     : game_{game}
 {
 }
 
-void GameController::handleAction(InputAction  action) {
+template <typename GameT>
+void BasicGameController<GameT>::handleAction(InputAction  action) {
     using core::GameStatus;
 
     const auto status = game_.status();
@@ -63,7 +77,70 @@ void GameController::handleAction(InputAction  action) {
     }
 }
 
-void GameController::update(Duration elapsed) {
+template <typename GameT>
+std::size_t BasicGameController<GameT>::handleActions(core::Span<const TimedInputAction> actions,
+                                                      core::Span<bool> accepted) {
+    using core::PieceCommand;
+    using core::Span;
+
+    const bool flags = !accepted.empty();
+    if (flags && accepted.size() < actions.size()) {
+        throw std::length_error("handleActions: accepted is shorter than actions");
+    }
+
+    // Piece actions are converted in fixed chunks on the stack
+    constexpr std::size_t kChunk = 32;
+    std::array<PieceCommand, kChunk> commands;
+    std::array<bool, kChunk> ok;
+    std::array<std::size_t, kChunk> source;
+    std::size_t pending = 0;
+    std::size_t applied = 0;
+
+    auto flush = [&] {
+        if (pending == 0) return;
+        const auto lockedBefore = game_.lockedPieces();
+        applied += game_.applyCommands(Span<const PieceCommand>{commands.data(), pending},
+                                       Span<bool>{ok.data(), pending});
+        if (game_.lockedPieces() != lockedBefore) {
+            accumulated_ = Duration{0}; // as after a single hard drop
+        }
+        for (std::size_t k = 0; flags && k < pending; ++k) {
+            accepted[source[k]] = ok[k];
+        }
+        pending = 0;
+    };
+
+    std::uint64_t latest = 0;
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        const TimedInputAction& a = actions[i];
+        if (i > 0 && a.timestamp < latest) {
+            if (flags) accepted[i] = false; // stale
+            continue;
+        }
+        latest = a.timestamp;
+
+        if (a.action == InputAction::PauseResume) {
+            flush();
+            const auto before = game_.status();
+            handleAction(a.action);
+            const bool toggled = game_.status() != before;
+            applied += toggled;
+            if (flags) accepted[i] = toggled;
+            continue;
+        }
+
+        commands[pending] = static_cast<PieceCommand>(a.action);
+        source[pending] = i;
+        if (++pending == kChunk) {
+            flush();
+        }
+    }
+    flush();
+    return applied;
+}
+
+template <typename GameT>
+void BasicGameController<GameT>::update(Duration elapsed) {
     using core::GameStatus;
 
     if (game_.status() != GameStatus::Running) {
@@ -87,8 +164,22 @@ void GameController::update(Duration elapsed) {
     }
 }
 
-void GameController::resetTiming() {
+template <typename GameT>
+float BasicGameController<GameT>::gravityProgress(std::chrono::duration<float, std::milli> ahead) const noexcept {
+    const int intervalMs = game_.gravityIntervalMs();
+    if (game_.status() != core::GameStatus::Running || intervalMs <= 0) {
+        return 0.0f;
+    }
+    const float progress = (static_cast<float>(accumulated_.count()) + ahead.count()) / static_cast<float>(intervalMs);
+    return std::clamp(progress, 0.0f, 1.0f);
+}
+
+template <typename GameT>
+void BasicGameController<GameT>::resetTiming() {
     accumulated_ = Duration{0};
 }
 
+template class BasicGameController<tetris::core::GameState>;
+template class BasicGameController<tetris::core::DynamicGameState>;
+
 } // namespace tetris::controller
\ No newline at end of file
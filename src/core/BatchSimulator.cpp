@@ -0,0 +1,281 @@
+#include "core/BatchSimulator.hpp"
+
+#include "core/TetrominoShapes.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace tetris::core {
+
+using tetris::controller::InputAction;
+
+namespace {
+
+constexpr int kSpawnRow = 0;
+constexpr int kSpawnCol = BatchSimulator::Cols / 2; // same as GameState::spawnPosition
+
+Rotation turned(Rotation r, bool clockwise) noexcept {
+    const int step = clockwise ? 1 : 3;
+    return static_cast<Rotation>((static_cast<int>(r) + step) % 4);
+}
+
+} // namespace
+
+BatchSimulator::BatchSimulator(std::size_t games, int startingLevel)
+    : startingLevel_{startingLevel}
+    , rows_(games * Rows, 0)
+    , codes_(games * Rows * Cols, BoardTypes::NoType)
+    , hasPiece_(games, 0)
+    , pieceType_(games, TetrominoType::I)
+    , pieceRot_(games, Rotation::R0)
+    , pieceRow_(games, 0)
+    , pieceCol_(games, 0)
+    , status_(games, static_cast<std::uint8_t>(GameStatus::NotStarted))
+    , scores_(games)
+    , levels_(games, LevelManager{startingLevel})
+    , lockedPieces_(games, 0)
+    , gravity_(games, 0)
+    , factories_(games, TetrominoFactory{0})
+    , queues_(games)
+{
+}
+
+void BatchSimulator::start(std::size_t game, std::uint64_t seed) {
+    factories_[game].setSeed(seed);
+    queues_[game].clear();
+
+    scores_[game].reset();
+    levels_[game].reset(startingLevel_);
+    std::fill_n(rows_.begin() + static_cast<std::ptrdiff_t>(game * Rows), Rows, RowBits{0});
+    std::fill_n(codes_.begin() + static_cast<std::ptrdiff_t>(game * Rows * Cols), Rows * Cols, BoardTypes::NoType);
+    hasPiece_[game] = 0;
+    lockedPieces_[game] = 0;
+    gravity_[game] = 0;
+
+    status_[game] = static_cast<std::uint8_t>(GameStatus::Running);
+    if (!spawn(game)) {
+        status_[game] = static_cast<std::uint8_t>(GameStatus::GameOver);
+    }
+}
+
+void BatchSimulator::startAll(std::uint64_t firstSeed) {
+    for (std::size_t g = 0; g < size(); ++g) {
+        start(g, firstSeed + g);
+    }
+}
+
+std::optional<Tetromino> BatchSimulator::activeTetromino(std::size_t game) const {
+    if (!hasPiece_[game]) {
+        return std::nullopt;
+    }
+    return Tetromino{pieceType_[game], pieceRot_[game], Position{pieceRow_[game], pieceCol_[game]}};
+}
+
+bool BatchSimulator::canPlace(std::size_t game, TetrominoType type, Rotation rot, int row, int col) const noexcept {
+    const ShapeInfo& shape = shapeInfo(type, rot);
+    const int top = row + shape.minRow;
+    const int left = col + shape.minCol;
+    if (top < 0 || left < 0 || top + shape.height > Rows || left + shape.width > Cols) {
+        return false;
+    }
+
+    const RowBits* board = rows_.data() + game * Rows + top;
+    for (int i = 0; i < shape.height; ++i) {
+        if (board[i] & static_cast<RowBits>(shape.rowMasks[i] << left)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchSimulator::tryMove(std::size_t game, int dRow, int dCol) noexcept {
+    const int row = pieceRow_[game] + dRow;
+    const int col = pieceCol_[game] + dCol;
+    if (!canPlace(game, pieceType_[game], pieceRot_[game], row, col)) {
+        return false;
+    }
+    pieceRow_[game] = static_cast<std::int8_t>(row);
+    pieceCol_[game] = static_cast<std::int8_t>(col);
+    return true;
+}
+
+bool BatchSimulator::tryRotate(std::size_t game, bool clockwise) noexcept {
+    const Rotation rot = turned(pieceRot_[game], clockwise);
+    if (!canPlace(game, pieceType_[game], rot, pieceRow_[game], pieceCol_[game])) {
+        return false;
+    }
+    pieceRot_[game] = rot;
+    return true;
+}
+
+int BatchSimulator::dropDistance(std::size_t game) const noexcept {
+    const TetrominoType type = pieceType_[game];
+    const Rotation rot = pieceRot_[game];
+    const int row = pieceRow_[game];
+    const int col = pieceCol_[game];
+
+    int distance = 0;
+    while (canPlace(game, type, rot, row + distance + 1, col)) {
+        ++distance;
+    }
+    return distance;
+}
+
+bool BatchSimulator::spawn(std::size_t game) {
+    const TetrominoType type = queues_[game].pop(factories_[game]);
+    if (!canPlace(game, type, Rotation::R0, kSpawnRow, kSpawnCol)) {
+        hasPiece_[game] = 0;
+        return false;
+    }
+    hasPiece_[game] = 1;
+    pieceType_[game] = type;
+    pieceRot_[game] = Rotation::R0;
+    pieceRow_[game] = static_cast<std::int8_t>(kSpawnRow);
+    pieceCol_[game] = static_cast<std::int8_t>(kSpawnCol);
+    return true;
+}
+
+void BatchSimulator::lockAndClear(std::size_t game) {
+    RowBits* board = rows_.data() + game * Rows;
+    BoardTypes::CellCode* codes = codes_.data() + game * Rows * Cols;
+
+    const ShapeInfo& shape = shapeInfo(pieceType_[game], pieceRot_[game]);
+    const BoardTypes::CellCode code = BoardTypes::encodeType(pieceType_[game]);
+    for (const auto& offset : shape.blocks) {
+        const int r = pieceRow_[game] + offset.row;
+        const int c = pieceCol_[game] + offset.col;
+        board[r] = static_cast<RowBits>(board[r] | (RowBits{1} << c));
+        codes[r * Cols + c] = code;
+    }
+    hasPiece_[game] = 0;
+
+    // Same bottom-up compaction as Board::clearLines
+    int cleared = 0;
+    int write = Rows - 1;
+    for (int read = Rows - 1; read >= 0; --read) {
+        if (board[read] == FullRow) {
+            ++cleared;
+            continue;
+        }
+        if (write != read) {
+            board[write] = board[read];
+            std::memcpy(codes + write * Cols, codes + read * Cols, Cols);
+        }
+        --write;
+    }
+    for (; write >= 0; --write) {
+        board[write] = 0;
+        std::memset(codes + write * Cols, BoardTypes::NoType, Cols);
+    }
+
+    if (cleared > 0) {
+        scores_[game].addLinesCleared(cleared, levels_[game].level());
+        levels_[game].onLinesCleared(cleared);
+    }
+    ++lockedPieces_[game];
+}
+
+bool BatchSimulator::tick(std::size_t game) {
+    if (!running(game)) {
+        return false;
+    }
+    if (!hasPiece_[game] && !spawn(game)) {
+        status_[game] = static_cast<std::uint8_t>(GameStatus::GameOver);
+        return false;
+    }
+    if (tryMove(game, 1, 0)) {
+        return true;
+    }
+
+    lockAndClear(game);
+    if (rows_[game * Rows] != 0 || !spawn(game)) {
+        status_[game] = static_cast<std::uint8_t>(GameStatus::GameOver);
+    }
+    return false;
+}
+
+void BatchSimulator::hardDrop(std::size_t game) {
+    const int dropped = dropDistance(game);
+    pieceRow_[game] = static_cast<std::int8_t>(pieceRow_[game] + dropped);
+    scores_[game].addHardDropCells(dropped);
+
+    lockAndClear(game);
+    if (rows_[game * Rows] != 0 || !spawn(game)) {
+        status_[game] = static_cast<std::uint8_t>(GameStatus::GameOver);
+    }
+}
+
+void BatchSimulator::applyAction(std::size_t game, InputAction action) {
+    const GameStatus status = this->status(game);
+    if (status == GameStatus::GameOver) {
+        return;
+    }
+
+    if (action == InputAction::PauseResume) {
+        if (status == GameStatus::Running) {
+            status_[game] = static_cast<std::uint8_t>(GameStatus::Paused);
+        } else if (status == GameStatus::Paused) {
+            status_[game] = static_cast<std::uint8_t>(GameStatus::Running);
+        }
+        return;
+    }
+    if (status != GameStatus::Running) {
+        return;
+    }
+    if (action == InputAction::HardDrop) {
+        if (hasPiece_[game]) {
+            hardDrop(game);
+        }
+        gravity_[game] = 0; // the controller resets gravity even without a piece
+        return;
+    }
+    if (!hasPiece_[game]) {
+        return;
+    }
+
+    switch (action) {
+    case InputAction::MoveLeft:
+        tryMove(game, 0, -1);
+        break;
+    case InputAction::MoveRight:
+        tryMove(game, 0, 1);
+        break;
+    case InputAction::SoftDrop:
+        if (tryMove(game, 1, 0)) {
+            scores_[game].addSoftDropCells(1);
+        }
+        break;
+    case InputAction::RotateCW:
+        tryRotate(game, true);
+        break;
+    case InputAction::RotateCCW:
+        tryRotate(game, false);
+        break;
+    case InputAction::HardDrop:
+    case InputAction::PauseResume:
+        break;
+    }
+}
+
+void BatchSimulator::update(std::size_t game, Duration elapsed) {
+    if (!running(game)) {
+        return;
+    }
+
+    gravity_[game] += elapsed.count();
+    const int interval = levels_[game].gravityIntervalMs();
+    if (interval <= 0) {
+        return;
+    }
+    while (gravity_[game] >= interval && running(game)) {
+        tick(game);
+        gravity_[game] -= interval;
+    }
+}
+
+void BatchSimulator::updateAll(Duration elapsed) {
+    for (std::size_t g = 0; g < size(); ++g) {
+        update(g, elapsed);
+    }
+}
+
+} // namespace tetris::core
@@ -1,110 +1,326 @@
 #include "core/Board.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <stdexcept>
 
 namespace tetris::core {
 
-Board::Board(int rows, int cols)
-    : rows_{rows}
-    , cols_{cols}
-    , grid_(rows * cols, CellState::Empty)
-    , typeGrid_(rows * cols, std::nullopt)
-{
-    if (rows <= 0 || cols <= 0) {
-        throw std::invalid_argument("Board dimensions must be positive");
+namespace {
+
+// splitmix64: fixed, well-mixed constants so hashes are stable across
+// runs and machines (they are compared between peers).
+constexpr std::uint64_t splitmix64(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// One key per (column, cell code) for a filled cell. Keys do not depend on
+// the row, so a row keeps its hash when a line clear moves it down.
+constexpr int kCodesPerCell = 8; // NoType + 7 tetromino types
+
+constexpr std::array<std::uint64_t, BoardTypes::MaxCols * kCodesPerCell> makeCellKeys() {
+    std::array<std::uint64_t, BoardTypes::MaxCols * kCodesPerCell> keys{};
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = splitmix64(0x5A0B5EEDULL + i);
     }
+    return keys;
 }
 
-CellState Board::cell(int row, int col) const {
+constexpr auto kCellKeys = makeCellKeys();
+
+constexpr std::uint64_t cellKey(int col, BoardTypes::CellCode code) noexcept {
+    return kCellKeys[static_cast<std::size_t>(col * kCodesPerCell + code)];
+}
+
+// Position-dependent contribution of a row to the board hash.
+constexpr std::uint64_t rowContribution(int row, std::uint64_t rowHash) noexcept {
+    return rowHash == 0 ? 0 : splitmix64(rowHash + 0xD1B54A32D192ED03ULL * static_cast<std::uint64_t>(row + 1));
+}
+
+} // namespace
+
+template <int Rows, int Cols>
+BasicBoard<Rows, Cols>::BasicBoard(int rows, int cols)
+    : storage_{rows, cols}
+    , fullRow_{0}
+{
+    fullRow_ = (this->cols() == MaxCols) ? ~RowMask{0} : (bit(this->cols()) - 1);
+    clear();
+}
+
+template <int Rows, int Cols>
+CellState BasicBoard<Rows, Cols>::cell(int row, int col) const {
     if (!isInside(row, col)) {
         throw std::out_of_range("Board::cell out of range");
     }
-    return grid_[index(row, col)];
+    return (storage_.rowBits[row] & bit(col)) ? CellState::Filled : CellState::Empty;
 }
 
-void Board::setCell(int row, int col, CellState state) {
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::setCell(int row, int col, CellState state) {
     if (!isInside(row, col)) {
         throw std::out_of_range("Board::setCell out of range");
     }
-    grid_[index(row, col)] = state;
-    if (state == CellState::Empty) {
-        typeGrid_[index(row, col)] = std::nullopt;
+    beginChange();
+    markRows(row, row);
+    const bool wasFilled = (storage_.rowBits[row] & bit(col)) != 0;
+    if (state == CellState::Filled) {
+        if (!wasFilled) {
+            toggleCellHash(row, col, storage_.typeGrid[index(row, col)]);
+        }
+        storage_.rowBits[row] |= bit(col);
+        storage_.surface[col] = std::min(storage_.surface[col], row);
+    } else {
+        if (wasFilled) {
+            toggleCellHash(row, col, storage_.typeGrid[index(row, col)]);
+        }
+        storage_.rowBits[row] &= ~bit(col);
+        storage_.typeGrid[index(row, col)] = NoType;
+        if (row == storage_.surface[col]) {
+            rebuildSurface(col);
+        }
+    }
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::fillCell(int row, int col, TetrominoType type) {
+    if (!isInside(row, col)) {
+        throw std::out_of_range("Board::fillCell out of range");
+    }
+    beginChange();
+    markRows(row, row);
+    auto& code = storage_.typeGrid[index(row, col)];
+    if (storage_.rowBits[row] & bit(col)) {
+        toggleCellHash(row, col, code);
     }
+    code = encodeType(type);
+    toggleCellHash(row, col, code);
+    storage_.rowBits[row] |= bit(col);
+    storage_.surface[col] = std::min(storage_.surface[col], row);
 }
 
-std::optional<TetrominoType> Board::cellType(int row, int col) const {
+template <int Rows, int Cols>
+std::optional<TetrominoType> BasicBoard<Rows, Cols>::cellType(int row, int col) const {
     if (!isInside(row, col)) {
         throw std::out_of_range("Board::cellType out of range");
     }
-    return typeGrid_[index(row, col)];
+    return decodeType(storage_.typeGrid[index(row, col)]);
 }
 
+template <int Rows, int Cols>
+int BasicBoard<Rows, Cols>::columnHeight(int col) const {
+    if (col < 0 || col >= cols()) {
+        throw std::out_of_range("Board::columnHeight out of range");
+    }
+    return rows() - storage_.surface[col];
+}
 
-bool Board::canPlace(const Tetromino& tetromino) const noexcept {
-    auto blocks = tetromino.blocks();
-    for (const auto& b : blocks) {
-        if (!isInside(b.row, b.col)) {
-            return false; // out of board
+template <int Rows, int Cols>
+int BasicBoard<Rows, Cols>::dropDistance(const Tetromino& tetromino) const noexcept {
+    if (!canPlace(tetromino)) {
+        return 0;
+    }
+
+    const ShapeInfo& shape = tetromino.shape();
+    const Position origin = tetromino.origin();
+    const int left = origin.col + shape.minCol;
+
+    // Every tetromino column is a contiguous run of blocks, so in each
+    // column only the first filled cell below the piece's lowest block can
+    // stop it.
+    int distance = rows();
+    for (int j = 0; j < shape.width; ++j) {
+        const int col = left + j;
+        const int bottom = origin.row + shape.colBottom[j];
+
+        int obstacle = storage_.surface[col];
+        if (bottom >= obstacle) {
+            // Piece is tucked under an overhang: scan below it instead.
+            const RowMask mask = bit(col);
+            obstacle = bottom + 1;
+            while (obstacle < rows() && !(storage_.rowBits[obstacle] & mask)) {
+                ++obstacle;
+            }
         }
-        if (grid_[index(b.row, b.col)] == CellState::Filled) {
+        distance = std::min(distance, obstacle - bottom - 1);
+    }
+    return distance;
+}
+
+template <int Rows, int Cols>
+bool BasicBoard<Rows, Cols>::canPlace(const Tetromino& tetromino) const noexcept {
+    const ShapeInfo& shape = tetromino.shape();
+    const Position origin = tetromino.origin();
+
+    // Bounding box check first, then one AND per occupied row of the piece
+    const int top  = origin.row + shape.minRow;
+    const int left = origin.col + shape.minCol;
+    if (top < 0 || left < 0 || top + shape.height > rows() || left + shape.width > cols()) {
+        return false; // out of board
+    }
+
+    for (int i = 0; i < shape.height; ++i) {
+        const RowMask pieceBits = static_cast<RowMask>(shape.rowMasks[i]) << left;
+        if (storage_.rowBits[top + i] & pieceBits) {
             return false; // collision
         }
     }
     return true;
 }
 
-void Board::lockTetromino(const Tetromino& tetromino) {
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::lockTetromino(const Tetromino& tetromino) {
+    const ShapeInfo& shape = tetromino.shape();
+    const int top = tetromino.origin().row + shape.minRow;
+    beginChange();
+    markRows(std::max(top, 0), std::min(top + shape.height, rows()) - 1);
+
     auto blocks = tetromino.blocks();
     for (const auto& b : blocks) {
         if (isInside(b.row, b.col)) {
-            grid_[index(b.row, b.col)] = CellState::Filled;
-            typeGrid_[index(b.row, b.col)] = tetromino.type();
+            auto& code = storage_.typeGrid[index(b.row, b.col)];
+            if (storage_.rowBits[b.row] & bit(b.col)) {
+                toggleCellHash(b.row, b.col, code); // overwritten cell
+            }
+            code = encodeType(tetromino.type());
+            toggleCellHash(b.row, b.col, code);
+
+            storage_.rowBits[b.row] |= bit(b.col);
+            storage_.surface[b.col] = std::min(storage_.surface[b.col], b.row);
         }
     }
 }
 
-int Board::clearFullLines() {
-    int cleared = 0;
+template <int Rows, int Cols>
+typename BasicBoard<Rows, Cols>::LineClear BasicBoard<Rows, Cols>::clearLines() {
+    LineClear result;
+    auto& rowBits = storage_.rowBits;
+    auto& typeGrid = storage_.typeGrid;
 
-    // Go bottom-up: when we clear, we shift everything above down
-    for (int row = rows_ - 1; row >= 0; --row) {
-        bool full = true;
-        for (int col = 0; col < cols_; ++col) {
-            if (grid_[index(row, col)] == CellState::Empty) {
-                full = false;
-                break;
-            }
+    // Walk bottom-up with separate read/write cursors: full rows are
+    // skipped, every other row is copied down to the write cursor once.
+    int lowestCleared = -1;
+    int write = rows() - 1;
+    for (int read = rows() - 1; read >= 0; --read) {
+        if (rowBits[read] == fullRow_) {
+            lowestCleared = std::max(lowestCleared, read);
+            result.rows |= RowSet{1} << read;
+            ++result.count;
+            continue;
         }
 
-        if (full) {
-            // Shift rows above down by 1
-            for (int r = row; r > 0; --r) {
-                for (int c = 0; c < cols_; ++c) {
-                    grid_[index(r, c)] = grid_[index(r - 1, c)];
-                    typeGrid_[index(r, c)] = typeGrid_[index(r - 1, c)];
-                }
-            }
-            // Clear top row
-            for (int c = 0; c < cols_; ++c) {
-                grid_[index(0, c)] = CellState::Empty;
-                typeGrid_[index(0, c)] = std::nullopt;
-            }
+        if (write != read) {
+            rowBits[write] = rowBits[read];
+            storage_.rowHash[write] = storage_.rowHash[read];
+            std::memcpy(typeGrid.data() + index(write, 0),
+                        typeGrid.data() + index(read, 0), static_cast<std::size_t>(cols()));
+        }
+        --write;
+    }
+
+    // Whatever is left above the write cursor becomes empty.
+    if (write >= 0) {
+        std::fill_n(rowBits.begin(), write + 1, RowMask{0});
+        std::fill_n(storage_.rowHash.begin(), write + 1, Hash{0});
+        std::memset(typeGrid.data(), NoType, static_cast<std::size_t>(index(write + 1, 0)));
+    }
+
+    if (result.count > 0) {
+        // Everything from the top down to the lowest removed row shifted
+        beginChange();
+        markRows(0, lowestCleared);
+        rebuildSurface();
+        rebuildHash();
+    }
+    return result;
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::clear() noexcept {
+    std::fill(storage_.rowBits.begin(), storage_.rowBits.end(), RowMask{0});
+    std::fill(storage_.typeGrid.begin(), storage_.typeGrid.end(), NoType);
+    std::fill(storage_.surface.begin(), storage_.surface.end(), rows());
+    std::fill(storage_.rowHash.begin(), storage_.rowHash.end(), Hash{0});
+    hash_ = 0;
+    beginChange();
+    markRows(0, rows() - 1);
+}
 
-            ++cleared;
-            ++row; // re-check this row index because we just pulled everything down
+template <int Rows, int Cols>
+typename BasicBoard<Rows, Cols>::RowSet
+BasicBoard<Rows, Cols>::dirtyRowsSince(Epoch since) const noexcept {
+    if (since >= epoch_) {
+        return 0;
+    }
+    RowSet dirty = 0;
+    for (int row = 0; row < rows(); ++row) {
+        if (storage_.rowEpoch[row] > since) {
+            dirty |= RowSet{1} << row;
         }
     }
+    return dirty;
+}
 
-    return cleared;
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::markRows(int first, int last) noexcept {
+    for (int row = first; row <= last; ++row) {
+        storage_.rowEpoch[row] = epoch_;
+    }
 }
 
-bool Board::isGameOver() const noexcept {
+template <int Rows, int Cols>
+bool BasicBoard<Rows, Cols>::isGameOver() const noexcept {
     // Simple version: if any filled cell in row 0, we say game over.
-    for (int col = 0; col < cols_; ++col) {
-        if (grid_[index(0, col)] == CellState::Filled) {
-            return true;
+    return storage_.rowBits[0] != 0;
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::toggleCellHash(int row, int col, CellCode code) noexcept {
+    Hash& rowHash = storage_.rowHash[row];
+    hash_ ^= rowContribution(row, rowHash);
+    rowHash ^= cellKey(col, code);
+    hash_ ^= rowContribution(row, rowHash);
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::rebuildHash() noexcept {
+    hash_ = 0;
+    for (int row = 0; row < rows(); ++row) {
+        hash_ ^= rowContribution(row, storage_.rowHash[row]);
+    }
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::rebuildSurface(int col) noexcept {
+    const RowMask mask = bit(col);
+    int row = 0;
+    while (row < rows() && !(storage_.rowBits[row] & mask)) {
+        ++row;
+    }
+    storage_.surface[col] = row;
+}
+
+template <int Rows, int Cols>
+void BasicBoard<Rows, Cols>::rebuildSurface() noexcept {
+    std::fill(storage_.surface.begin(), storage_.surface.end(), rows());
+
+    // Top-down: the first row in which a column shows up is its surface.
+    RowMask pending = fullRow_;
+    for (int row = 0; row < rows() && pending != 0; ++row) {
+        RowMask hits = storage_.rowBits[row] & pending;
+        pending &= ~hits;
+        for (int col = 0; hits != 0; ++col, hits >>= 1) {
+            if (hits & 1U) {
+                storage_.surface[col] = row;
+            }
         }
     }
-    return false;
 }
 
+template class BasicBoard<DynamicExtent, DynamicExtent>;
+template class BasicBoard<20, 10>;
+
 } // namespace tetris::core
@@ -0,0 +1,396 @@
+#include "core/BoardKernels.hpp"
+
+#include "core/TetrominoShapes.hpp"
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TETRIS_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define TETRIS_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace tetris::core {
+
+namespace {
+
+using RowBits = BatchSimulator::RowBits;
+constexpr int Rows = BatchSimulator::Rows;
+constexpr int Cols = BatchSimulator::Cols;
+constexpr std::uint32_t kBoardMask = (std::uint32_t{1} << Rows) - 1;
+
+// Vector kernels work on groups of 4 boards: 4 * 20 rows = 80 masks,
+// which is exactly 10 SSE2 or 5 AVX2 registers, so a group never splits
+// a register. The per-row results of a group fit in 80 bits.
+constexpr int kGroupBoards = 4;
+constexpr int kGroupRows = kGroupBoards * Rows;
+static_assert(kGroupRows % 16 == 0, "board group must fill whole vector registers");
+
+struct GroupFlags {
+    std::uint64_t lo{0}; // rows 0..63 of the group
+    std::uint64_t hi{0}; // rows 64..79
+
+    // `bits` for rows [row, row + width); chunks never straddle bit 64
+    void add(int row, std::uint64_t bits) noexcept {
+        if (row < 64) {
+            lo |= bits << row;
+        } else {
+            hi |= bits << (row - 64);
+        }
+    }
+
+    std::uint32_t board(int index) const noexcept {
+        const int start = index * Rows;
+        if (start + Rows <= 64) {
+            return static_cast<std::uint32_t>(lo >> start) & kBoardMask;
+        }
+        if (start >= 64) {
+            return static_cast<std::uint32_t>(hi >> (start - 64)) & kBoardMask;
+        }
+        return static_cast<std::uint32_t>((lo >> start) | (hi << (64 - start))) & kBoardMask;
+    }
+};
+
+// Piece rows of a pose, positioned on one board; `fits` is false when the
+// pose leaves the board (it then collides everywhere).
+struct PiecePattern {
+    bool fits{false};
+    int top{0};
+    int height{0};
+    std::array<RowBits, ShapeInfo::MaxSpan> masks{};
+};
+
+PiecePattern makePattern(const Tetromino& piece) noexcept {
+    const ShapeInfo& shape = piece.shape();
+    PiecePattern p;
+    p.top = piece.origin().row + shape.minRow;
+    const int left = piece.origin().col + shape.minCol;
+    p.height = shape.height;
+    p.fits = p.top >= 0 && left >= 0 && p.top + shape.height <= Rows && left + shape.width <= Cols;
+    if (p.fits) {
+        for (int i = 0; i < shape.height; ++i) {
+            p.masks[i] = static_cast<RowBits>(shape.rowMasks[i] << left);
+        }
+    }
+    return p;
+}
+
+// ---- Scalar ----
+
+void fullRowsScalar(const RowBits* boards, std::size_t begin, std::size_t count, std::uint32_t* out) noexcept {
+    for (std::size_t b = begin; b < count; ++b) {
+        const RowBits* rows = boards + b * Rows;
+        std::uint32_t mask = 0;
+        for (int r = 0; r < Rows; ++r) {
+            if (rows[r] == BatchSimulator::FullRow) {
+                mask |= std::uint32_t{1} << r;
+            }
+        }
+        out[b] = mask;
+    }
+}
+
+void collisionsScalar(const RowBits* boards, std::size_t begin, std::size_t count,
+                      const PiecePattern& p, std::uint8_t* out) noexcept {
+    for (std::size_t b = begin; b < count; ++b) {
+        const RowBits* rows = boards + b * Rows + p.top;
+        RowBits hit = 0;
+        for (int i = 0; i < p.height; ++i) {
+            hit = static_cast<RowBits>(hit | (rows[i] & p.masks[i]));
+        }
+        out[b] = hit != 0 ? 1 : 0;
+    }
+}
+
+void columnHeightsScalar(const RowBits* boards, std::size_t begin, std::size_t count, std::uint8_t* out) noexcept {
+    for (std::size_t b = begin; b < count; ++b) {
+        const RowBits* rows = boards + b * Rows;
+        std::uint8_t* heights = out + b * Cols;
+        RowBits covered = 0;
+        for (int c = 0; c < Cols; ++c) {
+            heights[c] = 0;
+        }
+        for (int r = 0; r < Rows; ++r) {
+            const RowBits fresh = static_cast<RowBits>(rows[r] & ~covered);
+            for (int c = 0; c < Cols; ++c) {
+                if ((fresh >> c) & 1U) {
+                    heights[c] = static_cast<std::uint8_t>(Rows - r);
+                }
+            }
+            covered = static_cast<RowBits>(covered | rows[r]);
+        }
+    }
+}
+
+// ---- SSE2 ----
+
+#if TETRIS_KERNELS_SSE2
+
+// One flag bit per 16-bit lane whose mask is all ones in `lanes`
+inline unsigned laneFlags(__m128i lanes) noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(lanes, _mm_setzero_si128()))) & 0xFFU;
+}
+
+std::size_t fullRowsSse2(const RowBits* boards, std::size_t count, std::uint32_t* out) noexcept {
+    const __m128i full = _mm_set1_epi16(static_cast<short>(BatchSimulator::FullRow));
+    std::size_t b = 0;
+    for (; b + kGroupBoards <= count; b += kGroupBoards) {
+        const RowBits* rows = boards + b * Rows;
+        GroupFlags flags;
+        for (int v = 0; v < kGroupRows; v += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + v));
+            flags.add(v, laneFlags(_mm_cmpeq_epi16(x, full)));
+        }
+        for (int k = 0; k < kGroupBoards; ++k) {
+            out[b + k] = flags.board(k);
+        }
+    }
+    return b;
+}
+
+std::size_t collisionsSse2(const RowBits* boards, std::size_t count,
+                           const std::array<RowBits, kGroupRows>& pattern, std::uint8_t* out) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t b = 0;
+    for (; b + kGroupBoards <= count; b += kGroupBoards) {
+        const RowBits* rows = boards + b * Rows;
+        GroupFlags flags;
+        for (int v = 0; v < kGroupRows; v += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + v));
+            const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.data() + v));
+            flags.add(v, ~laneFlags(_mm_cmpeq_epi16(_mm_and_si128(x, p), zero)) & 0xFFU);
+        }
+        for (int k = 0; k < kGroupBoards; ++k) {
+            out[b + k] = flags.board(k) != 0 ? 1 : 0;
+        }
+    }
+    return b;
+}
+
+// 8 boards per pass, one board per lane. A column's height is the number
+// of rows whose running OR (from the top) has that column set.
+std::size_t columnHeightsSse2(const RowBits* boards, std::size_t count, std::uint8_t* out) noexcept {
+    constexpr int kLanes = 8;
+    const __m128i one = _mm_set1_epi16(1);
+    std::size_t b = 0;
+    for (; b + kLanes <= count; b += kLanes) {
+        const RowBits* base = boards + b * Rows;
+        __m128i covered = _mm_setzero_si128();
+        __m128i heights[Cols];
+        for (auto& h : heights) {
+            h = _mm_setzero_si128();
+        }
+
+        alignas(16) RowBits lanes[kLanes];
+        for (int r = 0; r < Rows; ++r) {
+            for (int j = 0; j < kLanes; ++j) {
+                lanes[j] = base[j * Rows + r];
+            }
+            covered = _mm_or_si128(covered, _mm_load_si128(reinterpret_cast<const __m128i*>(lanes)));
+            for (int c = 0; c < Cols; ++c) {
+                const __m128i bit = _mm_and_si128(_mm_srl_epi16(covered, _mm_cvtsi32_si128(c)), one);
+                heights[c] = _mm_add_epi16(heights[c], bit);
+            }
+        }
+
+        for (int c = 0; c < Cols; ++c) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), heights[c]);
+            for (int j = 0; j < kLanes; ++j) {
+                out[(b + j) * Cols + c] = static_cast<std::uint8_t>(lanes[j]);
+            }
+        }
+    }
+    return b;
+}
+
+#endif // TETRIS_KERNELS_SSE2
+
+// ---- AVX2 ----
+
+#if TETRIS_KERNELS_AVX2
+
+inline unsigned laneFlags(__m256i lanes) noexcept {
+    const __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    return static_cast<unsigned>(_mm_movemask_epi8(packed)) & 0xFFFFU;
+}
+
+std::size_t fullRowsAvx2(const RowBits* boards, std::size_t count, std::uint32_t* out) noexcept {
+    const __m256i full = _mm256_set1_epi16(static_cast<short>(BatchSimulator::FullRow));
+    std::size_t b = 0;
+    for (; b + kGroupBoards <= count; b += kGroupBoards) {
+        const RowBits* rows = boards + b * Rows;
+        GroupFlags flags;
+        for (int v = 0; v < kGroupRows; v += 16) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + v));
+            flags.add(v, laneFlags(_mm256_cmpeq_epi16(x, full)));
+        }
+        for (int k = 0; k < kGroupBoards; ++k) {
+            out[b + k] = flags.board(k);
+        }
+    }
+    return b;
+}
+
+std::size_t collisionsAvx2(const RowBits* boards, std::size_t count,
+                           const std::array<RowBits, kGroupRows>& pattern, std::uint8_t* out) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t b = 0;
+    for (; b + kGroupBoards <= count; b += kGroupBoards) {
+        const RowBits* rows = boards + b * Rows;
+        GroupFlags flags;
+        for (int v = 0; v < kGroupRows; v += 16) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + v));
+            const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.data() + v));
+            flags.add(v, ~laneFlags(_mm256_cmpeq_epi16(_mm256_and_si256(x, p), zero)) & 0xFFFFU);
+        }
+        for (int k = 0; k < kGroupBoards; ++k) {
+            out[b + k] = flags.board(k) != 0 ? 1 : 0;
+        }
+    }
+    return b;
+}
+
+std::size_t columnHeightsAvx2(const RowBits* boards, std::size_t count, std::uint8_t* out) noexcept {
+    constexpr int kLanes = 16;
+    const __m256i one = _mm256_set1_epi16(1);
+    std::size_t b = 0;
+    for (; b + kLanes <= count; b += kLanes) {
+        const RowBits* base = boards + b * Rows;
+        __m256i covered = _mm256_setzero_si256();
+        __m256i heights[Cols];
+        for (auto& h : heights) {
+            h = _mm256_setzero_si256();
+        }
+
+        alignas(32) RowBits lanes[kLanes];
+        for (int r = 0; r < Rows; ++r) {
+            for (int j = 0; j < kLanes; ++j) {
+                lanes[j] = base[j * Rows + r];
+            }
+            covered = _mm256_or_si256(covered, _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes)));
+            for (int c = 0; c < Cols; ++c) {
+                const __m256i bit = _mm256_and_si256(_mm256_srl_epi16(covered, _mm_cvtsi32_si128(c)), one);
+                heights[c] = _mm256_add_epi16(heights[c], bit);
+            }
+        }
+
+        for (int c = 0; c < Cols; ++c) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), heights[c]);
+            for (int j = 0; j < kLanes; ++j) {
+                out[(b + j) * Cols + c] = static_cast<std::uint8_t>(lanes[j]);
+            }
+        }
+    }
+    return b;
+}
+
+#endif // TETRIS_KERNELS_AVX2
+
+} // namespace
+
+bool kernelIsaAvailable(KernelIsa isa) noexcept {
+    switch (isa) {
+    case KernelIsa::Scalar:
+        return true;
+    case KernelIsa::SSE2:
+#if TETRIS_KERNELS_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case KernelIsa::AVX2:
+#if TETRIS_KERNELS_AVX2
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+KernelIsa bestKernelIsa() noexcept {
+    if (kernelIsaAvailable(KernelIsa::AVX2)) {
+        return KernelIsa::AVX2;
+    }
+    if (kernelIsaAvailable(KernelIsa::SSE2)) {
+        return KernelIsa::SSE2;
+    }
+    return KernelIsa::Scalar;
+}
+
+// Each entry point runs the vector kernel on as many whole groups as it
+// can and finishes the remaining boards with the scalar loop. An ISA that
+// was not compiled in falls back to scalar.
+
+void batchFullRows(const RowBits* boards, std::size_t count, std::uint32_t* out, KernelIsa isa) noexcept {
+    std::size_t done = 0;
+#if TETRIS_KERNELS_AVX2
+    if (isa == KernelIsa::AVX2) {
+        done = fullRowsAvx2(boards, count, out);
+    }
+#endif
+#if TETRIS_KERNELS_SSE2
+    if (isa == KernelIsa::SSE2) {
+        done = fullRowsSse2(boards, count, out);
+    }
+#endif
+    (void)isa;
+    fullRowsScalar(boards, done, count, out);
+}
+
+void batchCollisions(const RowBits* boards, std::size_t count, const Tetromino& piece,
+                     std::uint8_t* out, KernelIsa isa) noexcept {
+    const PiecePattern p = makePattern(piece);
+    if (!p.fits) {
+        for (std::size_t b = 0; b < count; ++b) {
+            out[b] = 1;
+        }
+        return;
+    }
+
+    std::size_t done = 0;
+#if TETRIS_KERNELS_SSE2 || TETRIS_KERNELS_AVX2
+    if (isa != KernelIsa::Scalar) {
+        // The piece's masks at its rows of every board in a group
+        std::array<RowBits, kGroupRows> pattern{};
+        for (int k = 0; k < kGroupBoards; ++k) {
+            for (int i = 0; i < p.height; ++i) {
+                pattern[k * Rows + p.top + i] = p.masks[i];
+            }
+        }
+#if TETRIS_KERNELS_AVX2
+        if (isa == KernelIsa::AVX2) {
+            done = collisionsAvx2(boards, count, pattern, out);
+        }
+#endif
+#if TETRIS_KERNELS_SSE2
+        if (isa == KernelIsa::SSE2) {
+            done = collisionsSse2(boards, count, pattern, out);
+        }
+#endif
+    }
+#endif
+    (void)isa;
+    collisionsScalar(boards, done, count, p, out);
+}
+
+void batchColumnHeights(const RowBits* boards, std::size_t count, std::uint8_t* out, KernelIsa isa) noexcept {
+    std::size_t done = 0;
+#if TETRIS_KERNELS_AVX2
+    if (isa == KernelIsa::AVX2) {
+        done = columnHeightsAvx2(boards, count, out);
+    }
+#endif
+#if TETRIS_KERNELS_SSE2
+    if (isa == KernelIsa::SSE2) {
+        done = columnHeightsSse2(boards, count, out);
+    }
+#endif
+    (void)isa;
+    columnHeightsScalar(boards, done, count, out);
+}
+
+} // namespace tetris::core
@@ -1,65 +1,164 @@
 #include "core/GameState.hpp"
 #include "core/LevelManager.hpp"
+
+#include <array>
+#include <stdexcept>
+
 namespace tetris::core {
 
-GameState::GameState(int rows, int cols, int startingLevel)
+namespace {
+
+// Snapshot layout (version 1, little-endian):
+//   "TSNP" version:u8 rows:u8 cols:u8 status:u8
+//   score:u64 level:u32 lines:u64 lockedPieces:u64
+//   active: present:u8 type:u8 rotation:u8 row:i8 col:i8
+//   factory: seed:u64 pcgState:u64 pcgInc:u64 bag:7*u8 bagIndex:u8
+//   queue: depth:u8 count:u8 pieces:count*u8
+//   cells: rows*cols nibbles, two per byte (low nibble first);
+//          0 = empty, 1..7 = piece type + 1, 8 = filled without a type
+constexpr std::array<std::uint8_t, 4> kSnapshotMagic{'T', 'S', 'N', 'P'};
+constexpr std::size_t kSnapshotFixedBytes = 75;
+constexpr std::uint8_t kUntypedCell = 8;
+static_assert(GameState::MaxSnapshotBytes
+                  == kSnapshotFixedBytes + PieceQueue::Capacity + (BoardTypes::MaxRows * BoardTypes::MaxCols) / 2,
+              "MaxSnapshotBytes out of sync with the snapshot layout");
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::uint8_t* out) noexcept : out_{out} {}
+
+    void u8(std::uint8_t v) noexcept { out_[pos_++] = v; }
+    void u32(std::uint32_t v) noexcept {
+        for (int i = 0; i < 4; ++i) {
+            u8(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+    }
+    void u64(std::uint64_t v) noexcept {
+        for (int i = 0; i < 8; ++i) {
+            u8(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+    }
+
+    std::size_t size() const noexcept { return pos_; }
+
+private:
+    std::uint8_t* out_;
+    std::size_t pos_{0};
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(Span<const std::uint8_t> in) noexcept : in_{in} {}
+
+    std::uint8_t u8() {
+        if (pos_ >= in_.size()) {
+            throw std::invalid_argument("GameState snapshot is truncated");
+        }
+        return in_[pos_++];
+    }
+    std::uint32_t u32() {
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) {
+            v |= static_cast<std::uint32_t>(u8()) << (8 * i);
+        }
+        return v;
+    }
+    std::uint64_t u64() {
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) {
+            v |= static_cast<std::uint64_t>(u8()) << (8 * i);
+        }
+        return v;
+    }
+    // u8 that must be below `limit`
+    std::uint8_t below(std::uint8_t limit, const char* what) {
+        const std::uint8_t v = u8();
+        if (v >= limit) {
+            throw std::invalid_argument(what);
+        }
+        return v;
+    }
+
+    const std::uint8_t* position() const noexcept { return in_.data() + pos_; }
+    void skip(std::size_t n) {
+        if (n > in_.size() - pos_) {
+            throw std::invalid_argument("GameState snapshot is truncated");
+        }
+        pos_ += n;
+    }
+    bool atEnd() const noexcept { return pos_ == in_.size(); }
+
+private:
+    Span<const std::uint8_t> in_;
+    std::size_t pos_{0};
+};
+
+} // namespace
+
+template <typename BoardT>
+BasicGameState<BoardT>::BasicGameState(int rows, int cols, int startingLevel)
     : board_{rows, cols}
     , factory_{}
     , scoreManager_{}
     , levelManager_{startingLevel}
+    , queue_{}
     , activeTetromino_{}
-    , nextTetromino_{}
     , status_{GameStatus::NotStarted}
 {
 }
 
-void GameState::start() {
+template <typename BoardT>
+void BasicGameState<BoardT>::start() {
     if (status_ == GameStatus::Running) return;
 
     scoreManager_.reset();
     levelManager_.reset(levelManager_.level()); // keep current starting level
-    board_ = Board(board_.rows(), board_.cols()); // reset grid
+    board_.clear(); // reset grid in place
 
     activeTetromino_.reset();
-    nextTetromino_.reset();
+    queue_.clear();
 
     status_ = GameStatus::Running;
 
     if (!spawnNewTetromino()) {
-        status_ = GameStatus::GameOver;
+        endGame();
     }
 }
 
-void GameState::pause() {
+template <typename BoardT>
+void BasicGameState<BoardT>::pause() {
     if (status_ == GameStatus::Running) {
         status_ = GameStatus::Paused;
     }
 }
 
-void GameState::resume() {
+template <typename BoardT>
+void BasicGameState<BoardT>::resume() {
     if (status_ == GameStatus::Paused) {
         status_ = GameStatus::Running;
     }
 }
 
-void GameState::reset() {
+template <typename BoardT>
+void BasicGameState<BoardT>::reset() {
     scoreManager_.reset();
     levelManager_.reset(0);
-    board_ = Board(board_.rows(), board_.cols());
+    board_.clear();
     activeTetromino_.reset();
-    nextTetromino_.reset();
+    queue_.clear();
     status_ = GameStatus::NotStarted;
     lockedPieces_ = 0;  // reset locked pieces counter
 }
 
-bool GameState::tick() {
+template <typename BoardT>
+bool BasicGameState<BoardT>::tick() {
     if (status_ != GameStatus::Running) {
         return false;
     }
 
     if (!activeTetromino_) {
         if (!spawnNewTetromino()) {
-            status_ = GameStatus::GameOver;
+            endGame();
             return false;
         }
     }
@@ -73,29 +172,32 @@ bool GameState::tick() {
     lockActiveTetrominoAndProcessLines();
 
     if (board_.isGameOver()) {
-        status_ = GameStatus::GameOver;
+        endGame();
         return false;
     }
 
     if (!spawnNewTetromino()) {
-        status_ = GameStatus::GameOver;
+        endGame();
         return false;
     }
 
     return false; // piece didn't move this tick (it locked)
 }
 
-void GameState::moveLeft() {
+template <typename BoardT>
+void BasicGameState<BoardT>::moveLeft() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
     tryMove(0, -1);
 }
 
-void GameState::moveRight() {
+template <typename BoardT>
+void BasicGameState<BoardT>::moveRight() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
     tryMove(0, 1);
 }
 
-void GameState::softDrop() {
+template <typename BoardT>
+void BasicGameState<BoardT>::softDrop() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
 
     if (tryMove(1, 0)) {
@@ -104,15 +206,15 @@ void GameState::softDrop() {
     }
 }
 
-void GameState::hardDrop() {
+template <typename BoardT>
+void BasicGameState<BoardT>::hardDrop() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
 
-    int droppedCells = 0;
-
-    // Drop until we can’t move further
-    while (tryMove(1, 0)) {
-        ++droppedCells;
-    }
+    // Drop straight to the landing row in one step
+    const int droppedCells = board_.dropDistance(*activeTetromino_);
+    Position origin = activeTetromino_->origin();
+    origin.row += droppedCells;
+    activeTetromino_->setOrigin(origin);
 
     // Player-initiated hard drop: +2 per cell moved
     scoreManager_.addHardDropCells(droppedCells);
@@ -120,61 +222,171 @@ void GameState::hardDrop() {
     lockActiveTetrominoAndProcessLines();
 
     if (board_.isGameOver() || !spawnNewTetromino()) {
-        status_ = GameStatus::GameOver;
+        endGame();
     }
 }
 
-void GameState::rotateClockwise() {
+template <typename BoardT>
+void BasicGameState<BoardT>::rotateClockwise() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
     tryRotate(true);
 }
 
-void GameState::rotateCounterClockwise() {
+template <typename BoardT>
+void BasicGameState<BoardT>::rotateCounterClockwise() {
     if (status_ != GameStatus::Running || !activeTetromino_) return;
     tryRotate(false);
 }
 
-bool GameState::spawnNewTetromino() {
-    const int rows = board_.rows();
-    const int cols = board_.cols();
+template <typename BoardT>
+std::size_t BasicGameState<BoardT>::applyCommands(Span<const PieceCommand> commands, Span<bool> accepted) {
+    const bool flags = !accepted.empty();
+    if (flags && accepted.size() < commands.size()) {
+        throw std::length_error("applyCommands: accepted is shorter than commands");
+    }
 
-    // Spawn origin roughly in the middle at row 0 or 1
-    Position spawn{0, cols / 2};
+    std::size_t applied = 0;
+    std::size_t i = 0;
+    while (i < commands.size() && status_ == GameStatus::Running && activeTetromino_) {
+        // Work on a copy until the piece locks or the batch ends
+        Tetromino piece = *activeTetromino_;
+        int softDropCells = 0;
+
+        for (; i < commands.size() && commands[i] != PieceCommand::HardDrop; ++i) {
+            Tetromino next = piece;
+            Position origin = next.origin();
+            switch (commands[i]) {
+            case PieceCommand::MoveLeft:  --origin.col; break;
+            case PieceCommand::MoveRight: ++origin.col; break;
+            case PieceCommand::SoftDrop:  ++origin.row; break;
+            case PieceCommand::RotateCW:  next.rotateClockwise(); break;
+            case PieceCommand::RotateCCW: next.rotateCounterClockwise(); break;
+            case PieceCommand::HardDrop:  break;
+            }
+            next.setOrigin(origin);
+
+            const bool ok = board_.canPlace(next);
+            if (ok) {
+                piece = next;
+                softDropCells += (commands[i] == PieceCommand::SoftDrop);
+                ++applied;
+            }
+            if (flags) accepted[i] = ok;
+        }
+
+        activeTetromino_ = piece;
+        scoreManager_.addSoftDropCells(softDropCells);
 
-    if (!nextTetromino_) {
-        nextTetromino_ = factory_.createRandom(spawn);
+        if (i < commands.size()) {
+            hardDrop(); // spawns the next piece or ends the game
+            if (flags) accepted[i] = true;
+            ++applied;
+            ++i;
+        }
     }
 
-    activeTetromino_ = nextTetromino_;
-    activeTetromino_->setOrigin(spawn);
+    for (; flags && i < commands.size(); ++i) {
+        accepted[i] = false;
+    }
+    return applied;
+}
 
-    nextTetromino_ = factory_.createRandom(spawn); // origin will be reset on spawn
+template <typename BoardT>
+bool BasicGameState<BoardT>::spawnNewTetromino() {
+    // Spawn origin roughly in the middle at row 0 or 1
+    activeTetromino_ = Tetromino{queue_.pop(factory_), Rotation::R0, spawnPosition()};
 
     if (!board_.canPlace(*activeTetromino_)) {
         // Cannot spawn -> game over
         activeTetromino_.reset();
         return false;
     }
+    recordPiece(GameEventKind::PieceSpawned, *activeTetromino_);
     return true;
 }
 
-void GameState::lockActiveTetrominoAndProcessLines() {
+template <typename BoardT>
+std::optional<Tetromino> BasicGameState<BoardT>::nextTetromino() const noexcept {
+    const auto upcoming = queue_.preview();
+    if (upcoming.empty()) {
+        return std::nullopt;
+    }
+    return Tetromino{upcoming.front(), Rotation::R0, spawnPosition()};
+}
+
+template <typename BoardT>
+void BasicGameState<BoardT>::setPreviewDepth(int depth) {
+    queue_.setDepth(depth);
+    if (queue_.size() > 0) {
+        queue_.fill(factory_); // a running game shows the deeper preview right away
+    }
+}
+
+template <typename BoardT>
+void BasicGameState<BoardT>::setSeed(std::uint64_t seed) {
+    factory_.setSeed(seed);
+
+    // Queued pieces came from the old sequence
+    const bool wasFilled = queue_.size() > 0;
+    queue_.clear();
+    if (wasFilled) {
+        queue_.fill(factory_);
+    }
+}
+
+template <typename BoardT>
+void BasicGameState<BoardT>::lockActiveTetrominoAndProcessLines() {
     if (!activeTetromino_) return;
 
     board_.lockTetromino(*activeTetromino_);
+    recordPiece(GameEventKind::PieceLocked, *activeTetromino_);
     activeTetromino_.reset();
 
-    int lines = board_.clearFullLines();
-    if (lines > 0) {
-        scoreManager_.addLinesCleared(lines, levelManager_.level());
-        levelManager_.onLinesCleared(lines);
+    const auto cleared = board_.clearLines();
+    if (cleared.count > 0) {
+        const int levelBefore = levelManager_.level();
+        scoreManager_.addLinesCleared(cleared.count, levelBefore);
+        levelManager_.onLinesCleared(cleared.count);
+
+        GameEvent event;
+        event.kind = GameEventKind::LinesCleared;
+        event.lines = static_cast<std::uint8_t>(cleared.count);
+        event.rows = cleared.rows;
+        events_.push(event);
+
+        if (levelManager_.level() > levelBefore) {
+            GameEvent levelUp;
+            levelUp.kind = GameEventKind::LevelUp;
+            levelUp.level = static_cast<std::uint16_t>(levelManager_.level());
+            events_.push(levelUp);
+        }
     }
 
     ++lockedPieces_;
-    
 }
 
-bool GameState::tryMove(int dRow, int dCol) {
+template <typename BoardT>
+void BasicGameState<BoardT>::recordPiece(GameEventKind kind, const Tetromino& piece) noexcept {
+    GameEvent event;
+    event.kind = kind;
+    event.piece = piece.type();
+    event.rotation = piece.rotation();
+    event.row = static_cast<std::int8_t>(piece.origin().row);
+    event.col = static_cast<std::int8_t>(piece.origin().col);
+    events_.push(event);
+}
+
+template <typename BoardT>
+void BasicGameState<BoardT>::endGame() noexcept {
+    status_ = GameStatus::GameOver;
+
+    GameEvent event;
+    event.kind = GameEventKind::GameOver;
+    events_.push(event);
+}
+
+template <typename BoardT>
+bool BasicGameState<BoardT>::tryMove(int dRow, int dCol) {
     if (!activeTetromino_) return false;
 
     Tetromino moved = *activeTetromino_;
@@ -190,7 +402,8 @@ bool GameState::tryMove(int dRow, int dCol) {
     return false;
 }
 
-bool GameState::tryRotate(bool clockwise) {
+template <typename BoardT>
+bool BasicGameState<BoardT>::tryRotate(bool clockwise) {
     if (!activeTetromino_) return false;
 
     Tetromino rotated = *activeTetromino_;
@@ -207,8 +420,172 @@ bool GameState::tryRotate(bool clockwise) {
     return false;
 }
 
-int GameState::gravityIntervalMs() const noexcept {
+template <typename BoardT>
+int BasicGameState<BoardT>::gravityIntervalMs() const noexcept {
     return levelManager_.gravityIntervalMs();
 }
 
+template <typename BoardT>
+std::size_t BasicGameState<BoardT>::snapshotSize() const noexcept {
+    const std::size_t cells = static_cast<std::size_t>(board_.rows()) * static_cast<std::size_t>(board_.cols());
+    return kSnapshotFixedBytes + static_cast<std::size_t>(queue_.size()) + (cells + 1) / 2;
+}
+
+template <typename BoardT>
+std::size_t BasicGameState<BoardT>::saveSnapshot(Span<std::uint8_t> out) const {
+    if (out.size() < snapshotSize()) {
+        throw std::length_error("GameState::saveSnapshot buffer too small");
+    }
+
+    SnapshotWriter w{out.data()};
+    for (std::uint8_t byte : kSnapshotMagic) {
+        w.u8(byte);
+    }
+    w.u8(SnapshotVersion);
+    w.u8(static_cast<std::uint8_t>(board_.rows()));
+    w.u8(static_cast<std::uint8_t>(board_.cols()));
+    w.u8(static_cast<std::uint8_t>(status_));
+
+    w.u64(scoreManager_.score());
+    w.u32(static_cast<std::uint32_t>(levelManager_.level()));
+    w.u64(levelManager_.totalLinesCleared());
+    w.u64(lockedPieces_);
+
+    w.u8(activeTetromino_ ? 1 : 0);
+    const Tetromino active = activeTetromino_.value_or(Tetromino{TetrominoType::I, Rotation::R0, Position{}});
+    w.u8(static_cast<std::uint8_t>(active.type()));
+    w.u8(static_cast<std::uint8_t>(active.rotation()));
+    w.u8(static_cast<std::uint8_t>(static_cast<std::int8_t>(active.origin().row)));
+    w.u8(static_cast<std::uint8_t>(static_cast<std::int8_t>(active.origin().col)));
+
+    const TetrominoFactory::State factory = factory_.state();
+    w.u64(factory.seed);
+    w.u64(factory.randomizer.rng.state);
+    w.u64(factory.randomizer.rng.inc);
+    for (TetrominoType type : factory.randomizer.bag) {
+        w.u8(static_cast<std::uint8_t>(type));
+    }
+    w.u8(factory.randomizer.index);
+
+    const auto pending = queue_.pending();
+    w.u8(static_cast<std::uint8_t>(queue_.depth()));
+    w.u8(static_cast<std::uint8_t>(pending.size()));
+    for (TetrominoType type : pending) {
+        w.u8(static_cast<std::uint8_t>(type));
+    }
+
+    std::uint8_t packed = 0;
+    int nibble = 0;
+    for (int r = 0; r < board_.rows(); ++r) {
+        const auto row = board_.row(r);
+        for (int c = 0; c < board_.cols(); ++c) {
+            std::uint8_t code = 0;
+            if (row.filled(c)) {
+                code = row.codes[c] != BoardTypes::NoType ? row.codes[c] : kUntypedCell;
+            }
+            packed = static_cast<std::uint8_t>(packed | (code << (4 * nibble)));
+            if (++nibble == 2) {
+                w.u8(packed);
+                packed = 0;
+                nibble = 0;
+            }
+        }
+    }
+    if (nibble != 0) {
+        w.u8(packed);
+    }
+    return w.size();
+}
+
+template <typename BoardT>
+void BasicGameState<BoardT>::loadSnapshot(Span<const std::uint8_t> in) {
+    // Parse and validate everything first; only then touch the game.
+    SnapshotReader r{in};
+    for (std::uint8_t byte : kSnapshotMagic) {
+        if (r.u8() != byte) {
+            throw std::invalid_argument("Not a GameState snapshot");
+        }
+    }
+    if (r.u8() != SnapshotVersion) {
+        throw std::invalid_argument("Unsupported GameState snapshot version");
+    }
+    if (r.u8() != board_.rows() || r.u8() != board_.cols()) {
+        throw std::invalid_argument("GameState snapshot board size does not match");
+    }
+    const auto status = static_cast<GameStatus>(r.below(4, "Bad status in GameState snapshot"));
+
+    const std::uint64_t score = r.u64();
+    const auto level = static_cast<int>(r.u32());
+    const std::uint64_t lines = r.u64();
+    const std::uint64_t lockedPieces = r.u64();
+
+    const bool hasActive = r.below(2, "Bad active piece flag in GameState snapshot") != 0;
+    const auto activeType = static_cast<TetrominoType>(r.below(7, "Bad piece type in GameState snapshot"));
+    const auto activeRot = static_cast<Rotation>(r.below(4, "Bad rotation in GameState snapshot"));
+    const int activeRow = static_cast<std::int8_t>(r.u8());
+    const int activeCol = static_cast<std::int8_t>(r.u8());
+
+    TetrominoFactory::State factory{};
+    factory.seed = r.u64();
+    factory.randomizer.rng.state = r.u64();
+    factory.randomizer.rng.inc = r.u64();
+    for (auto& type : factory.randomizer.bag) {
+        type = static_cast<TetrominoType>(r.below(7, "Bad bag entry in GameState snapshot"));
+    }
+    factory.randomizer.index = r.below(8, "Bad bag index in GameState snapshot");
+
+    const int depth = r.u8();
+    if (depth < PieceQueue::MinDepth || depth > PieceQueue::MaxDepth) {
+        throw std::invalid_argument("Bad preview depth in GameState snapshot");
+    }
+    std::array<TetrominoType, PieceQueue::Capacity> pending{};
+    const std::size_t pendingCount = r.below(PieceQueue::Capacity + 1, "Bad queue size in GameState snapshot");
+    for (std::size_t i = 0; i < pendingCount; ++i) {
+        pending[i] = static_cast<TetrominoType>(r.below(7, "Bad queued piece in GameState snapshot"));
+    }
+
+    const std::size_t cellCount = static_cast<std::size_t>(board_.rows()) * static_cast<std::size_t>(board_.cols());
+    const std::uint8_t* cells = r.position();
+    r.skip((cellCount + 1) / 2);
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        if (((cells[i / 2] >> (4 * (i % 2))) & 0x0F) > kUntypedCell) {
+            throw std::invalid_argument("Bad cell in GameState snapshot");
+        }
+    }
+    if (!r.atEnd()) {
+        throw std::invalid_argument("Trailing bytes after GameState snapshot");
+    }
+
+    board_.clear();
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        const std::uint8_t code = (cells[i / 2] >> (4 * (i % 2))) & 0x0F;
+        const int row = static_cast<int>(i) / board_.cols();
+        const int col = static_cast<int>(i) % board_.cols();
+        if (code == kUntypedCell) {
+            board_.setCell(row, col, CellState::Filled);
+        } else if (code != BoardTypes::NoType) {
+            board_.fillCell(row, col, *BoardTypes::decodeType(code));
+        }
+    }
+
+    if (hasActive) {
+        activeTetromino_ = Tetromino{activeType, activeRot, Position{activeRow, activeCol}};
+    } else {
+        activeTetromino_.reset();
+    }
+    factory_.restore(factory);
+    queue_.restore(depth, Span<const TetrominoType>{pending.data(), pendingCount});
+    scoreManager_.restore(score);
+    levelManager_.restore(level, lines);
+    lockedPieces_ = lockedPieces;
+    status_ = status;
+}
+
+// fork() relies on this: no pointers or heap state anywhere in a game
+static_assert(std::is_trivially_copyable_v<GameState> && std::is_trivially_destructible_v<GameState>,
+              "GameState must stay trivially copyable");
+
+template class BasicGameState<StandardBoard>;
+template class BasicGameState<Board>;
+
 } // namespace tetris::core
@@ -0,0 +1,117 @@
+#include "core/MoveGenerator.hpp"
+
+#include <algorithm>
+
+namespace tetris::core {
+
+using tetris::controller::InputAction;
+
+MoveGenerator::MoveGenerator()
+{
+    placements_.reserve(MaxNodes);
+}
+
+void MoveGenerator::beginSearch() {
+    if (++generation_ == 0) {
+        // Stamp counter wrapped: old stamps could look current again
+        visited_.fill(0);
+        landed_.fill(0);
+        generation_ = 1;
+    }
+}
+
+template <typename BoardT>
+Span<const Placement> MoveGenerator::generate(const BoardT& board, const Tetromino& piece) {
+    placements_.clear();
+    if (!board.canPlace(piece)) {
+        return {};
+    }
+
+    rows_ = board.rows();
+    cols_ = board.cols();
+    beginSearch();
+
+    const TetrominoType type = piece.type();
+
+    // Every shape contains its origin cell, so any pose that fits has its
+    // origin inside the board and encodes to a valid node.
+    const Position start = piece.origin();
+    const int startNode = encode(static_cast<int>(piece.rotation()), start.row, start.col);
+    visited_[startNode] = generation_;
+    parent_[startNode] = static_cast<std::uint16_t>(startNode);
+    action_[startNode] = NoAction;
+    depth_[startNode] = 0;
+
+    struct Step {
+        int dRot;
+        int dRow;
+        int dCol;
+        InputAction action;
+    };
+    static constexpr Step kSteps[] = {
+        {0, 0, -1, InputAction::MoveLeft},
+        {0, 0, 1, InputAction::MoveRight},
+        {1, 0, 0, InputAction::RotateCW},
+        {3, 0, 0, InputAction::RotateCCW},
+        {0, 1, 0, InputAction::SoftDrop},
+    };
+
+    int head = 0;
+    int tail = 0;
+    queue_[tail++] = static_cast<std::uint16_t>(startNode);
+
+    while (head < tail) {
+        const int node = queue_[head++];
+        const int col = node % cols_;
+        const int row = (node / cols_) % rows_;
+        const int rot = node / (cols_ * rows_);
+        const Tetromino current{type, static_cast<Rotation>(rot), Position{row, col}};
+
+        // HardDrop from here: record the landing pose the first time it is seen
+        const int landRow = row + board.dropDistance(current);
+        const int canonicalRot = current.shape().canonicalRotation;
+        const int landKey = encode(canonicalRot, landRow, col);
+        if (landed_[landKey] != generation_) {
+            landed_[landKey] = generation_;
+            placements_.push_back(Placement{
+                Tetromino{type, static_cast<Rotation>(rot), Position{landRow, col}},
+                depth_[node] + 1,
+                static_cast<std::uint16_t>(node)
+            });
+        }
+
+        for (const Step& step : kSteps) {
+            const Tetromino next{type,
+                                 static_cast<Rotation>((rot + step.dRot) % 4),
+                                 Position{row + step.dRow, col + step.dCol}};
+            if (!board.canPlace(next)) {
+                continue;
+            }
+            const int nextNode = encode((rot + step.dRot) % 4, row + step.dRow, col + step.dCol);
+            if (visited_[nextNode] == generation_) {
+                continue;
+            }
+            visited_[nextNode] = generation_;
+            parent_[nextNode] = static_cast<std::uint16_t>(node);
+            action_[nextNode] = static_cast<std::uint8_t>(step.action);
+            depth_[nextNode] = static_cast<std::uint16_t>(depth_[node] + 1);
+            queue_[tail++] = static_cast<std::uint16_t>(nextNode);
+        }
+    }
+
+    return Span<const Placement>{placements_.data(), placements_.size()};
+}
+
+void MoveGenerator::path(const Placement& placement, std::vector<InputAction>& out) const {
+    out.clear();
+    for (int node = placement.from; action_[node] != NoAction; node = parent_[node]) {
+        out.push_back(static_cast<InputAction>(action_[node]));
+    }
+    std::reverse(out.begin(), out.end());
+    out.push_back(InputAction::HardDrop);
+}
+
+template Span<const Placement> MoveGenerator::generate(const StandardBoard&, const Tetromino&);
+template Span<const Placement> MoveGenerator::generate(const Board&, const Tetromino&);
+
+} // namespace tetris::core
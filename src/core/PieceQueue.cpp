@@ -0,0 +1,69 @@
+#include "core/PieceQueue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace tetris::core {
+
+PieceQueue::PieceQueue(int depth)
+{
+    setDepth(depth);
+}
+
+void PieceQueue::setDepth(int depth) {
+    if (depth < MinDepth || depth > MaxDepth) {
+        throw std::invalid_argument("PieceQueue depth must be between 1 and 7");
+    }
+    depth_ = static_cast<std::uint8_t>(depth);
+}
+
+void PieceQueue::clear() noexcept {
+    head_ = 0;
+    count_ = 0;
+}
+
+void PieceQueue::fill(TetrominoFactory& factory) {
+    while (count_ < depth_) {
+        for (int i = 0; i < BatchSize; ++i) {
+            push(factory.nextType());
+        }
+    }
+}
+
+TetrominoType PieceQueue::pop(TetrominoFactory& factory) {
+    fill(factory);
+    const TetrominoType front = slots_[head_];
+    head_ = static_cast<std::uint8_t>((head_ + 1) % Capacity);
+    --count_;
+    fill(factory);
+    return front;
+}
+
+Span<const TetrominoType> PieceQueue::preview() const noexcept {
+    const int visible = std::min<int>(count_, depth_);
+    return Span<const TetrominoType>{slots_.data() + head_, static_cast<std::size_t>(visible)};
+}
+
+Span<const TetrominoType> PieceQueue::pending() const noexcept {
+    return Span<const TetrominoType>{slots_.data() + head_, count_};
+}
+
+void PieceQueue::restore(int depth, Span<const TetrominoType> pieces) {
+    if (pieces.size() > static_cast<std::size_t>(Capacity)) {
+        throw std::invalid_argument("PieceQueue holds at most 14 pieces");
+    }
+    setDepth(depth);
+    clear();
+    for (TetrominoType type : pieces) {
+        push(type);
+    }
+}
+
+void PieceQueue::push(TetrominoType type) noexcept {
+    const int tail = (head_ + count_) % Capacity;
+    slots_[tail] = type;
+    slots_[tail + Capacity] = type;
+    ++count_;
+}
+
+} // namespace tetris::core
@@ -0,0 +1,37 @@
+#include "core/Random.hpp"
+
+#include <utility>
+
+namespace tetris::core {
+
+SevenBagRandomizer::SevenBagRandomizer(std::uint64_t seed) noexcept
+    : rng_{seed}
+{
+}
+
+void SevenBagRandomizer::reseed(std::uint64_t seed) noexcept {
+    rng_.reseed(seed);
+    index_ = static_cast<std::uint8_t>(bag_.size());
+}
+
+TetrominoType SevenBagRandomizer::next() noexcept {
+    if (index_ >= bag_.size()) {
+        refill();
+    }
+    return bag_[index_++];
+}
+
+void SevenBagRandomizer::refill() noexcept {
+    for (std::size_t i = 0; i < bag_.size(); ++i) {
+        bag_[i] = static_cast<TetrominoType>(i);
+    }
+
+    // Fisher-Yates shuffle
+    for (std::uint32_t i = static_cast<std::uint32_t>(bag_.size()) - 1; i > 0; --i) {
+        const std::uint32_t j = rng_.bounded(i + 1);
+        std::swap(bag_[i], bag_[j]);
+    }
+    index_ = 0;
+}
+
+} // namespace tetris::core
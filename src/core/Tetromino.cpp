@@ -19,7 +19,7 @@ void Tetromino::rotateCounterClockwise() noexcept {
 }
 
 Tetromino::Shape Tetromino::blocks() const noexcept {
-    Shape rel = shapeFor(type_, rotation_);
+    const Shape& rel = shape().blocks;
     Shape abs{};
     for (int i = 0; i < BlockCount; ++i) {
         abs[i].row = origin_.row + rel[i].row;
@@ -28,170 +28,4 @@ Tetromino::Shape Tetromino::blocks() const noexcept {
     return abs;
 }
 
-Tetromino::Shape Tetromino::shapeFor(TetrominoType type, Rotation rotation) noexcept {
-    using S = Tetromino::Shape;
-
-    switch (type) {
-    case TetrominoType::I:
-        switch (rotation) {
-        case Rotation::R0:
-        case Rotation::R180:
-            // Horizontal I:  [ ][ ][ ][ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {0, 2}
-            }};
-        case Rotation::R90:
-        case Rotation::R270:
-            // Vertical I:
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {2, 0}
-            }};
-        }
-        break;
-
-    case TetrominoType::O:
-        // O piece is same in all rotations: 2x2 block
-        return S{{
-            {0, 0}, {0, 1},
-            {1, 0}, {1, 1}
-        }};
-
-    case TetrominoType::T:
-        switch (rotation) {
-        case Rotation::R0:
-            //   [ ]
-            // [ ][T][ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {1, 0}
-            }};
-        case Rotation::R90:
-            // [ ]
-            // [T][ ]
-            // [ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {0, 1}
-            }};
-        case Rotation::R180:
-            // [ ][T][ ]
-            //   [ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {-1, 0}
-            }};
-        case Rotation::R270:
-            //   [ ]
-            // [T][ ]
-            //   [ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {0, -1}
-            }};
-        }
-        break;
-
-    case TetrominoType::L:
-        switch (rotation) {
-        case Rotation::R0:
-            //     [ ]
-            // [ ][L][ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {1, 1}
-            }};
-        case Rotation::R90:
-            // [ ]
-            // [ ]
-            // [L][ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {1, -1}
-            }};
-        case Rotation::R180:
-            // [L][ ][ ]
-            // [ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {-1, -1}
-            }};
-        case Rotation::R270:
-            // [L][ ]
-            //   [ ]
-            //   [ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {-1, 1}
-            }};
-        }
-        break;
-
-    case TetrominoType::J:
-        switch (rotation) {
-        case Rotation::R0:
-            // [ ]
-            // [J][ ][ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {1, -1}
-            }};
-        case Rotation::R90:
-            // [J][ ]
-            // [ ]
-            // [ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {-1, -1}
-            }};
-        case Rotation::R180:
-            // [ ][ ][J]
-            //       [ ]
-            return S{{
-                {0, -1}, {0, 0}, {0, 1}, {-1, 1}
-            }};
-        case Rotation::R270:
-            //   [ ]
-            //   [ ]
-            // [J][ ]
-            return S{{
-                {-1, 0}, {0, 0}, {1, 0}, {1, 1}
-            }};
-        }
-        break;
-
-    case TetrominoType::S:
-        switch (rotation) {
-        case Rotation::R0:
-        case Rotation::R180:
-            //   [S][ ]
-            // [ ][S]
-            return S{{
-                {0, 0}, {0, 1}, {1, -1}, {1, 0}
-            }};
-        case Rotation::R90:
-        case Rotation::R270:
-            // [ ]
-            // [S][ ]
-            //   [S]
-            return S{{
-                {-1, 0}, {0, 0}, {0, 1}, {1, 1}
-            }};
-        }
-        break;
-
-    case TetrominoType::Z:
-        switch (rotation) {
-        case Rotation::R0:
-        case Rotation::R180:
-            // [Z][ ]
-            //   [Z][ ]
-            return S{{
-                {0, -1}, {0, 0}, {1, 0}, {1, 1}
-            }};
-        case Rotation::R90:
-        case Rotation::R270:
-            //   [ ]
-            // [Z][ ]
-            // [ ]
-            return S{{
-                {-1, 1}, {0, 0}, {0, 1}, {1, 0}
-            }};
-        }
-        break;
-    }
-
-    // Fallback (should never happen)
-    return S{{ {0,0}, {0,0}, {0,0}, {0,0} }};
-}
-
 } // namespace tetris::core
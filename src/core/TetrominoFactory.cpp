@@ -4,14 +4,28 @@
 namespace tetris::core {
 
 TetrominoFactory::TetrominoFactory()
-    : rng_{std::random_device{}()}
+    : TetrominoFactory(randomSeed())
 {
 }
 
+TetrominoFactory::TetrominoFactory(std::uint64_t seed)
+    : seed_{seed}
+    , randomizer_{seed}
+{
+}
+
+void TetrominoFactory::setSeed(std::uint64_t seed) noexcept {
+    seed_ = seed;
+    randomizer_.reseed(seed);
+}
+
 Tetromino TetrominoFactory::createRandom(Position origin) {
-    std::uniform_int_distribution<int> dist(0, 6); // 7 types
-    TetrominoType type = static_cast<TetrominoType>(dist(rng_));
-    return Tetromino{type, Rotation::R0, origin};
+    return Tetromino{nextType(), Rotation::R0, origin};
+}
+
+std::uint64_t TetrominoFactory::randomSeed() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32U) | rd();
 }
 
 } // namespace tetris::core
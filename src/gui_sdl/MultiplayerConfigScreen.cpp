@@ -17,6 +17,8 @@ MultiplayerConfigScreen::MultiplayerConfigScreen()
     port_ = static_cast<int>(cfg_.port);
     timeLimitSec_ = static_cast<int>(cfg_.timeLimitSeconds);
     piecesPerTurn_ = static_cast<int>(cfg_.piecesPerTurn);
+    lockstep_ = cfg_.lockstep;
+    rollbackWindow_ = static_cast<int>(cfg_.rollbackWindowTicks);
 
     std::strncpy(hostAddressBuf_, cfg_.hostAddress.c_str(), sizeof(hostAddressBuf_) - 1);
     hostAddressBuf_[sizeof(hostAddressBuf_) - 1] = '\0';
@@ -88,6 +90,11 @@ void MultiplayerConfigScreen::render(Application& app)
         ImGui::InputInt("Pieces per turn", &piecesPerTurn_);
         if (piecesPerTurn_ < 1) piecesPerTurn_ = 1;
     }
+    ImGui::Checkbox("Lockstep (send inputs only)", &lockstep_);
+    if (lockstep_ && modeIndex_ == 0) {
+        ImGui::InputInt("Rollback window (ticks, 0 = off)", &rollbackWindow_);
+        if (rollbackWindow_ < 0) rollbackWindow_ = 0;
+    }
     ImGui::EndDisabled();
 
     if (isJoin) {
@@ -123,6 +130,8 @@ void MultiplayerConfigScreen::render(Application& app)
                 cfg_.piecesPerTurn = static_cast<std::uint32_t>(piecesPerTurn_);
                 cfg_.timeLimitSeconds = 0;
             }
+            cfg_.lockstep = lockstep_;
+            cfg_.rollbackWindowTicks = static_cast<std::uint32_t>(rollbackWindow_);
         } else {
             // Joiner: rules come from host's StartGame (Lobby/Game screen)
             // Keep cfg_.mode/timeLimitSeconds/piecesPerTurn as-is (or set to safe defaults)
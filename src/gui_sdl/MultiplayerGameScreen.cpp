@@ -18,25 +18,6 @@ static float clampf(float v, float a, float b) {
     return std::max(a, std::min(b, v));
 }
 
-std::uint32_t MultiplayerGameScreen::boardHash(const tetris::core::Board& b)
-{
-    std::uint32_t h = 2166136261u; // FNV-1a
-    for (int r = 0; r < b.rows(); ++r) {
-        for (int c = 0; c < b.cols(); ++c) {
-            const bool occ = (b.cell(r, c) == tetris::core::CellState::Filled);
-            std::uint32_t v = occ ? 1u : 0u;
-            if (occ) {
-                if (auto t = b.cellType(r, c)) {
-                    v = 10u + static_cast<std::uint32_t>(*t);
-                }
-            }
-            h ^= (v + 31u * (std::uint32_t)r + 131u * (std::uint32_t)c);
-            h *= 16777619u;
-        }
-    }
-    return h;
-}
-
 // ------------------ ctor ------------------
 
 MultiplayerGameScreen::MultiplayerGameScreen(const tetris::net::MultiplayerConfig& cfg,
@@ -71,17 +52,136 @@ MultiplayerGameScreen::MultiplayerGameScreen(const tetris::net::MultiplayerConfi
     if (host_ && cfg_.isHost && !host_->isMatchStarted()) {
         host_->startMatch();
     }
+    seedGamesFromHost();
 
     localGame_.start();  localCtrl_.resetTiming();
     oppGame_.start();    oppCtrl_.resetTiming();
     sharedGame_.start(); sharedCtrl_.resetTiming();
+    simClock_.reset();
+    oppSinceInput_ = {};
+
+    if (host_ && cfg_.isHost && cfg_.lockstep) {
+        startLockstep(host_->matchSeed(), cfg_.lockstepTickMs, cfg_.inputDelayTicks,
+                      cfg_.rollbackWindowTicks, tetris::net::NetworkHost::HostPlayerId);
+    }
 
     turnPlayerId_ = 1;
     piecesLeftThisTurn_ = (cfg_.piecesPerTurn > 0 ? cfg_.piecesPerTurn : 1);
     lastActionPlayerId_ = turnPlayerId_;
 
-    boardHashInit_ = false;
-    lastBoardHash_ = 0;
+    sharedEventCursor_ = sharedGame_.events().head();
+}
+
+void MultiplayerGameScreen::seedGamesFromHost()
+{
+    if (!host_ || !cfg_.isHost) return;
+
+    // Same seed for every board: all players are dealt the same pieces.
+    const auto seed = host_->matchSeed();
+    localGame_.setSeed(seed);
+    oppGame_.setSeed(seed);
+    sharedGame_.setSeed(seed);
+}
+
+// ------------------ lockstep / rollback ------------------
+
+void MultiplayerGameScreen::startLockstep(std::uint64_t seed, std::uint32_t tickMs,
+                                          std::uint32_t inputDelayTicks, std::uint32_t rollbackWindowTicks,
+                                          tetris::net::PlayerId localId)
+{
+    // This screen is always one host (id 1) and one client.
+    const auto hostId = tetris::net::NetworkHost::HostPlayerId;
+    const auto otherId = (localId == hostId) ? static_cast<tetris::net::PlayerId>(2) : hostId;
+    std::vector<tetris::net::PlayerId> players{ localId, otherId };
+
+    lockstep_.reset();
+    rollback_.reset();
+    // Ticks simulated per frame are capped so a hitch (or a peer that
+    // stalled us) does not turn into one long catch-up frame.
+    constexpr std::uint32_t kMaxCatchUpTicks = 8;
+    lockstepClock_ = tetris::controller::FixedTimestep::withPeriod(
+        std::chrono::milliseconds{tickMs}, kMaxCatchUpTicks);
+
+    if (cfg_.mode == tetris::net::GameMode::TimeAttack && rollbackWindowTicks > 0) {
+        tetris::net::RollbackSession::Config rc;
+        rc.tickMs = tickMs;
+        rc.inputDelayTicks = inputDelayTicks;
+        rc.rollbackWindowTicks = rollbackWindowTicks;
+        rollback_ = std::make_unique<tetris::net::RollbackSession>(localId, std::move(players), seed, rc);
+        return;
+    }
+
+    tetris::net::LockstepSession::Config lc;
+    lc.mode = cfg_.mode;
+    lc.piecesPerTurn = cfg_.piecesPerTurn;
+    lc.tickMs = tickMs;
+    lc.inputDelayTicks = inputDelayTicks;
+    lockstep_ = std::make_unique<tetris::net::LockstepSession>(localId, std::move(players), seed, lc);
+}
+
+template <typename SessionT>
+bool MultiplayerGameScreen::stepInputSession(SessionT& session, float dtSeconds)
+{
+    std::vector<tetris::net::Message> incoming;
+    if (host_) incoming = host_->consumeLockstepMessages();
+    else if (client_) incoming = client_->consumeLockstepMessages();
+    for (const auto& m : incoming) {
+        session.receive(m);
+    }
+
+    // Ticks a stalled session could not run stay pending for later frames
+    lockstepClock_.accumulateSeconds(dtSeconds);
+    const int ran = session.advance(static_cast<int>(lockstepClock_.pending()));
+    lockstepClock_.consume(static_cast<std::uint32_t>(ran));
+
+    std::vector<tetris::net::Message> outgoing;
+    session.takeOutgoing(outgoing);
+    for (const auto& m : outgoing) {
+        if (host_) host_->broadcast(m);
+        else if (client_) client_->sendLockstep(m);
+    }
+
+    // Copy the simulated games out; rendering and match rules read these.
+    const auto selfId = session.localId();
+    const auto& players = session.players();
+    const auto otherId = (players.front() == selfId) ? players.back() : players.front();
+    if (cfg_.mode == tetris::net::GameMode::TimeAttack) {
+        localGame_ = session.game(selfId);
+        oppGame_ = session.game(otherId);
+    } else {
+        sharedGame_ = session.game(selfId);
+    }
+
+    matchElapsedSec_ = static_cast<float>(session.elapsedMs()) / 1000.0f;
+    const std::uint64_t limitMs = std::uint64_t{cfg_.timeLimitSeconds} * 1000u;
+    displayTimeLeftMs_ = static_cast<std::uint32_t>(
+        limitMs > session.elapsedMs() ? limitMs - session.elapsedMs() : 0u);
+
+    return !incoming.empty();
+}
+
+bool MultiplayerGameScreen::updateLockstep(float dtSeconds)
+{
+    if (rollback_) {
+        return stepInputSession(*rollback_, dtSeconds);
+    }
+
+    const bool received = stepInputSession(*lockstep_, dtSeconds);
+    if (cfg_.mode == tetris::net::GameMode::SharedTurns) {
+        turnPlayerId_ = lockstep_->turnPlayerId();
+        piecesLeftThisTurn_ = lockstep_->piecesLeftThisTurn();
+        if (sharedGame_.status() != tetris::core::GameStatus::GameOver) {
+            lastActionPlayerId_ = turnPlayerId_;
+        }
+    }
+    return received;
+}
+
+std::optional<tetris::net::Tick> MultiplayerGameScreen::desyncTick() const
+{
+    if (lockstep_) return lockstep_->desyncTick();
+    if (rollback_) return rollback_->desyncTick();
+    return std::nullopt;
 }
 
 // ------------------ input mapping ------------------
@@ -119,8 +219,19 @@ void MultiplayerGameScreen::sendOrApplyAction(tetris::core::GameState& gs,
                                              tetris::controller::GameController& gc,
                                              tetris::controller::InputAction action)
 {
+    if (lockstep_ || rollback_) {
+        // Applied at its scheduled tick by both peers
+        if (lockstep_) lockstep_->addLocalInput(action);
+        else rollback_->addLocalInput(action);
+        return;
+    }
+
     if (client_) {
-        client_->sendInput(action, static_cast<tetris::net::Tick>(clientTick_++));
+        const auto tick = static_cast<tetris::net::Tick>(clientTick_++);
+        client_->sendInput(action, tick);
+        if (predicting_) {
+            predictor_.applyLocal(action, tick);
+        }
         return;
     }
 
@@ -193,7 +304,7 @@ void MultiplayerGameScreen::handleEvent(Application& app, const SDL_Event& e)
         tetris::net::PlayerId myId = cfg_.isHost ? 1u : (client_ && client_->playerId() ? *client_->playerId() : 0u);
 
         tetris::net::PlayerId currentTurn = 0u;
-        if (cfg_.isHost) {
+        if (cfg_.isHost || lockstep_) {
             currentTurn = turnPlayerId_;
         } else {
             std::lock_guard<std::mutex> lock(stateMutex_);
@@ -219,12 +330,30 @@ void MultiplayerGameScreen::applyRemoteInputsHost()
     if (inputs.empty()) return;
 
     for (const auto& m : inputs) {
-        if (cfg_.mode == tetris::net::GameMode::TimeAttack) {
-            oppCtrl_.handleAction(m.action);
-        } else {
-            sharedCtrl_.handleAction(m.action);
-        }
+        remoteBatch_.push_back({ m.action, m.clientTick });
+    }
+    flushRemoteBatch(cfg_.mode == tetris::net::GameMode::TimeAttack ? oppCtrl_ : sharedCtrl_);
+}
+
+std::optional<tetris::net::Tick> MultiplayerGameScreen::flushRemoteBatch(tetris::controller::GameController& gc)
+{
+    if (remoteBatch_.empty()) return std::nullopt;
+    if (remoteAcceptedCapacity_ < remoteBatch_.size()) {
+        remoteAcceptedCapacity_ = std::max(remoteBatch_.size(), remoteAcceptedCapacity_ * 2);
+        remoteAccepted_ = std::make_unique<bool[]>(remoteAcceptedCapacity_);
+    }
+    gc.handleActions(tetris::core::Span<const tetris::controller::TimedInputAction>{
+                         remoteBatch_.data(), remoteBatch_.size() },
+                     tetris::core::Span<bool>{ remoteAccepted_.get(), remoteBatch_.size() });
+
+    std::optional<tetris::net::Tick> newest;
+    for (std::size_t i = 0; i < remoteBatch_.size(); ++i) {
+        if (!remoteAccepted_[i]) continue;
+        const auto tick = static_cast<tetris::net::Tick>(remoteBatch_[i].timestamp);
+        newest = newest ? std::max(*newest, tick) : tick;
     }
+    remoteBatch_.clear();
+    return newest;
 }
 
 void MultiplayerGameScreen::updateSharedTurnsTurnHost()
@@ -235,31 +364,27 @@ void MultiplayerGameScreen::updateSharedTurnsTurnHost()
     if (piecesLeftThisTurn_ == 0) {
         piecesLeftThisTurn_ = std::max(1u, cfg_.piecesPerTurn);
         turnPlayerId_ = tetris::net::NetworkHost::HostPlayerId;
-        boardHashInit_ = false;
-    }
-
-    const auto currentHash = boardHash(sharedGame_.board());
-    if (!boardHashInit_) {
-        boardHashInit_ = true;
-        lastBoardHash_ = currentHash;
+        sharedEventCursor_ = sharedGame_.events().head();
         return;
     }
 
-    if (currentHash != lastBoardHash_) {
-        lastBoardHash_ = currentHash;
+    // Every lock counts, even when several land in one frame
+    sharedEventCursor_ = sharedGame_.events().forEachSince(
+        sharedEventCursor_, [this](const tetris::core::GameEvent& event) {
+            if (event.kind != tetris::core::GameEventKind::PieceLocked) return;
 
-        if (piecesLeftThisTurn_ > 0) {
-            --piecesLeftThisTurn_;
-        }
+            if (piecesLeftThisTurn_ > 0) {
+                --piecesLeftThisTurn_;
+            }
 
-        if (piecesLeftThisTurn_ == 0) {
-            const auto hostId = tetris::net::NetworkHost::HostPlayerId;
-            const auto clientId = static_cast<tetris::net::PlayerId>(2);
+            if (piecesLeftThisTurn_ == 0) {
+                const auto hostId = tetris::net::NetworkHost::HostPlayerId;
+                const auto clientId = static_cast<tetris::net::PlayerId>(2);
 
-            turnPlayerId_ = (turnPlayerId_ == hostId) ? clientId : hostId;
-            piecesLeftThisTurn_ = std::max(1u, cfg_.piecesPerTurn);
-        }
-    }
+                turnPlayerId_ = (turnPlayerId_ == hostId) ? clientId : hostId;
+                piecesLeftThisTurn_ = std::max(1u, cfg_.piecesPerTurn);
+            }
+        });
 }
 
 // ------------------ DTO mapping (host snapshot) ------------------
@@ -293,19 +418,20 @@ MultiplayerGameScreen::makeBoardDTOFromGame(const tetris::core::GameState& gs, b
         return static_cast<std::size_t>(r * dto.width + c);
     };
 
+    auto out = dto.cells.begin();
     for (int r = 0; r < dto.height; ++r) {
-        for (int c = 0; c < dto.width; ++c) {
-            auto& cell = dto.cells[idx(r, c)];
-            const bool occ = (b.cell(r, c) == tetris::core::CellState::Filled);
-            cell.occupied = occ;
+        const auto row = b.row(r);
+        for (int c = 0; c < dto.width; ++c, ++out) {
+            const bool occ = row.filled(c);
+            out->occupied = occ;
 
             if (!occ) {
-                cell.colorIndex = 0;
+                out->colorIndex = 0;
                 continue;
             }
 
-            const auto t = b.cellType(r, c);
-            cell.colorIndex = t ? colorIndexForTetromino(*t) : 0;
+            const auto t = row.type(c);
+            out->colorIndex = t ? colorIndexForTetromino(*t) : 0;
         }
     }
 
@@ -359,6 +485,16 @@ void MultiplayerGameScreen::broadcastSnapshotHost()
         pClient.level = oppGame_.level();
         pClient.isAlive = (oppGame_.status() != tetris::core::GameStatus::GameOver);
 
+        // Lets the client reconcile its predicted game
+        pClient.lastInputTick = lastOppInputTick_;
+        pClient.gameSnapshot.resize(oppGame_.snapshotSize());
+        oppGame_.saveSnapshot(tetris::core::Span<std::uint8_t>{pClient.gameSnapshot.data(),
+                                                               pClient.gameSnapshot.size()});
+        pClient.snapshotTiming = tetris::net::SnapshotTimingDTO{
+            static_cast<std::uint32_t>(oppSinceInput_.count()),
+            static_cast<std::uint32_t>(oppCtrl_.accumulatedTime().count())
+        };
+
         su.players.push_back(std::move(pHost));
         su.players.push_back(std::move(pClient));
     } else {
@@ -412,13 +548,29 @@ void MultiplayerGameScreen::update(Application&, float dtSeconds)
             }
 
             if (auto sg = client_->consumeStartGame()) {
-                (void)sg;
+                lockstep_.reset();
+                rollback_.reset();
+                if (sg->lockstepTickMs != 0 && client_->playerId()) {
+                    cfg_.mode = sg->mode;
+                    cfg_.timeLimitSeconds = sg->timeLimitSeconds;
+                    cfg_.piecesPerTurn = sg->piecesPerTurn;
+                    startLockstep(sg->pieceSeed.value_or(0), sg->lockstepTickMs, sg->inputDelayTicks,
+                                  sg->rollbackWindowTicks, *client_->playerId());
+                }
+
+                // Prediction needs the seed to deal the same pieces as the host
+                predicting_ = !lockstep_ && !rollback_ && sg->mode == tetris::net::GameMode::TimeAttack
+                              && sg->pieceSeed.has_value();
+                if (predicting_) {
+                    predictor_.reset(*sg->pieceSeed);
+                }
 
                 matchEnded_ = false;
                 hostDisconnected_ = false;
                 opponentDisconnected_ = false;
 
                 matchElapsedSec_ = 0.0f;
+                simClock_.reset();
                 localMatchResult_.reset();
 
                 waitingRematchStart_ = false;
@@ -447,6 +599,14 @@ void MultiplayerGameScreen::update(Application&, float dtSeconds)
 
                 turnPlayerId_ = up->turnPlayerId;
                 piecesLeftThisTurn_ = up->piecesLeftThisTurn;
+
+                const auto myId = client_->playerId();
+                for (const auto& p : up->players) {
+                    if (!predicting_ || !myId || p.id != *myId || p.gameSnapshot.empty()) continue;
+                    predictor_.reconcile(
+                        tetris::core::Span<const std::uint8_t>{p.gameSnapshot.data(), p.gameSnapshot.size()},
+                        p.lastInputTick, p.snapshotTiming);
+                }
             }
 
             if (!matchEnded_) {
@@ -457,6 +617,17 @@ void MultiplayerGameScreen::update(Application&, float dtSeconds)
             }
         }
 
+        if (predicting_ && !matchEnded_) {
+            simClock_.accumulateSeconds(dtSeconds);
+            while (simClock_.step()) {
+                predictor_.update(simClock_.lastTickDuration());
+            }
+        }
+
+        if ((lockstep_ || rollback_) && !matchEnded_ && updateLockstep(dtSeconds)) {
+            gotSnapshot = true; // host frames double as liveness
+        }
+
         const bool shouldTimeout = (!matchEnded_);
 
         if (shouldTimeout && !hostDisconnected_) {
@@ -492,36 +663,59 @@ void MultiplayerGameScreen::update(Application&, float dtSeconds)
 
     if (matchEnded_) return;
 
-    const int ms = static_cast<int>(dtSeconds * 1000.0f + 0.5f);
-    auto dur = tetris::controller::GameController::Duration{ms};
+    if (!lockstep_ && !rollback_) {
+        simClock_.accumulateSeconds(dtSeconds);
+    }
 
     if (cfg_.mode == tetris::net::GameMode::TimeAttack) {
-        localCtrl_.update(dur);
-        oppCtrl_.update(dur);
+        if (lockstep_ || rollback_) {
+            updateLockstep(dtSeconds);
+        } else {
+            while (simClock_.step()) {
+                localCtrl_.update(simClock_.lastTickDuration());
+                oppCtrl_.update(simClock_.lastTickDuration());
+                oppSinceInput_ += simClock_.lastTickDuration();
+            }
 
-        if (host_) {
-            auto inputs = host_->consumeInputQueue();
-            for (const auto& m : inputs) {
-                oppCtrl_.handleAction(m.action);
+            if (host_) {
+                auto inputs = host_->consumeInputQueue();
+                for (const auto& m : inputs) {
+                    remoteBatch_.push_back({ m.action, m.clientTick });
+                }
+                // Ack only inputs that took effect, and never go back
+                if (const auto applied = flushRemoteBatch(oppCtrl_)) {
+                    const auto acked = std::max(lastOppInputTick_.value_or(0), *applied);
+                    if (acked != lastOppInputTick_) {
+                        lastOppInputTick_ = acked;
+                        oppSinceInput_ = {};
+                    }
+                }
             }
-        }
 
-        matchElapsedSec_ += dtSeconds;
+            matchElapsedSec_ = static_cast<float>(simClock_.elapsed().count()) / 1000.0f;
+        }
         tryFinalizeMatchHost();
 
     } else {
-        sharedCtrl_.update(dur);
-
-        if (host_) {
-            auto inputs = host_->consumeInputQueue();
-            for (const auto& m : inputs) {
-                if (m.playerId != turnPlayerId_) continue;
-                lastActionPlayerId_ = m.playerId;
-                sharedCtrl_.handleAction(m.action);
+        if (lockstep_) {
+            updateLockstep(dtSeconds);
+        } else {
+            while (simClock_.step()) {
+                sharedCtrl_.update(simClock_.lastTickDuration());
+            }
+
+            if (host_) {
+                auto inputs = host_->consumeInputQueue();
+                for (const auto& m : inputs) {
+                    if (m.playerId != turnPlayerId_) continue;
+                    lastActionPlayerId_ = m.playerId;
+                    remoteBatch_.push_back({ m.action, m.clientTick });
+                }
+                flushRemoteBatch(sharedCtrl_);
             }
-        }
 
-        updateSharedTurnsTurnHost();
+            updateSharedTurnsTurnHost();
+        }
 
         if (sharedGame_.status() == tetris::core::GameStatus::GameOver) {
             matchEnded_ = true;
@@ -563,6 +757,8 @@ void MultiplayerGameScreen::update(Application&, float dtSeconds)
 
     applyHoldInputs(dtSeconds);
 
+    if (lockstep_ || rollback_) return; // peers simulate the boards themselves
+
     snapshotAccSec_ += dtSeconds;
     while (snapshotAccSec_ >= snapshotPeriodSec_) {
         snapshotAccSec_ -= snapshotPeriodSec_;
@@ -631,7 +827,8 @@ void MultiplayerGameScreen::drawBoardDTO(ImDrawList* dl, const tetris::net::Boar
 }
 
 void MultiplayerGameScreen::drawBoardFromGame(ImDrawList* dl, const tetris::core::GameState& gs,
-                                             ImVec2 topLeft, float cell, bool border, bool drawActive) const
+                                             ImVec2 topLeft, float cell, bool border, bool drawActive,
+                                             const tetris::controller::GameController* gravity) const
 {
     const auto& b = gs.board();
     const int rows = b.rows();
@@ -654,11 +851,14 @@ void MultiplayerGameScreen::drawBoardFromGame(ImDrawList* dl, const tetris::core
     }
 
     for (int r = 0; r < rows; ++r) {
+        const auto row = b.row(r);
+        if (row.bits == 0) continue;
+
         for (int c = 0; c < cols; ++c) {
-            if (b.cell(r, c) != tetris::core::CellState::Filled) continue;
+            if (!row.filled(c)) continue;
 
             ImU32 col = locked;
-            if (const auto t = b.cellType(r, c)) {
+            if (const auto t = row.type(c)) {
                 col = colorFromIndex(colorIndexForTetromino(*t));
             }
 
@@ -672,9 +872,17 @@ void MultiplayerGameScreen::drawBoardFromGame(ImDrawList* dl, const tetris::core
     if (drawActive && gs.activeTetromino().has_value()) {
         const auto& t = *gs.activeTetromino();
         ImU32 col = colorFromIndex(colorIndexForTetromino(t.type()));
+
+        // With the game's controller, slide the piece toward the next row
+        // by the gravity time since the last simulated tick (simClock_)
+        float fall = 0.0f;
+        if (gravity && b.dropDistance(t) > 0) {
+            fall = gravity->gravityProgress(simClock_.alpha() * simClock_.lastTickDuration()) * cell;
+        }
+
         for (const auto& blk : t.blocks()) {
             if (blk.row < 0) continue;
-            ImVec2 p0(topLeft.x + blk.col * cell + 1, topLeft.y + blk.row * cell + 1);
+            ImVec2 p0(topLeft.x + blk.col * cell + 1, topLeft.y + blk.row * cell + fall + 1);
             ImVec2 p1(p0.x + cell - 2, p0.y + cell - 2);
             dl->AddRectFilled(p0, p1, col);
             dl->AddRect(p0, p1, IM_COL32(20, 20, 20, 255));
@@ -744,6 +952,12 @@ void MultiplayerGameScreen::renderTopBar(Application& app, int w, int h) const
         ImGui::Text("Time left: %02u:%02u", mm, ss);
     }
 
+    if (const auto desync = desyncTick()) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1, 0.35f, 0.35f, 1), "DESYNC at tick %llu",
+                           static_cast<unsigned long long>(*desync));
+    }
+
     ImGui::SameLine();
     ImGui::SetCursorPosX(ImGui::GetWindowWidth() - 120);
     ImGui::TextUnformatted("Backspace: Menu");
@@ -788,12 +1002,19 @@ void MultiplayerGameScreen::renderTimeAttackLayout(Application& app, int w, int
     dl->AddText(ImVec2(x0, y0 - 22), IM_COL32_WHITE, "You");
     dl->AddText(ImVec2(x0 + boardPxW + margin, y0 - 22), IM_COL32_WHITE, "Opponent");
 
-    if (client_ && snap && snap->players.size() >= 2) {
+    if (client_ && predicting_) {
+        drawBoardFromGame(dl, predictor_.game(), ImVec2(x0, y0), cell, true, true, &predictor_.controller());
+        if (snap && !snap->players.empty()) {
+            drawBoardDTO(dl, snap->players[0].board, ImVec2(x0 + boardPxW + margin, y0), cell, true);
+        }
+    } else if (client_ && snap && snap->players.size() >= 2) {
         drawBoardDTO(dl, snap->players[1].board, ImVec2(x0, y0), cell, true);
         drawBoardDTO(dl, snap->players[0].board, ImVec2(x0 + boardPxW + margin, y0), cell, true);
     } else {
-        drawBoardFromGame(dl, localGame_, ImVec2(x0, y0), cell, true, true);
-        drawBoardFromGame(dl, oppGame_,   ImVec2(x0 + boardPxW + margin, y0), cell, true, true);
+        // Session games are copies; only the host's own games have live controllers
+        const bool ownGravity = !lockstep_ && !rollback_;
+        drawBoardFromGame(dl, localGame_, ImVec2(x0, y0), cell, true, true, ownGravity ? &localCtrl_ : nullptr);
+        drawBoardFromGame(dl, oppGame_,   ImVec2(x0 + boardPxW + margin, y0), cell, true, true, ownGravity ? &oppCtrl_ : nullptr);
     }
 
     float panelX = x0 + boardPxW * 2 + margin * 2;
@@ -806,7 +1027,12 @@ void MultiplayerGameScreen::renderTimeAttackLayout(Application& app, int w, int
     ImGui::Begin("Scoreboard", nullptr, flags);
 
     ImGui::SeparatorText("YOU");
-    if (client_ && snap && snap->players.size() >= 2) {
+    if (client_ && predicting_) {
+        const auto& me = predictor_.game();
+        ImGui::Text("Score: %llu", (unsigned long long)me.score());
+        ImGui::Text("Level: %d", me.level());
+        ImGui::Text("Alive: %s", me.status() != tetris::core::GameStatus::GameOver ? "Yes" : "No");
+    } else if (client_ && snap && snap->players.size() >= 2) {
         ImGui::Text("Score: %d", snap->players[1].score);
         ImGui::Text("Level: %d", snap->players[1].level);
         ImGui::Text("Alive: %s", snap->players[1].isAlive ? "Yes" : "No");
@@ -864,7 +1090,8 @@ void MultiplayerGameScreen::renderSharedTurnsLayout(Application& app, int w, int
     if (client_ && snap && !snap->players.empty()) {
         drawBoardDTO(dl, snap->players[0].board, ImVec2(x0, y0), cell, true);
     } else {
-        drawBoardFromGame(dl, sharedGame_, ImVec2(x0, y0), cell, true, true);
+        drawBoardFromGame(dl, sharedGame_, ImVec2(x0, y0), cell, true, true,
+                          (!lockstep_ && !rollback_) ? &sharedCtrl_ : nullptr);
     }
 
     const int sharedScore = (client_ && snap && !snap->players.empty())
@@ -950,7 +1177,7 @@ void MultiplayerGameScreen::applyHoldInputs(float dtSeconds)
         tetris::net::PlayerId myId = cfg_.isHost ? 1u : (client_ && client_->playerId() ? *client_->playerId() : 0u);
 
         tetris::net::PlayerId currentTurn = 0u;
-        if (cfg_.isHost) {
+        if (cfg_.isHost || lockstep_) {
             currentTurn = turnPlayerId_;
         } else {
             std::lock_guard<std::mutex> lock(stateMutex_);
@@ -1028,11 +1255,26 @@ void MultiplayerGameScreen::tryFinalizeMatchHost()
     if (matchEnded_) return;
     if (cfg_.mode != tetris::net::GameMode::TimeAttack) return;
 
-    const bool hostDead = (localGame_.status() == tetris::core::GameStatus::GameOver);
-    const bool oppDead  = (oppGame_.status()   == tetris::core::GameStatus::GameOver);
+    // The rollback games drawn on screen include remote ticks predicted as
+    // "no input" that a late frame can still undo; the result is final
+    // once sent, so it is decided on the confirmed ticks only.
+    const tetris::core::GameState* hostGame = &localGame_;
+    const tetris::core::GameState* oppGame = &oppGame_;
+    float elapsedSec = matchElapsedSec_;
+    if (rollback_) {
+        const auto selfId = rollback_->localId();
+        const auto& players = rollback_->players();
+        const auto otherId = (players.front() == selfId) ? players.back() : players.front();
+        hostGame = &rollback_->confirmedGame(selfId);
+        oppGame = &rollback_->confirmedGame(otherId);
+        elapsedSec = static_cast<float>(rollback_->confirmedElapsedMs()) / 1000.0f;
+    }
+
+    const bool hostDead = (hostGame->status() == tetris::core::GameStatus::GameOver);
+    const bool oppDead  = (oppGame->status()  == tetris::core::GameStatus::GameOver);
 
     const bool timeLimitEnabled = (cfg_.timeLimitSeconds > 0);
-    const bool timeUp = timeLimitEnabled && (matchElapsedSec_ >= static_cast<float>(cfg_.timeLimitSeconds));
+    const bool timeUp = timeLimitEnabled && (elapsedSec >= static_cast<float>(cfg_.timeLimitSeconds));
 
     if (!timeUp && !hostDead && !oppDead) {
         return;
@@ -1041,8 +1283,8 @@ void MultiplayerGameScreen::tryFinalizeMatchHost()
     matchEnded_ = true;
     ++serverTick_;
 
-    const int hostScore = static_cast<int>(localGame_.score());
-    const int oppScore  = static_cast<int>(oppGame_.score());
+    const int hostScore = static_cast<int>(hostGame->score());
+    const int oppScore  = static_cast<int>(oppGame->score());
 
     tetris::net::MatchOutcome hostOutcome = tetris::net::MatchOutcome::Draw;
     tetris::net::MatchOutcome oppOutcome  = tetris::net::MatchOutcome::Draw;
@@ -1202,18 +1444,27 @@ void MultiplayerGameScreen::renderMatchOverlay(Application& app, int w, int h)
         ImGui::EndDisabled();
 
         if (opponentPresent && hostWantsRematch_ && opponentReady && host_) {
+            // Start the match first so the games use the new match seed
+            host_->clearRematchFlags();
+            host_->startMatch();
+            seedGamesFromHost();
+            if (cfg_.lockstep) {
+                startLockstep(host_->matchSeed(), cfg_.lockstepTickMs, cfg_.inputDelayTicks,
+                              cfg_.rollbackWindowTicks, tetris::net::NetworkHost::HostPlayerId);
+            }
+
             localGame_.reset();  localGame_.start();  localCtrl_.resetTiming();
             oppGame_.reset();    oppGame_.start();    oppCtrl_.resetTiming();
             sharedGame_.reset(); sharedGame_.start(); sharedCtrl_.resetTiming();
+            simClock_.reset();
 
             matchEnded_ = false;
             matchElapsedSec_ = 0.0f;
             localMatchResult_.reset();
             clientMatchResult_.reset();
             hostWantsRematch_ = false;
-
-            host_->clearRematchFlags();
-            host_->startMatch();
+            lastOppInputTick_.reset();
+            oppSinceInput_ = {};
         }
     } else {
         if (waitingRematchStart_) {
@@ -37,21 +37,15 @@ static void unpackImU32(ImU32 col, std::uint8_t& r, std::uint8_t& g, std::uint8_
     a = (col >> IM_COL32_A_SHIFT) & 0xFF;
 }
 
-static tetris::core::Tetromino computeGhost(const tetris::core::Board& board,
+static tetris::core::Tetromino computeGhost(const tetris::core::StandardBoard& board,
                                             const tetris::core::Tetromino& active)
 {
     using tetris::core::Position;
 
     tetris::core::Tetromino ghost = active;
 
-    while (true) {
-        auto prev = ghost.origin();
-        ghost.setOrigin(Position{prev.row + 1, prev.col});
-        if (!board.canPlace(ghost)) {
-            ghost.setOrigin(prev);
-            break;
-        }
-    }
+    const auto origin = ghost.origin();
+    ghost.setOrigin(Position{origin.row + board.dropDistance(active), origin.col});
     return ghost;
 }
 
@@ -61,6 +55,7 @@ SinglePlayerScreen::SinglePlayerScreen()
 {
     gameState_.start();
     controller_.resetTiming();
+    clock_.reset();
 }
 
 void SinglePlayerScreen::dispatchAction(tetris::controller::InputAction action)
@@ -190,8 +185,10 @@ void SinglePlayerScreen::handleEvent(Application& app, const SDL_Event& e)
 
 void SinglePlayerScreen::update(Application&, float dtSeconds)
 {
-    const int ms = static_cast<int>(dtSeconds * 1000.0f + 0.5f);
-    controller_.update(tetris::controller::GameController::Duration{ms});
+    clock_.accumulateSeconds(dtSeconds);
+    while (clock_.step()) {
+        controller_.update(clock_.lastTickDuration());
+    }
 
     if (gameState_.status() != tetris::core::GameStatus::Running) {
         softDropHoldAccumulatorSec_ = 0.0f;
@@ -316,11 +313,14 @@ void SinglePlayerScreen::renderBoard(SDL_Renderer* renderer, int x, int y, int c
 
     SDL_SetRenderDrawColor(renderer, 90, 90, 95, 255);
     for (int r = 0; r < rows; ++r) {
+        const auto row = board.row(r);
+        if (row.bits == 0) continue;
+
         for (int c = 0; c < cols; ++c) {
-            if (board.cell(r, c) != tetris::core::CellState::Filled) continue;
+            if (!row.filled(c)) continue;
 
             // If we know which tetromino filled this cell, color it.
-            const auto t = board.cellType(r, c);
+            const auto t = row.type(c);
             ImU32 col = t ? colorForTetromino(*t) : IM_COL32(90, 90, 95, 255);
 
             std::uint8_t rr, gg, bb, aa;
@@ -346,15 +346,22 @@ void SinglePlayerScreen::renderBoard(SDL_Renderer* renderer, int x, int y, int c
         }
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
-        // Active
+        // Active, slid toward the next row by the gravity time since the
+        // last simulated tick, unless it is resting on the stack
         const ImU32 col = colorForTetromino(t.type());
         std::uint8_t rr, gg, bb, aa;
         unpackImU32(col, rr, gg, bb, aa);
         SDL_SetRenderDrawColor(renderer, rr, gg, bb, aa);
 
+        int fallPx = 0;
+        if (board.dropDistance(t) > 0) {
+            const float progress = controller_.gravityProgress(clock_.alpha() * clock_.lastTickDuration());
+            fallPx = static_cast<int>(progress * static_cast<float>(cellSize));
+        }
+
         for (const auto& b : t.blocks()) {
             if (b.row < 0) continue;
-            SDL_Rect cell{x + b.col * cellSize + 1, y + b.row * cellSize + 1, cellSize - 2, cellSize - 2};
+            SDL_Rect cell{x + b.col * cellSize + 1, y + b.row * cellSize + fallPx + 1, cellSize - 2, cellSize - 2};
             SDL_RenderFillRect(renderer, &cell);
         }
     }
@@ -456,29 +463,24 @@ void SinglePlayerScreen::renderNextPieceWindow(int x, int y, int w, int h) const
         dl->AddLine(ImVec2(a0.x, a0.y + t), ImVec2(a1.x, a0.y + t), IM_COL32(120, 120, 120, 50));
     }
 
-    if (!gameState_.nextTetromino().has_value()) {
+    const auto upcoming = gameState_.preview();
+    if (upcoming.empty()) {
         ImGui::End();
         return;
     }
 
-    const auto& next = *gameState_.nextTetromino();
-    const auto blocks = next.blocks();
-    const ImU32 col = colorForTetromino(next.type());
-
-    int minR = blocks[0].row, maxR = blocks[0].row;
-    int minC = blocks[0].col, maxC = blocks[0].col;
-    for (const auto& b : blocks) {
-        minR = std::min(minR, b.row); maxR = std::max(maxR, b.row);
-        minC = std::min(minC, b.col); maxC = std::max(maxC, b.col);
-    }
+    // Preview is origin-independent: draw the relative offsets, centred on their bounding box
+    const auto nextType = upcoming.front();
+    const auto& shape = tetris::core::shapeInfo(nextType, tetris::core::Rotation::R0);
+    const ImU32 col = colorForTetromino(nextType);
 
     const float cell = side / 4.5f;
-    const float pieceW = (maxC - minC + 1) * cell;
-    const float pieceH = (maxR - minR + 1) * cell;
-    const float ox = a0.x + (side - pieceW) * 0.5f - minC * cell;
-    const float oy = a0.y + (side - pieceH) * 0.5f - minR * cell;
+    const float pieceW = shape.width * cell;
+    const float pieceH = shape.height * cell;
+    const float ox = a0.x + (side - pieceW) * 0.5f - shape.minCol * cell;
+    const float oy = a0.y + (side - pieceH) * 0.5f - shape.minRow * cell;
 
-    for (const auto& b : blocks) {
+    for (const auto& b : shape.blocks) {
         const float bx = ox + b.col * cell;
         const float by = oy + b.row * cell;
         dl->AddRectFilled(ImVec2(bx + 1, by + 1), ImVec2(bx + cell - 2, by + cell - 2), col);
@@ -530,6 +532,7 @@ void SinglePlayerScreen::renderHUD(Application& app, int /*windowW*/, int /*wind
             gameState_.reset();
             gameState_.start();
             controller_.resetTiming();
+            clock_.reset();
         }
     }
 
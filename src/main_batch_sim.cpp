@@ -0,0 +1,186 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+#include "core/BatchSimulator.hpp"
+#include "core/BoardKernels.hpp"
+#include "core/GameState.hpp"
+#include "core/Random.hpp"
+
+using namespace tetris::core;
+using tetris::controller::InputAction;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr InputAction kActions[] = {
+    InputAction::MoveLeft, InputAction::MoveRight, InputAction::RotateCW,
+    InputAction::RotateCCW, InputAction::SoftDrop, InputAction::HardDrop,
+};
+constexpr BatchSimulator::Duration kFrame{16}; // ~60 Hz
+
+struct Result {
+    std::uint64_t games{0};
+    std::uint64_t pieces{0};
+    std::uint64_t steps{0};
+    double seconds{0.0};
+};
+
+// Random input on roughly one frame in four; finished games restart with
+// the next seed.
+InputAction randomAction(Pcg32& rng, bool& act) {
+    act = rng.bounded(4) == 0;
+    return kActions[rng.bounded(6)];
+}
+
+Result runBatch(std::size_t games, int frames) {
+    BatchSimulator batch{games};
+    batch.startAll(1);
+    std::uint64_t nextSeed = games + 1;
+    Pcg32 rng{7};
+
+    Result result;
+    const auto begin = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (std::size_t g = 0; g < games; ++g) {
+            bool act = false;
+            const InputAction action = randomAction(rng, act);
+            if (act) {
+                batch.applyAction(g, action);
+            }
+        }
+        batch.updateAll(kFrame);
+        for (std::size_t g = 0; g < games; ++g) {
+            if (batch.status(g) == GameStatus::GameOver) {
+                ++result.games;
+                result.pieces += batch.lockedPieces(g);
+                batch.start(g, nextSeed++);
+            }
+        }
+        result.steps += games;
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    return result;
+}
+
+// Same workload through one GameState + GameController per game.
+Result runGameStates(std::size_t games, int frames) {
+    std::vector<std::unique_ptr<GameState>> states;
+    std::vector<std::unique_ptr<tetris::controller::GameController>> controllers;
+    std::uint64_t nextSeed = 1;
+    for (std::size_t g = 0; g < games; ++g) {
+        states.push_back(std::make_unique<GameState>());
+        controllers.push_back(std::make_unique<tetris::controller::GameController>(*states.back()));
+        states[g]->setSeed(nextSeed++);
+        states[g]->start();
+    }
+    Pcg32 rng{7};
+
+    Result result;
+    const auto begin = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (std::size_t g = 0; g < games; ++g) {
+            bool act = false;
+            const InputAction action = randomAction(rng, act);
+            if (act) {
+                controllers[g]->handleAction(action);
+            }
+        }
+        for (std::size_t g = 0; g < games; ++g) {
+            controllers[g]->update(kFrame);
+        }
+        for (std::size_t g = 0; g < games; ++g) {
+            if (states[g]->status() == GameStatus::GameOver) {
+                ++result.games;
+                result.pieces += states[g]->lockedPieces();
+                states[g]->reset();
+                states[g]->setSeed(nextSeed++);
+                states[g]->start();
+                controllers[g]->resetTiming();
+            }
+        }
+        result.steps += games;
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    return result;
+}
+
+// Board kernels over the boards of a batch after `frames` frames of play.
+void benchKernels(std::size_t games, int frames) {
+    BatchSimulator batch{games};
+    batch.startAll(1);
+    Pcg32 rng{7};
+    for (int frame = 0; frame < frames; ++frame) {
+        for (std::size_t g = 0; g < games; ++g) {
+            bool act = false;
+            const InputAction action = randomAction(rng, act);
+            if (act) {
+                batch.applyAction(g, action);
+            }
+        }
+        batch.updateAll(kFrame);
+    }
+
+    std::vector<std::uint32_t> full(games);
+    std::vector<std::uint8_t> hits(games);
+    std::vector<std::uint8_t> heights(games * BatchSimulator::Cols);
+    const Tetromino piece{TetrominoType::T, Rotation::R0, Position{10, 4}};
+    constexpr int kRepeats = 200;
+
+    const char* names[] = {"scalar", "sse2", "avx2"};
+    for (KernelIsa isa : {KernelIsa::Scalar, KernelIsa::SSE2, KernelIsa::AVX2}) {
+        if (!kernelIsaAvailable(isa)) {
+            continue;
+        }
+        const auto begin = Clock::now();
+        for (int i = 0; i < kRepeats; ++i) {
+            batchFullRows(batch.rowData(), games, full.data(), isa);
+            batchCollisions(batch.rowData(), games, piece, hits.data(), isa);
+            batchColumnHeights(batch.rowData(), games, heights.data(), isa);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        std::cout << "Kernels (" << names[static_cast<int>(isa)] << "): "
+                  << static_cast<double>(games) * kRepeats / seconds
+                  << " boards/s for full rows + collision + column heights\n";
+    }
+}
+
+void report(const char* label, const Result& r) {
+    std::cout << label << ": " << r.games << " games, " << r.pieces << " pieces in "
+              << r.seconds << " s -> " << static_cast<double>(r.games) / r.seconds << " games/s, "
+              << static_cast<double>(r.steps) / r.seconds << " game-steps/s\n";
+}
+
+} // namespace
+
+// Usage: tetris_batch_sim [games] [frames]
+int main(int argc, char** argv) {
+    const std::size_t games = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (games == 0 || frames <= 0) {
+        std::cerr << "Usage: tetris_batch_sim [games > 0] [frames > 0]\n";
+        return 1;
+    }
+
+    std::cout << "Simulating " << games << " games for " << frames << " frames of "
+              << kFrame.count() << " ms\n";
+    const Result batch = runBatch(games, frames);
+    report("BatchSimulator", batch);
+    const Result single = runGameStates(games, frames);
+    report("GameState     ", single);
+
+    benchKernels(games, frames / 4);
+
+    // Identical rules and inputs: both runs must finish the same games
+    if (batch.games != single.games || batch.pieces != single.pieces) {
+        std::cerr << "Mismatch between BatchSimulator and GameState runs\n";
+        return 1;
+    }
+    return 0;
+}
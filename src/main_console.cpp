@@ -12,7 +12,7 @@ using namespace tetris::core;
 
 // Helper: render the current board + active tetromino as ASCII
 void printGame(const GameState& game) {
-    const Board& board = game.board();
+    const StandardBoard& board = game.board();
     const int rows = board.rows();
     const int cols = board.cols();
 
@@ -20,12 +20,9 @@ void printGame(const GameState& game) {
     std::vector<std::string> lines(rows, std::string(cols, ' '));
 
     for (int r = 0; r < rows; ++r) {
+        const auto row = board.row(r);
         for (int c = 0; c < cols; ++c) {
-            if (board.cell(r, c) == CellState::Filled) {
-                lines[r][c] = '#'; // locked blocks
-            } else {
-                lines[r][c] = '.'; // empty
-            }
+            lines[r][c] = row.filled(c) ? '#' : '.'; // locked blocks / empty
         }
     }
 
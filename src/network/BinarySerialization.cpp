@@ -0,0 +1,597 @@
+#include "network/BinarySerialization.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace tetris::net {
+namespace {
+    using Bytes = std::vector<std::uint8_t>;
+
+    // Largest varint header for a frame up to MaxBinaryFrameBytes
+    constexpr std::size_t kMaxSizeVarintBytes = 3;
+    static_assert(MaxBinaryFrameBytes < (1u << (7 * kMaxSizeVarintBytes)));
+
+    static_assert(static_cast<std::size_t>(MessageKind::LockstepHash) + 1 == std::variant_size_v<MessagePayload>,
+                  "every MessageKind needs a binary encoding");
+
+    class Writer {
+    public:
+        explicit Writer(Bytes& out) : m_out(out) {}
+
+        void u8(std::uint8_t v) { m_out.push_back(v); }
+        void flag(bool v) { u8(v ? 1 : 0); }
+
+        void varint(std::uint64_t v)
+        {
+            while (v >= 0x80) {
+                m_out.push_back(static_cast<std::uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+            m_out.push_back(static_cast<std::uint8_t>(v));
+        }
+
+        void svarint(std::int64_t v)
+        {
+            varint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+        }
+
+        void fixed64(std::uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i) {
+                m_out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+            }
+        }
+
+        void str(const std::string& s)
+        {
+            varint(s.size());
+            m_out.insert(m_out.end(), s.begin(), s.end());
+        }
+
+        void bytes(const Bytes& b)
+        {
+            varint(b.size());
+            m_out.insert(m_out.end(), b.begin(), b.end());
+        }
+
+    private:
+        Bytes& m_out;
+    };
+
+    // Reads fields until the first error; after that every read returns 0
+    // and ok() stays false, so callers check once at the end.
+    class Reader {
+    public:
+        Reader(const std::uint8_t* data, std::size_t size) : m_pos(data), m_end(data + size) {}
+
+        bool ok() const { return m_ok; }
+        bool atEnd() const { return m_pos == m_end; }
+        std::size_t remaining() const { return static_cast<std::size_t>(m_end - m_pos); }
+
+        std::uint8_t u8()
+        {
+            if (!m_ok || m_pos == m_end) return fail();
+            return *m_pos++;
+        }
+
+        bool flag() { return u8() != 0; }
+
+        std::uint64_t varint()
+        {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const std::uint8_t b = u8();
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return m_ok ? v : 0;
+            }
+            return fail(); // more than 10 bytes
+        }
+
+        std::int64_t svarint()
+        {
+            const std::uint64_t v = varint();
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+
+        std::uint32_t u32()
+        {
+            const std::uint64_t v = varint();
+            if (v > std::numeric_limits<std::uint32_t>::max()) return static_cast<std::uint32_t>(fail());
+            return static_cast<std::uint32_t>(v);
+        }
+
+        int i32()
+        {
+            const std::int64_t v = svarint();
+            if (v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max()) {
+                return static_cast<int>(fail());
+            }
+            return static_cast<int>(v);
+        }
+
+        std::uint64_t fixed64()
+        {
+            std::uint64_t v = 0;
+            for (int i = 0; i < 8; ++i) {
+                v |= static_cast<std::uint64_t>(u8()) << (8 * i);
+            }
+            return v;
+        }
+
+        // Item count of a list whose items take at least `minItemBytes`
+        // each, checked against what is left before anyone sizes a
+        // container by it
+        std::size_t count(std::size_t minItemBytes = 1)
+        {
+            const std::uint64_t n = varint();
+            if (n > remaining() / minItemBytes) return fail();
+            return static_cast<std::size_t>(n);
+        }
+
+        std::string str()
+        {
+            const std::size_t n = count();
+            std::string s(reinterpret_cast<const char*>(m_pos), n);
+            m_pos += n;
+            return s;
+        }
+
+        Bytes bytes()
+        {
+            const std::size_t n = count();
+            Bytes b(m_pos, m_pos + n);
+            m_pos += n;
+            return b;
+        }
+
+        // Next `n` raw bytes, or nullptr if there are not that many
+        const std::uint8_t* take(std::size_t n)
+        {
+            if (!m_ok || n > remaining()) {
+                fail();
+                return nullptr;
+            }
+            const std::uint8_t* p = m_pos;
+            m_pos += n;
+            return p;
+        }
+
+        // Marks the data as malformed
+        std::uint8_t fail()
+        {
+            m_ok = false;
+            m_pos = m_end;
+            return 0;
+        }
+
+    private:
+        const std::uint8_t* m_pos;
+        const std::uint8_t* m_end;
+        bool m_ok{true};
+    };
+
+    // StateUpdateMapper's colours; boards that only use them skip the
+    // colour block.
+    int defaultColor(bool occupied) { return occupied ? 0 : -1; }
+
+    // How a board's colours follow its occupancy bits
+    enum class ColorMode : std::uint8_t {
+        Default = 0, // defaultColor() everywhere, nothing follows
+        Nibbles = 1, // empty cells' shared colour, then 4 bits per occupied cell
+        PerCell = 2  // one zigzag varint per cell
+    };
+    constexpr int kMaxNibbleColor = 15;
+
+    // Smallest encoded PlayerStateDTO: one byte per field, two for an
+    // empty board (see putPlayer)
+    constexpr std::size_t kMinPlayerBytes = 10;
+
+    void putBoard(Writer& w, const BoardDTO& board)
+    {
+        const auto width = static_cast<std::size_t>(std::max(0, board.width));
+        const auto height = static_cast<std::size_t>(std::max(0, board.height));
+        const std::size_t cells = width * height;
+        if (cells == 0 || board.cells.size() < cells) {
+            // Empty, or a DTO missing cells: sent as an empty board
+            w.varint(0);
+            w.varint(0);
+            return;
+        }
+        w.varint(width);
+        w.varint(height);
+
+        bool defaultColors = true;
+        bool nibbles = true;
+        std::optional<int> emptyColor;
+        std::uint8_t bits = 0;
+        for (std::size_t i = 0; i < cells; ++i) {
+            const auto& cell = board.cells[i];
+            bits |= static_cast<std::uint8_t>((cell.occupied ? 1u : 0u) << (i % 8));
+            if (i % 8 == 7 || i + 1 == cells) {
+                w.u8(bits);
+                bits = 0;
+            }
+            defaultColors = defaultColors && cell.colorIndex == defaultColor(cell.occupied);
+            if (cell.occupied) {
+                nibbles = nibbles && cell.colorIndex >= 0 && cell.colorIndex <= kMaxNibbleColor;
+            } else if (!emptyColor) {
+                emptyColor = cell.colorIndex;
+            } else {
+                nibbles = nibbles && cell.colorIndex == *emptyColor;
+            }
+        }
+
+        if (defaultColors) {
+            w.u8(static_cast<std::uint8_t>(ColorMode::Default));
+        } else if (nibbles) {
+            w.u8(static_cast<std::uint8_t>(ColorMode::Nibbles));
+            w.svarint(emptyColor.value_or(defaultColor(false)));
+            std::uint8_t packed = 0;
+            bool high = false;
+            for (std::size_t i = 0; i < cells; ++i) {
+                if (!board.cells[i].occupied) continue;
+                packed |= static_cast<std::uint8_t>(board.cells[i].colorIndex << (high ? 4 : 0));
+                if (high) {
+                    w.u8(packed);
+                    packed = 0;
+                }
+                high = !high;
+            }
+            if (high) w.u8(packed);
+        } else {
+            w.u8(static_cast<std::uint8_t>(ColorMode::PerCell));
+            for (std::size_t i = 0; i < cells; ++i) {
+                w.svarint(board.cells[i].colorIndex);
+            }
+        }
+    }
+
+    void getBoard(Reader& r, BoardDTO& board)
+    {
+        const std::uint64_t width = r.varint();
+        const std::uint64_t height = r.varint();
+        if (width > MaxBinaryFrameBytes || height > MaxBinaryFrameBytes
+            || (width * height + 7) / 8 > r.remaining()) {
+            r.fail();
+            return;
+        }
+
+        const auto cells = static_cast<std::size_t>(width * height);
+        board.width = static_cast<int>(width);
+        board.height = static_cast<int>(height);
+        board.cells.assign(cells, BoardCellDTO{});
+        if (cells == 0) {
+            return;
+        }
+
+        const std::uint8_t* bits = r.take((cells + 7) / 8);
+        if (!bits) return;
+        std::size_t occupied = 0;
+        for (std::size_t i = 0; i < cells; ++i) {
+            board.cells[i].occupied = (bits[i / 8] >> (i % 8)) & 1u;
+            occupied += board.cells[i].occupied;
+        }
+
+        switch (static_cast<ColorMode>(r.u8())) {
+        case ColorMode::Default:
+            for (auto& cell : board.cells) {
+                cell.colorIndex = defaultColor(cell.occupied);
+            }
+            break;
+        case ColorMode::Nibbles: {
+            const int emptyColor = r.i32();
+            const std::uint8_t* packed = r.take((occupied + 1) / 2);
+            if (!packed) return;
+            std::size_t n = 0;
+            for (auto& cell : board.cells) {
+                if (!cell.occupied) {
+                    cell.colorIndex = emptyColor;
+                    continue;
+                }
+                cell.colorIndex = (packed[n / 2] >> (n % 2 == 0 ? 0 : 4)) & 0x0F;
+                ++n;
+            }
+            break;
+        }
+        case ColorMode::PerCell:
+            for (auto& cell : board.cells) {
+                cell.colorIndex = r.i32();
+            }
+            break;
+        default:
+            r.fail();
+            break;
+        }
+    }
+
+    void putPlayer(Writer& w, const PlayerStateDTO& p)
+    {
+        w.varint(p.id);
+        w.str(p.name);
+        w.svarint(p.score);
+        w.svarint(p.level);
+        w.flag(p.isAlive);
+        putBoard(w, p.board);
+        w.flag(p.lastInputTick.has_value());
+        if (p.lastInputTick) w.varint(*p.lastInputTick);
+        w.bytes(p.gameSnapshot);
+        w.flag(p.snapshotTiming.has_value());
+        if (p.snapshotTiming) {
+            w.varint(p.snapshotTiming->sinceInputMs);
+            w.varint(p.snapshotTiming->gravityMs);
+        }
+    }
+
+    void getPlayer(Reader& r, PlayerStateDTO& p)
+    {
+        p.id = r.u32();
+        p.name = r.str();
+        p.score = r.i32();
+        p.level = r.i32();
+        p.isAlive = r.flag();
+        getBoard(r, p.board);
+        if (r.flag()) p.lastInputTick = r.varint();
+        p.gameSnapshot = r.bytes();
+        if (r.flag()) {
+            SnapshotTimingDTO timing;
+            timing.sinceInputMs = r.u32();
+            timing.gravityMs = r.u32();
+            p.snapshotTiming = timing;
+        }
+    }
+
+    void putBody(Writer& w, const Message& msg)
+    {
+        w.u8(static_cast<std::uint8_t>(msg.kind));
+
+        switch (msg.kind) {
+        case MessageKind::JoinRequest: {
+            w.str(std::get<JoinRequest>(msg.payload).playerName);
+            break;
+        }
+        case MessageKind::JoinAccept: {
+            const auto& m = std::get<JoinAccept>(msg.payload);
+            w.varint(m.assignedId);
+            w.str(m.welcomeMessage);
+            break;
+        }
+        case MessageKind::StartGame: {
+            const auto& m = std::get<StartGame>(msg.payload);
+            w.u8(static_cast<std::uint8_t>(m.mode));
+            w.varint(m.timeLimitSeconds);
+            w.varint(m.piecesPerTurn);
+            w.varint(m.startTick);
+            w.flag(m.pieceSeed.has_value());
+            if (m.pieceSeed) w.fixed64(*m.pieceSeed); // random: a varint would grow it
+            w.varint(m.lockstepTickMs);
+            w.varint(m.inputDelayTicks);
+            w.varint(m.rollbackWindowTicks);
+            break;
+        }
+        case MessageKind::InputActionMessage: {
+            const auto& m = std::get<InputActionMessage>(msg.payload);
+            w.varint(m.playerId);
+            w.varint(m.clientTick);
+            w.u8(static_cast<std::uint8_t>(m.action));
+            break;
+        }
+        case MessageKind::StateUpdate: {
+            const auto& m = std::get<StateUpdate>(msg.payload);
+            w.varint(m.serverTick);
+            w.varint(m.timeLeftMs);
+            w.varint(m.turnPlayerId);
+            w.varint(m.piecesLeftThisTurn);
+            w.varint(m.players.size());
+            for (const auto& p : m.players) {
+                putPlayer(w, p);
+            }
+            break;
+        }
+        case MessageKind::MatchResult: {
+            const auto& m = std::get<MatchResult>(msg.payload);
+            w.varint(m.endTick);
+            w.varint(m.playerId);
+            w.u8(static_cast<std::uint8_t>(m.outcome));
+            w.svarint(m.finalScore);
+            break;
+        }
+        case MessageKind::PlayerLeft: {
+            const auto& m = std::get<PlayerLeft>(msg.payload);
+            w.varint(m.playerId);
+            w.flag(m.wasHost);
+            w.str(m.reason);
+            break;
+        }
+        case MessageKind::Error: {
+            w.str(std::get<ErrorMessage>(msg.payload).description);
+            break;
+        }
+        case MessageKind::RematchDecision: {
+            w.flag(std::get<RematchDecision>(msg.payload).wantsRematch);
+            break;
+        }
+        case MessageKind::KeepAlive: {
+            break;
+        }
+        case MessageKind::LockstepInputs: {
+            const auto& m = std::get<LockstepInputs>(msg.payload);
+            w.varint(m.playerId);
+            w.varint(m.tick);
+            w.varint(m.actions.size());
+            for (auto action : m.actions) {
+                w.u8(static_cast<std::uint8_t>(action));
+            }
+            break;
+        }
+        case MessageKind::LockstepHash: {
+            const auto& m = std::get<LockstepHash>(msg.payload);
+            w.varint(m.playerId);
+            w.varint(m.tick);
+            w.fixed64(m.hash);
+            break;
+        }
+        }
+    }
+
+    std::optional<MessagePayload> getPayload(Reader& r, MessageKind kind)
+    {
+        switch (kind) {
+        case MessageKind::JoinRequest:
+            return JoinRequest{ r.str() };
+        case MessageKind::JoinAccept: {
+            JoinAccept m{};
+            m.assignedId = r.u32();
+            m.welcomeMessage = r.str();
+            return m;
+        }
+        case MessageKind::StartGame: {
+            StartGame m{};
+            m.mode = static_cast<GameMode>(r.u8());
+            m.timeLimitSeconds = r.u32();
+            m.piecesPerTurn = r.u32();
+            m.startTick = r.varint();
+            if (r.flag()) m.pieceSeed = r.fixed64();
+            m.lockstepTickMs = r.u32();
+            m.inputDelayTicks = r.u32();
+            m.rollbackWindowTicks = r.u32();
+            return m;
+        }
+        case MessageKind::InputActionMessage: {
+            InputActionMessage m{};
+            m.playerId = r.u32();
+            m.clientTick = r.varint();
+            m.action = static_cast<tetris::controller::InputAction>(r.u8());
+            return m;
+        }
+        case MessageKind::StateUpdate: {
+            StateUpdate m;
+            m.serverTick = r.varint();
+            m.timeLeftMs = r.u32();
+            m.turnPlayerId = r.u32();
+            m.piecesLeftThisTurn = r.u32();
+            m.players.resize(r.count(kMinPlayerBytes));
+            for (auto& p : m.players) {
+                getPlayer(r, p);
+            }
+            return m;
+        }
+        case MessageKind::MatchResult: {
+            MatchResult m;
+            m.endTick = r.varint();
+            m.playerId = r.u32();
+            m.outcome = static_cast<MatchOutcome>(r.u8());
+            m.finalScore = r.i32();
+            return m;
+        }
+        case MessageKind::PlayerLeft: {
+            PlayerLeft m;
+            m.playerId = r.u32();
+            m.wasHost = r.flag();
+            m.reason = r.str();
+            return m;
+        }
+        case MessageKind::Error:
+            return ErrorMessage{ r.str() };
+        case MessageKind::RematchDecision:
+            return RematchDecision{ r.flag() };
+        case MessageKind::KeepAlive:
+            return KeepAlive{};
+        case MessageKind::LockstepInputs: {
+            LockstepInputs m;
+            m.playerId = r.u32();
+            m.tick = r.varint();
+            m.actions.resize(r.count(1)); // one byte per action
+            for (auto& action : m.actions) {
+                action = static_cast<tetris::controller::InputAction>(r.u8());
+            }
+            return m;
+        }
+        case MessageKind::LockstepHash: {
+            LockstepHash m;
+            m.playerId = r.u32();
+            m.tick = r.varint();
+            m.hash = r.fixed64();
+            return m;
+        }
+        }
+        return std::nullopt;
+    }
+}
+
+void encodeBinary(const Message& msg, std::vector<std::uint8_t>& out)
+{
+    // The body is built first since its size leads the frame; the scratch
+    // buffer keeps its storage between calls.
+    thread_local Bytes body;
+    body.clear();
+    Writer bodyWriter(body);
+    putBody(bodyWriter, msg);
+
+    if (body.size() > MaxBinaryFrameBytes) {
+        throw std::length_error("encodeBinary: message too large");
+    }
+
+    Writer w(out);
+    w.u8(BinaryFrameMarker);
+    w.u8(BinaryWireVersion);
+    w.varint(body.size());
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+std::size_t binaryFrameSize(tetris::core::Span<const std::uint8_t> data)
+{
+    if (data.size() >= 1 && data[0] != BinaryFrameMarker) {
+        throw std::invalid_argument("binaryFrameSize: not a binary frame");
+    }
+    if (data.size() >= 2 && data[1] != BinaryWireVersion) {
+        throw std::invalid_argument("binaryFrameSize: unsupported wire version");
+    }
+
+    std::size_t bodySize = 0;
+    for (std::size_t i = 0; i < kMaxSizeVarintBytes; ++i) {
+        if (2 + i >= data.size()) {
+            return 0;
+        }
+        const std::uint8_t b = data[2 + i];
+        bodySize |= static_cast<std::size_t>(b & 0x7F) << (7 * i);
+        if (!(b & 0x80)) {
+            if (bodySize > MaxBinaryFrameBytes) {
+                break;
+            }
+            const std::size_t total = 2 + i + 1 + bodySize;
+            return data.size() >= total ? total : 0;
+        }
+    }
+    throw std::invalid_argument("binaryFrameSize: frame too large");
+}
+
+std::optional<Message> decodeBinary(tetris::core::Span<const std::uint8_t> frame)
+{
+    Reader header(frame.data(), frame.size());
+    if (header.u8() != BinaryFrameMarker || header.u8() != BinaryWireVersion) {
+        return std::nullopt;
+    }
+    const std::uint64_t bodySize = header.varint();
+    if (!header.ok() || bodySize != header.remaining()) {
+        return std::nullopt;
+    }
+
+    Reader r(frame.data() + (frame.size() - bodySize), static_cast<std::size_t>(bodySize));
+    const std::uint8_t kind = r.u8();
+    if (!r.ok() || kind >= std::variant_size_v<MessagePayload>) {
+        return std::nullopt;
+    }
+
+    Message msg{};
+    msg.kind = static_cast<MessageKind>(kind);
+    auto payload = getPayload(r, msg.kind);
+    if (!payload || !r.ok() || !r.atEnd()) {
+        return std::nullopt;
+    }
+    msg.payload = std::move(*payload);
+    return msg;
+}
+
+} // namespace tetris::net
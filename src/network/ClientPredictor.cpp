@@ -0,0 +1,93 @@
+#include "network/ClientPredictor.hpp"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace tetris::net {
+
+ClientPredictor::ClientPredictor()
+    : m_controller(m_game)
+{
+}
+
+void ClientPredictor::reset(std::uint64_t seed)
+{
+    m_game.reset();
+    m_game.setSeed(seed);
+    m_game.start();
+    m_controller.resetTiming();
+    m_pending.clear();
+    m_time = Duration{0};
+    m_ackedAt = Duration{0};
+    m_corrections = 0;
+}
+
+void ClientPredictor::applyLocal(InputAction action, Tick clientTick)
+{
+    m_pending.push_back(PendingInput{ clientTick, action, m_time });
+    m_controller.handleAction(action);
+}
+
+void ClientPredictor::update(Duration elapsed)
+{
+    m_time += elapsed;
+    m_controller.update(elapsed);
+}
+
+bool ClientPredictor::reconcile(tetris::core::Span<const std::uint8_t> snapshot,
+                                std::optional<Tick> ackedTick,
+                                const std::optional<SnapshotTimingDTO>& timing)
+{
+    using Buffer = std::array<std::uint8_t, GameState::MaxSnapshotBytes>;
+
+    Buffer predicted{};
+    const std::size_t predictedSize =
+        m_game.saveSnapshot(tetris::core::Span<std::uint8_t>{predicted.data(), predicted.size()});
+
+    try {
+        m_game.loadSnapshot(snapshot);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+
+    if (ackedTick) {
+        while (!m_pending.empty() && m_pending.front().clientTick <= *ackedTick) {
+            m_ackedAt = m_pending.front().appliedAt;
+            m_pending.pop_front();
+        }
+    }
+
+    if (!timing) {
+        for (const auto& input : m_pending) {
+            m_controller.handleAction(input.action);
+        }
+    } else {
+        // Where the snapshot falls on the local timeline. An input applied
+        // before that point that the host had not seen yet (latency jitter)
+        // is replayed without gravity ahead of it.
+        m_controller.restoreTiming(Duration{ timing->gravityMs });
+        Duration cursor = m_ackedAt + Duration{ timing->sinceInputMs };
+        for (const auto& input : m_pending) {
+            if (input.appliedAt > cursor) {
+                m_controller.update(input.appliedAt - cursor);
+                cursor = input.appliedAt;
+            }
+            m_controller.handleAction(input.action);
+        }
+        if (m_time > cursor) {
+            m_controller.update(m_time - cursor);
+        }
+    }
+
+    Buffer replayed{};
+    const std::size_t replayedSize =
+        m_game.saveSnapshot(tetris::core::Span<std::uint8_t>{replayed.data(), replayed.size()});
+    if (replayedSize != predictedSize
+        || std::memcmp(predicted.data(), replayed.data(), replayedSize) != 0) {
+        ++m_corrections;
+    }
+    return true;
+}
+
+} // namespace tetris::net
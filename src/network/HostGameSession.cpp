@@ -81,6 +81,11 @@ std::vector<InputActionMessage> HostGameSession::consumePendingInputs()
     return m_host.consumeInputQueue();
 }
 
+void HostGameSession::consumePendingInputs(std::vector<InputActionMessage>& out)
+{
+    m_host.consumeInputQueue(out);
+}
+
 bool HostGameSession::isInputAllowed(PlayerId playerId) const
 {
     // If match hasn't started or is already finished, we ignore inputs.
@@ -109,6 +114,11 @@ bool HostGameSession::isInputAllowed(PlayerId playerId) const
     return sharedRules->currentPlayer() == playerId;
 }
 
+GameMode HostGameSession::mode() const
+{
+    return m_rules ? m_rules->mode() : m_config.mode;
+}
+
 void HostGameSession::broadcastStateUpdate(const StateUpdate& update)
 {
     Message msg;
@@ -118,5 +128,10 @@ void HostGameSession::broadcastStateUpdate(const StateUpdate& update)
     m_host.broadcast(msg);
 }
 
+void HostGameSession::broadcast(const Message& msg)
+{
+    m_host.broadcast(msg);
+}
+
 
 } // namespace tetris::net
@@ -24,39 +24,95 @@ HostLoop::HostLoop(HostGameSession& session,
                && "HostLoop: missing GameController for some GameState");
     }
 
-    // Initialize last-locked-piece counters from current GameStates.
-    // This assumes GameState exposes lockedPieces().
+    // Events from before the loop existed are not ours to report.
     for (const auto& [pid, gsPtr] : m_gameStates) {
         if (gsPtr) {
-            m_lastLockedPieces[pid] = gsPtr->lockedPieces();
+            m_eventCursor[pid] = EventCursor{ gsPtr->events().head(), gsPtr->lockedPieces() };
         }
+        m_sinceInput[pid] = Duration{0};
     }
+
+    m_stateMessage.kind = MessageKind::StateUpdate;
+    m_stateMessage.payload = StateUpdate{};
+}
+
+void HostLoop::setBots(const BotMap& bots, std::chrono::microseconds thinkBudget)
+{
+    m_bots.assign(bots.begin(), bots.end());
+    std::sort(m_bots.begin(), m_bots.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    m_botBudget = thinkBudget;
+    m_nextBot = 0;
 }
 
 std::vector<MatchResult>
 HostLoop::step(Duration elapsed, Tick currentTick)
 {
     // 1) Consume input messages coming from NetworkHost via HostGameSession
-    auto inputMessages = m_session.consumePendingInputs();
+    m_session.consumePendingInputs(m_inputMessages);
 
-    for (const auto& msg : inputMessages) {
+    // Messages from different players touch different games, so each
+    // player's inputs are applied as one batch, in arrival order.
+    // Unknown player ids (e.g. a late message for a disconnected player)
+    // have no controller and are ignored.
+    for (auto& [pid, controller] : m_controllers) {
         // For SharedTurns, only the current player is allowed to control
         // the shared board. For other modes, all inputs are accepted.
-        if (!m_session.isInputAllowed(msg.playerId)) {
+        if (!controller || !m_session.isInputAllowed(pid)) {
             continue;
         }
-        
-        auto it = m_controllers.find(msg.playerId);
-        if (it == m_controllers.end()) {
-            // Unknown player id (might be a late message for a disconnected player).
-            // Best practice: ignore safely instead of crashing.
+
+        m_actionBatch.clear();
+        for (const auto& msg : m_inputMessages) {
+            if (msg.playerId == pid) {
+                m_actionBatch.push_back({ msg.action, msg.clientTick });
+            }
+        }
+        if (m_actionBatch.empty()) {
             continue;
         }
 
-        auto* controller = it->second;
-        if (controller) {
-            controller->handleAction(msg.action);
+        if (m_acceptedCapacity < m_actionBatch.size()) {
+            m_acceptedCapacity = std::max(m_actionBatch.size(), m_acceptedCapacity * 2);
+            m_accepted = std::make_unique<bool[]>(m_acceptedCapacity);
+        }
+        const std::size_t applied = controller->handleActions(
+            tetris::core::Span<const tetris::controller::TimedInputAction>{ m_actionBatch.data(), m_actionBatch.size() },
+            tetris::core::Span<bool>{ m_accepted.get(), m_actionBatch.size() });
+        if (applied == 0) {
+            continue;
+        }
+
+        // Ack the newest input that took effect; the ack never goes back
+        Tick newest = 0;
+        for (std::size_t k = 0; k < m_actionBatch.size(); ++k) {
+            if (m_accepted[k]) {
+                newest = std::max(newest, static_cast<Tick>(m_actionBatch[k].timestamp));
+            }
+        }
+        auto [it, first] = m_lastInputTick.try_emplace(pid, newest);
+        if (first || newest > it->second) {
+            it->second = newest;
+            m_sinceInput[pid] = Duration{0};
+        }
+    }
+
+    // 1b) Bots decide and play through the same controllers, all of them
+    //     against one deadline
+    if (!m_bots.empty()) {
+        using BotClock = tetris::controller::BotPlayer::Clock;
+        const auto deadline = BotClock::now() + m_botBudget;
+        for (std::size_t n = 0; n < m_bots.size(); ++n) {
+            auto& [pid, bot] = m_bots[(m_nextBot + n) % m_bots.size()];
+            auto gsIt = m_gameStates.find(pid);
+            auto ctrlIt = m_controllers.find(pid);
+            if (!bot || gsIt == m_gameStates.end() || ctrlIt == m_controllers.end()
+                || !gsIt->second || !ctrlIt->second) {
+                continue;
+            }
+            bot->update(*gsIt->second, *ctrlIt->second, elapsed, deadline);
         }
+        m_nextBot = (m_nextBot + 1) % m_bots.size();
     }
 
     // 2) Tick all controllers with elapsed time (gravity, auto-drop, etc.)
@@ -66,10 +122,13 @@ HostLoop::step(Duration elapsed, Tick currentTick)
             controller->update(elapsed);
         }
     }
+    for (auto& [pid, since] : m_sinceInput) {
+        (void)pid;
+        since += elapsed;
+    }
 
     // 3) Build PlayerSnapshot list from authoritative GameStates
-    std::vector<tetris::core::PlayerSnapshot> snapshots;
-    snapshots.reserve(m_gameStates.size());
+    m_snapshots.clear();
 
     for (const auto& [pid, gsPtr] : m_gameStates) {
         if (!gsPtr) {
@@ -80,15 +139,16 @@ HostLoop::step(Duration elapsed, Tick currentTick)
         snap.id      = pid;
         snap.score   = static_cast<int>(gsPtr->score());
         snap.isAlive = (gsPtr->status() != tetris::core::GameStatus::GameOver);
-        snapshots.push_back(snap);
+        m_snapshots.push_back(snap);
     }
 
-    // 4) Detect newly locked pieces and notify rules via HostGameSession.
+    // 4) Report pieces locked this step to the rules via HostGameSession.
     //    SharedTurnRules uses this to rotate turns; TimeAttackRules ignores it.
-    handlePieceLocks(snapshots);
+    handlePieceLocks(m_snapshots);
 
-    // 5) Let HostGameSession (rules + network) advance the match
-    auto results = m_session.update(currentTick, snapshots);
+    // 5) Let HostGameSession (rules + network) advance the match.
+    //    Rules return an empty vector (no allocation) while it runs.
+    auto results = m_session.update(currentTick, m_snapshots);
 
     // 6) Build and broadcast a StateUpdate so all clients can redraw.
     //    We don't want to send at every physics step; instead, we
@@ -107,35 +167,49 @@ HostLoop::step(Duration elapsed, Tick currentTick)
 
 void HostLoop::handlePieceLocks(const std::vector<tetris::core::PlayerSnapshot>& snapshots)
 {
-    // For each player/game, compare current lockedPieces() to last known value.
-    // If it increased, treat that as "one or more pieces have locked since last step".
-    // We call onPieceLocked() once per step per player, even if multiple pieces locked.
-    // That’s sufficient for SharedTurns, where rotation is piece-count-based.
+    // One onPieceLocked() per lock, so SharedTurns counts every piece even
+    // when several lock in the same step (e.g. two queued hard drops).
     for (const auto& [pid, gsPtr] : m_gameStates) {
         if (!gsPtr) {
             continue;
         }
 
-        const auto currentCount = gsPtr->lockedPieces();
-        auto& lastCount = m_lastLockedPieces[pid]; // default-initializes to 0 if missing
+        auto& cursor = m_eventCursor[pid]; // default-initializes to 0 if missing
+        const auto& events = gsPtr->events();
 
-        if (currentCount > lastCount) {
-            // Notify the rules that a piece has locked for this player.
-            // We give the current snapshots so rules can base decisions on up-to-date info.
-            m_session.onPieceLocked(pid, snapshots);
+        // Locks that fell out of the log before this read are reported
+        // first, from the difference in lockedPieces().
+        if (cursor.next < events.oldest()) {
+            std::uint64_t held = 0;
+            events.forEachSince(cursor.next, [&](const tetris::core::GameEvent& event) {
+                held += event.kind == tetris::core::GameEventKind::PieceLocked;
+            });
+            const std::uint64_t locked = gsPtr->lockedPieces() - std::min(cursor.lockedPieces, gsPtr->lockedPieces());
+            for (std::uint64_t lost = locked - std::min(held, locked); lost > 0; --lost) {
+                m_session.onPieceLocked(pid, snapshots);
+            }
         }
 
-        lastCount = currentCount;
+        cursor.next = events.forEachSince(cursor.next, [&](const tetris::core::GameEvent& event) {
+            if (event.kind == tetris::core::GameEventKind::PieceLocked) {
+                // We give the current snapshots so rules can base decisions on up-to-date info.
+                m_session.onPieceLocked(pid, snapshots);
+            }
+        });
+        cursor.lockedPieces = gsPtr->lockedPieces();
     }
 }
 
 void HostLoop::sendStateUpdate(Tick currentTick)
 {
     // 6) Build and broadcast a StateUpdate so all clients can redraw.
-    StateUpdate update;
+    //    The message from the previous broadcast is refilled in place.
+    static const std::string kUnknownName;
+
+    auto& update = std::get<StateUpdate>(m_stateMessage.payload);
     update.serverTick = currentTick;
 
-    update.players.reserve(m_gameStates.size());
+    std::size_t i = 0;
     for (const auto& [pid, gsPtr] : m_gameStates) {
         if (!gsPtr) continue;
 
@@ -143,14 +217,51 @@ void HostLoop::sendStateUpdate(Tick currentTick)
         auto itName = m_playerNames.find(pid);
         const std::string& name = (itName != m_playerNames.end())
                                   ? itName->second
-                                  : (static_cast<const std::string&>("")); // "" if unknown
+                                  : kUnknownName;
+
+        if (i == update.players.size()) {
+            update.players.emplace_back();
+            m_boardCaches.emplace_back();
+        }
+        auto& dto = update.players[i];
+        StateUpdateMapper::updatePlayerDTO(dto, m_boardCaches[i], pid, name, *gsPtr);
+        ++i;
+
+        if (!isPredictingPlayer(pid)) {
+            dto.lastInputTick.reset();
+            dto.gameSnapshot.clear();
+            dto.snapshotTiming.reset();
+            continue;
+        }
+        StateUpdateMapper::writeGameSnapshot(dto, *gsPtr);
 
-        update.players.push_back(
-            StateUpdateMapper::toPlayerDTO(pid, name, *gsPtr)
-        );
+        auto itTick = m_lastInputTick.find(pid);
+        if (itTick != m_lastInputTick.end()) {
+            dto.lastInputTick = itTick->second;
+        }
+
+        SnapshotTimingDTO timing;
+        auto itSince = m_sinceInput.find(pid);
+        if (itSince != m_sinceInput.end()) {
+            timing.sinceInputMs = static_cast<std::uint32_t>(itSince->second.count());
+        }
+        auto itCtrl = m_controllers.find(pid);
+        if (itCtrl != m_controllers.end() && itCtrl->second) {
+            timing.gravityMs = static_cast<std::uint32_t>(itCtrl->second->accumulatedTime().count());
+        }
+        dto.snapshotTiming = timing;
     }
 
-    m_session.broadcastStateUpdate(update);
+    m_session.broadcast(m_stateMessage);
+}
+
+bool HostLoop::isPredictingPlayer(PlayerId pid) const
+{
+    if (m_session.mode() != GameMode::TimeAttack || pid == NetworkHost::HostPlayerId) {
+        return false;
+    }
+    return std::none_of(m_bots.begin(), m_bots.end(),
+                        [pid](const auto& bot) { return bot.first == pid; });
 }
 
 } // namespace tetris::net
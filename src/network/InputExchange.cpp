@@ -0,0 +1,99 @@
+#include "network/InputExchange.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace tetris::net {
+
+namespace {
+
+// Local hashes kept for comparison; remote hashes older than the oldest
+// one kept can no longer be checked and are dropped.
+constexpr std::size_t kHashHistory = 64;
+
+} // namespace
+
+InputExchange::InputExchange(const char* owner, PlayerId localId, std::vector<PlayerId> players,
+                             Tick firstLocalFrame)
+    : m_owner(owner)
+    , m_localId(localId)
+    , m_players(std::move(players))
+    , m_nextLocalFrame(firstLocalFrame)
+{
+    std::sort(m_players.begin(), m_players.end());
+    m_players.erase(std::unique(m_players.begin(), m_players.end()), m_players.end());
+    const auto local = findPlayer(m_localId);
+    if (!local) {
+        throw std::invalid_argument(std::string(m_owner) + ": local player is not in the player list");
+    }
+    m_localIndex = *local;
+}
+
+std::optional<std::size_t> InputExchange::findPlayer(PlayerId player) const
+{
+    const auto it = std::lower_bound(m_players.begin(), m_players.end(), player);
+    if (it == m_players.end() || *it != player) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - m_players.begin());
+}
+
+std::size_t InputExchange::playerIndex(PlayerId player) const
+{
+    const auto index = findPlayer(player);
+    if (!index) {
+        throw std::out_of_range(std::string(m_owner) + ": unknown player");
+    }
+    return *index;
+}
+
+void InputExchange::receiveHash(const LockstepHash& hash)
+{
+    if (!m_localHashes.empty() && hash.tick < m_localHashes.begin()->first) {
+        return; // too old to check
+    }
+    m_remoteHashes.emplace(hash.tick, hash.hash);
+    checkHashes();
+}
+
+void InputExchange::recordHash(Tick tick, std::uint64_t hash)
+{
+    m_localHashes[tick] = hash;
+    while (m_localHashes.size() > kHashHistory) {
+        m_localHashes.erase(m_localHashes.begin());
+    }
+    m_hashedThrough = tick;
+
+    Message msg;
+    msg.kind = MessageKind::LockstepHash;
+    msg.payload = LockstepHash{ m_localId, tick, hash };
+    m_outgoing.push_back(std::move(msg));
+
+    checkHashes();
+}
+
+void InputExchange::checkHashes()
+{
+    for (auto it = m_remoteHashes.begin(); it != m_remoteHashes.end();) {
+        if (!m_hashedThrough || it->first > *m_hashedThrough) {
+            break; // we have not hashed that tick yet
+        }
+        const auto local = m_localHashes.find(it->first);
+        if (local != m_localHashes.end() && local->second != it->second
+            && (!m_desyncTick || it->first < *m_desyncTick)) {
+            m_desyncTick = it->first;
+        }
+        it = m_remoteHashes.erase(it);
+    }
+}
+
+void InputExchange::takeOutgoing(std::vector<Message>& out)
+{
+    for (auto& msg : m_outgoing) {
+        out.push_back(std::move(msg));
+    }
+    m_outgoing.clear();
+}
+
+} // namespace tetris::net
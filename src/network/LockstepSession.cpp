@@ -0,0 +1,157 @@
+#include "network/LockstepSession.hpp"
+
+#include "network/StateHash.hpp"
+
+#include <algorithm>
+
+namespace tetris::net {
+
+LockstepSession::PlayerGame::PlayerGame(std::uint64_t seed)
+    : controller(game)
+{
+    game.setSeed(seed);
+    game.start();
+}
+
+LockstepSession::LockstepSession(PlayerId localId, std::vector<PlayerId> players,
+                                 std::uint64_t seed, Config config)
+    : m_exchange("LockstepSession", localId, std::move(players), config.inputDelayTicks)
+    , m_config(config)
+{
+    m_config.tickMs = std::max<std::uint32_t>(1u, m_config.tickMs);
+    m_config.piecesPerTurn = std::max<std::uint32_t>(1u, m_config.piecesPerTurn);
+
+    const auto& ids = m_exchange.players();
+    const std::size_t gameCount = (m_config.mode == GameMode::SharedTurns) ? 1 : ids.size();
+    for (std::size_t i = 0; i < gameCount; ++i) {
+        m_games.push_back(std::make_unique<PlayerGame>(seed));
+    }
+    m_frames.resize(ids.size());
+
+    m_turnPlayer = ids.front();
+    m_piecesLeft = m_config.piecesPerTurn;
+}
+
+LockstepSession::PlayerGame& LockstepSession::gameFor(std::size_t index)
+{
+    return *m_games[m_games.size() == 1 ? 0 : index];
+}
+
+const LockstepSession::PlayerGame& LockstepSession::gameFor(std::size_t index) const
+{
+    return *m_games[m_games.size() == 1 ? 0 : index];
+}
+
+const LockstepSession::GameState& LockstepSession::game(PlayerId player) const
+{
+    return gameFor(playerIndex(player)).game;
+}
+
+void LockstepSession::addLocalInput(InputAction action)
+{
+    m_exchange.addLocalInput(action);
+}
+
+void LockstepSession::receive(const Message& msg)
+{
+    m_exchange.receive(msg, [this](std::size_t index, const LockstepInputs& inputs) {
+        if (inputs.tick >= m_tick) {
+            m_frames[index][inputs.tick] = inputs.actions;
+        }
+    });
+}
+
+bool LockstepSession::frameReady(std::size_t index, Tick tick) const
+{
+    return tick < m_config.inputDelayTicks || m_frames[index].count(tick) != 0;
+}
+
+bool LockstepSession::waitingFor(PlayerId player) const
+{
+    return !frameReady(playerIndex(player), m_tick);
+}
+
+void LockstepSession::sendLocalFrames()
+{
+    auto& local = m_frames[m_exchange.localIndex()];
+    m_exchange.sendLocalFrames(m_tick + m_config.inputDelayTicks, [&local](const LockstepInputs& frame) {
+        local[frame.tick] = frame.actions;
+    });
+}
+
+int LockstepSession::advance(int maxTicks)
+{
+    int ran = 0;
+    sendLocalFrames();
+
+    while (ran < maxTicks) {
+        for (std::size_t i = 0; i < m_frames.size(); ++i) {
+            if (!frameReady(i, m_tick)) {
+                return ran;
+            }
+        }
+
+        simulateTick();
+        ++m_tick;
+        ++ran;
+
+        if (m_config.hashIntervalTicks != 0 && m_tick % m_config.hashIntervalTicks == 0) {
+            m_exchange.recordHash(m_tick, stateHash());
+        }
+        sendLocalFrames();
+    }
+    return ran;
+}
+
+void LockstepSession::simulateTick()
+{
+    const bool shared = (m_config.mode == GameMode::SharedTurns);
+    const auto eventsBefore = m_games.front()->game.events().head();
+
+    for (std::size_t i = 0; i < m_frames.size(); ++i) {
+        auto& frames = m_frames[i];
+        const auto it = frames.find(m_tick);
+        if (it == frames.end()) {
+            continue; // implicit empty frame inside the input delay
+        }
+        if (!shared || players()[i] == m_turnPlayer) {
+            for (InputAction action : it->second) {
+                gameFor(i).controller.handleAction(action);
+            }
+        }
+        frames.erase(it);
+    }
+
+    const GameController::Duration step{m_config.tickMs};
+    for (auto& pg : m_games) {
+        pg->controller.update(step);
+    }
+
+    if (shared) {
+        updateTurn(eventsBefore);
+    }
+}
+
+void LockstepSession::updateTurn(tetris::core::GameEventLog::Sequence eventsBefore)
+{
+    m_games.front()->game.events().forEachSince(eventsBefore, [this](const tetris::core::GameEvent& event) {
+        if (event.kind == tetris::core::GameEventKind::PieceLocked && --m_piecesLeft == 0) {
+            const auto& ids = players();
+            m_turnPlayer = ids[(playerIndex(m_turnPlayer) + 1) % ids.size()];
+            m_piecesLeft = m_config.piecesPerTurn;
+        }
+    });
+}
+
+std::uint64_t LockstepSession::stateHash() const
+{
+    std::uint64_t h = StateHashSeed;
+    for (const auto& pg : m_games) {
+        h = mixStateHash(h, pg->game);
+    }
+    h = mixStateHash(h, m_turnPlayer);
+    h = mixStateHash(h, m_piecesLeft);
+    return h;
+}
+
+} // namespace tetris::net
@@ -131,6 +131,14 @@ std::optional<ErrorMessage> NetworkClient::consumeError()
     return out;
 }
 
+std::vector<Message> NetworkClient::consumeLockstepMessages()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto out = std::move(m_lockstepQueue);
+    m_lockstepQueue.clear();
+    return out;
+}
+
 // ------------------ Message handling ------------------
 
 void NetworkClient::handleMessage(const Message& msg)
@@ -166,6 +174,7 @@ void NetworkClient::handleMessage(const Message& msg)
             m_lastStateUpdate.reset();
             m_lastPlayerLeft.reset();
             m_lastError.reset();
+            m_lockstepQueue.clear();
 
             startCb = m_startGameHandler;
         }
@@ -213,6 +222,13 @@ void NetworkClient::handleMessage(const Message& msg)
         break;
     }
 
+    case MessageKind::LockstepInputs:
+    case MessageKind::LockstepHash: {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lockstepQueue.push_back(msg);
+        break;
+    }
+
     default:
         break;
     }
@@ -235,4 +251,12 @@ void NetworkClient::sendRematchDecision(bool wantsRematch)
     m_session->send(msg);
 }
 
+void NetworkClient::sendLockstep(const Message& msg)
+{
+    if (msg.kind != MessageKind::LockstepInputs && msg.kind != MessageKind::LockstepHash) return;
+    if (!m_session || !m_session->isConnected()) return;
+
+    m_session->send(msg);
+}
+
 } // namespace tetris::net
@@ -1,8 +1,11 @@
 #include "network/NetworkHost.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 
+#include "core/TetrominoFactory.hpp"
+
 namespace tetris::net {
 
 NetworkHost::NetworkHost(const MultiplayerConfig& config)
@@ -60,6 +63,7 @@ void NetworkHost::poll()
             m_lastKeepAlive = now;
         }
         if (now - m_lastKeepAlive >= std::chrono::seconds(1)) {
+            keepAliveTargets.swap(m_keepAliveTargets);
             for (auto& [pid2, info2] : m_players) {
                 (void)pid2;
                 if (info2.session && info2.session->isConnected()) {
@@ -85,6 +89,12 @@ void NetworkHost::poll()
                 s->send(ka);
             }
         }
+        keepAliveTargets.clear(); // do not keep sessions alive between polls
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (keepAliveTargets.capacity() > m_keepAliveTargets.capacity()) {
+            m_keepAliveTargets.swap(keepAliveTargets);
+        }
     }
 }
 
@@ -123,6 +133,7 @@ void NetworkHost::handleIncoming(PlayerId pid, const Message& msg)
     INetworkSessionPtr sessionToReply;
     Message reply{};
     bool shouldReply = false;
+    std::vector<INetworkSessionPtr> relayTargets;
 
     {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -148,6 +159,22 @@ void NetworkHost::handleIncoming(PlayerId pid, const Message& msg)
         else if (msg.kind == MessageKind::InputActionMessage) {
             m_inputQueue.push_back(std::get<InputActionMessage>(msg.payload));
         }
+        else if (msg.kind == MessageKind::LockstepInputs || msg.kind == MessageKind::LockstepHash) {
+            // A client may only speak for itself.
+            const PlayerId sender = (msg.kind == MessageKind::LockstepInputs)
+                ? std::get<LockstepInputs>(msg.payload).playerId
+                : std::get<LockstepHash>(msg.payload).playerId;
+            if (sender != pid) {
+                return;
+            }
+
+            m_lockstepQueue.push_back(msg);
+            for (auto& [otherId, info] : m_players) {
+                if (otherId != pid && info.session && info.session->isConnected()) {
+                    relayTargets.push_back(info.session);
+                }
+            }
+        }
         else if (msg.kind == MessageKind::RematchDecision) {
             const auto& rd = std::get<RematchDecision>(msg.payload);
             if (rd.wantsRematch) {
@@ -164,6 +191,12 @@ void NetworkHost::handleIncoming(PlayerId pid, const Message& msg)
     if (shouldReply && sessionToReply && sessionToReply->isConnected()) {
         sessionToReply->send(reply);
     }
+
+    for (auto& s : relayTargets) {
+        if (s && s->isConnected()) {
+            s->send(msg);
+        }
+    }
 }
 
 std::vector<InputActionMessage> NetworkHost::consumeInputQueue()
@@ -174,6 +207,27 @@ std::vector<InputActionMessage> NetworkHost::consumeInputQueue()
     return out;
 }
 
+void NetworkHost::consumeInputQueue(std::vector<InputActionMessage>& out)
+{
+    out.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out.swap(m_inputQueue);
+}
+
+std::vector<Message> NetworkHost::consumeLockstepMessages()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto out = std::move(m_lockstepQueue);
+    m_lockstepQueue.clear();
+    return out;
+}
+
+std::uint64_t NetworkHost::matchSeed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_matchSeed;
+}
+
 void NetworkHost::startMatch()
 {
     Message msg;
@@ -185,14 +239,28 @@ void NetworkHost::startMatch()
         m_matchStarted = true;
 
         m_startTick = 0;
+        m_matchSeed = (m_config.pieceSeed != 0)
+                      ? m_config.pieceSeed
+                      : tetris::core::TetrominoFactory::randomSeed();
 
-        msg.kind = MessageKind::StartGame;
-        msg.payload = StartGame{
+        StartGame start{
             m_config.mode,
             m_config.timeLimitSeconds,
             m_config.piecesPerTurn,
-            m_startTick
+            m_startTick,
+            m_matchSeed
         };
+        if (m_config.lockstep) {
+            start.lockstepTickMs = std::max<std::uint32_t>(1u, m_config.lockstepTickMs);
+            start.inputDelayTicks = m_config.inputDelayTicks;
+            if (m_config.mode == GameMode::TimeAttack) {
+                start.rollbackWindowTicks = m_config.rollbackWindowTicks;
+            }
+        }
+        m_lockstepQueue.clear();
+
+        msg.kind = MessageKind::StartGame;
+        msg.payload = start;
 
         for (auto& [pid, info] : m_players) {
             (void)pid;
@@ -211,9 +279,12 @@ void NetworkHost::startMatch()
 
 void NetworkHost::broadcast(const Message& msg)
 {
+    // The host broadcasts a StateUpdate many times per second, so the
+    // list is borrowed from m_broadcastTargets rather than built anew.
     std::vector<INetworkSessionPtr> targets;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
+        targets.swap(m_broadcastTargets);
         for (auto& [pid, info] : m_players) {
             (void)pid;
             if (info.session && info.session->isConnected()) {
@@ -227,6 +298,12 @@ void NetworkHost::broadcast(const Message& msg)
             s->send(msg);
         }
     }
+    targets.clear(); // do not keep sessions alive between broadcasts
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (targets.capacity() > m_broadcastTargets.capacity()) {
+        m_broadcastTargets.swap(targets);
+    }
 }
 
 void NetworkHost::sendTo(PlayerId playerId, const Message& msg)
@@ -0,0 +1,215 @@
+#include "network/RollbackSession.hpp"
+
+#include "network/StateHash.hpp"
+
+#include <algorithm>
+
+namespace tetris::net {
+
+namespace {
+
+std::uint64_t hashGames(const std::vector<tetris::core::GameState>& games)
+{
+    std::uint64_t h = StateHashSeed;
+    for (const auto& game : games) {
+        h = mixStateHash(h, game);
+    }
+    return h;
+}
+
+} // namespace
+
+RollbackSession::RollbackSession(PlayerId localId, std::vector<PlayerId> players,
+                                 std::uint64_t seed, Config config)
+    : m_exchange("RollbackSession", localId, std::move(players), config.inputDelayTicks)
+    , m_config(config)
+{
+    m_config.tickMs = std::max<std::uint32_t>(1u, m_config.tickMs);
+    m_config.rollbackWindowTicks = std::max<std::uint32_t>(1u, m_config.rollbackWindowTicks);
+
+    const std::size_t n = m_exchange.players().size();
+    m_games.resize(n);
+    m_controllers.reserve(n);
+    for (auto& game : m_games) {
+        game.setSeed(seed);
+        game.start();
+        m_controllers.emplace_back(game);
+    }
+
+    m_ring.resize(m_config.rollbackWindowTicks + 1);
+    for (auto& slot : m_ring) {
+        slot.games.resize(n);
+        slot.timing.resize(n);
+    }
+
+    m_frames.resize(n);
+    m_nextUnknown.assign(n, m_config.inputDelayTicks); // earlier frames are empty by definition
+    m_nextHashTick = m_config.hashIntervalTicks;
+}
+
+const RollbackSession::GameState& RollbackSession::game(PlayerId player) const
+{
+    return m_games[playerIndex(player)];
+}
+
+const RollbackSession::GameState& RollbackSession::confirmedGame(PlayerId player) const
+{
+    const std::size_t index = playerIndex(player);
+    const Tick confirmed = confirmedTick();
+    return confirmed == m_tick ? m_games[index] : m_ring[confirmed % m_ring.size()].games[index];
+}
+
+Tick RollbackSession::confirmedTick() const noexcept
+{
+    const Tick known = std::min(m_tick, *std::min_element(m_nextUnknown.begin(), m_nextUnknown.end()));
+    return m_rollbackFrom ? std::min(known, *m_rollbackFrom) : known;
+}
+
+void RollbackSession::addLocalInput(InputAction action)
+{
+    m_exchange.addLocalInput(action);
+}
+
+void RollbackSession::noteFrame(std::size_t index, Tick tick, Frame actions)
+{
+    auto& frames = m_frames[index];
+    if (tick < m_nextUnknown[index] || frames.count(tick) != 0) {
+        return; // duplicate
+    }
+
+    const bool late = tick < m_tick && !actions.empty();
+    frames.emplace(tick, std::move(actions));
+    while (frames.count(m_nextUnknown[index]) != 0) {
+        ++m_nextUnknown[index];
+    }
+
+    // An empty late frame matches the "no input" prediction.
+    if (late && (!m_rollbackFrom || tick < *m_rollbackFrom)) {
+        m_rollbackFrom = tick;
+    }
+}
+
+void RollbackSession::receive(const Message& msg)
+{
+    m_exchange.receive(msg, [this](std::size_t index, const LockstepInputs& inputs) {
+        noteFrame(index, inputs.tick, inputs.actions);
+    });
+}
+
+void RollbackSession::sendLocalFrames()
+{
+    const std::size_t local = m_exchange.localIndex();
+    m_exchange.sendLocalFrames(m_tick + m_config.inputDelayTicks, [this, local](const LockstepInputs& frame) {
+        noteFrame(local, frame.tick, frame.actions);
+    });
+}
+
+void RollbackSession::save(Tick tick)
+{
+    SavedTick& slot = saved(tick);
+    for (std::size_t i = 0; i < m_games.size(); ++i) {
+        slot.games[i] = m_games[i];
+        slot.timing[i] = m_controllers[i].accumulatedTime();
+    }
+}
+
+void RollbackSession::restore(Tick tick)
+{
+    const SavedTick& slot = saved(tick);
+    for (std::size_t i = 0; i < m_games.size(); ++i) {
+        m_games[i] = slot.games[i];
+        m_controllers[i].restoreTiming(slot.timing[i]);
+    }
+}
+
+void RollbackSession::simulate(Tick tick)
+{
+    for (std::size_t i = 0; i < m_frames.size(); ++i) {
+        const auto it = m_frames[i].find(tick);
+        if (it == m_frames[i].end()) {
+            continue; // predicted: no input
+        }
+        for (InputAction action : it->second) {
+            m_controllers[i].handleAction(action);
+        }
+    }
+
+    const GameController::Duration step{m_config.tickMs};
+    for (auto& controller : m_controllers) {
+        controller.update(step);
+    }
+}
+
+void RollbackSession::rollback()
+{
+    const Tick from = *m_rollbackFrom;
+    m_rollbackFrom.reset();
+    if (from >= m_tick) {
+        return;
+    }
+
+    restore(from);
+    for (Tick t = from; t < m_tick; ++t) {
+        save(t);
+        simulate(t);
+    }
+
+    ++m_rollbacks;
+    m_maxRollback = std::max(m_maxRollback, m_tick - from);
+}
+
+int RollbackSession::advance(int maxTicks)
+{
+    sendLocalFrames();
+    if (m_rollbackFrom) {
+        rollback();
+    }
+    recordConfirmedHashes();
+
+    const Tick window = m_config.rollbackWindowTicks;
+    int ran = 0;
+    while (ran < maxTicks) {
+        // The first unconfirmed tick must stay inside the ring.
+        if (m_tick + 1 > confirmedTick() + window) {
+            break;
+        }
+
+        save(m_tick);
+        simulate(m_tick);
+        ++m_tick;
+        ++ran;
+
+        recordConfirmedHashes();
+        sendLocalFrames();
+    }
+
+    // Frames older than the ring can never be replayed again.
+    if (m_tick > window + 1) {
+        const Tick keepFrom = m_tick - window - 1;
+        for (auto& frames : m_frames) {
+            frames.erase(frames.begin(), frames.lower_bound(keepFrom));
+        }
+    }
+    return ran;
+}
+
+std::uint64_t RollbackSession::stateHash() const
+{
+    return hashGames(m_games);
+}
+
+void RollbackSession::recordConfirmedHashes()
+{
+    if (m_config.hashIntervalTicks == 0) {
+        return;
+    }
+
+    const Tick confirmed = confirmedTick();
+    while (m_nextHashTick <= confirmed) {
+        const Tick t = m_nextHashTick;
+        m_exchange.recordHash(t, (t == m_tick) ? stateHash() : hashGames(saved(t).games));
+        m_nextHashTick += m_config.hashIntervalTicks;
+    }
+}
+
+} // namespace tetris::net
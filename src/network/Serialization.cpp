@@ -1,5 +1,6 @@
 #include "network/Serialization.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,6 +33,37 @@ namespace {
         return out;
     }
 
+    std::string toHex(const std::vector<std::uint8_t>& bytes) {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(bytes.size() * 2);
+        for (std::uint8_t b : bytes) {
+            out.push_back(digits[b >> 4]);
+            out.push_back(digits[b & 0x0F]);
+        }
+        return out;
+    }
+
+    std::optional<std::vector<std::uint8_t>> fromHex(const std::string& s) {
+        auto nibble = [](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+        if (s.size() % 2 != 0) return std::nullopt;
+
+        std::vector<std::uint8_t> out;
+        out.reserve(s.size() / 2);
+        for (std::size_t i = 0; i < s.size(); i += 2) {
+            const int hi = nibble(s[i]);
+            const int lo = nibble(s[i + 1]);
+            if (hi < 0 || lo < 0) return std::nullopt;
+            out.push_back(static_cast<std::uint8_t>((hi << 4) | lo));
+        }
+        return out;
+    }
+
     // Helper to split a string by a single character delimiter (no escaping inside).
     std::vector<std::string> splitSimple(const std::string& s, char delim) {
         std::vector<std::string> parts;
@@ -68,6 +100,17 @@ std::string serialize(const Message& msg)
            << m.timeLimitSeconds << ';'
            << m.piecesPerTurn << ';'
            << m.startTick;
+        // Optional trailing fields; older peers stop reading at startTick.
+        if (m.pieceSeed || m.lockstepTickMs != 0) {
+            os << ';';
+            if (m.pieceSeed) os << *m.pieceSeed;
+        }
+        if (m.lockstepTickMs != 0) {
+            os << ';' << m.lockstepTickMs << ';' << m.inputDelayTicks;
+            if (m.rollbackWindowTicks != 0) {
+                os << ';' << m.rollbackWindowTicks;
+            }
+        }
         break;
     }
     case MessageKind::InputActionMessage: {
@@ -108,6 +151,26 @@ std::string serialize(const Message& msg)
                     os << (cell.occupied ? 1 : 0) << ':' << cell.colorIndex;
                 }
             }
+
+            // Optional prediction block after the players, so older peers
+            // (which stop after the last player) are unaffected:
+            // PREDICTION;count;{id;lastInputTick;snapshotHex;sinceInputMs:gravityMs}...
+            const auto predicted = static_cast<std::size_t>(std::count_if(
+                m.players.begin(), m.players.end(), [](const PlayerStateDTO& p) {
+                    return p.lastInputTick.has_value() || !p.gameSnapshot.empty();
+                }));
+            if (predicted > 0) {
+                os << ";PREDICTION;" << predicted;
+                for (const auto& p : m.players) {
+                    if (!p.lastInputTick && p.gameSnapshot.empty()) continue;
+                    os << ';' << p.id << ';';
+                    if (p.lastInputTick) os << *p.lastInputTick;
+                    os << ';' << toHex(p.gameSnapshot) << ';';
+                    if (p.snapshotTiming) {
+                        os << p.snapshotTiming->sinceInputMs << ':' << p.snapshotTiming->gravityMs;
+                    }
+                }
+            }
             break;
         }
     case MessageKind::MatchResult: {
@@ -143,6 +206,23 @@ std::string serialize(const Message& msg)
         os << "KEEPALIVE";
         break;
     }
+    case MessageKind::LockstepInputs: {
+        os << "LOCKSTEP_INPUTS;";
+        const auto& m = std::get<LockstepInputs>(msg.payload);
+        // playerId;tick;action,action,... (empty list = no input this tick)
+        os << m.playerId << ';' << m.tick << ';';
+        for (std::size_t i = 0; i < m.actions.size(); ++i) {
+            if (i > 0) os << ',';
+            os << static_cast<int>(m.actions[i]);
+        }
+        break;
+    }
+    case MessageKind::LockstepHash: {
+        os << "LOCKSTEP_HASH;";
+        const auto& m = std::get<LockstepHash>(msg.payload);
+        os << m.playerId << ';' << m.tick << ';' << m.hash;
+        break;
+    }
     }
 
     return os.str();
@@ -185,11 +265,15 @@ std::optional<Message> deserialize(const std::string& line)
         msg.payload = std::move(payload);
         return msg;
     } else if (type == "START_GAME") {
-        std::string modeStr, timeStr, piecesStr, tickStr;
+        std::string modeStr, timeStr, piecesStr, tickStr, seedStr, stepStr, delayStr, windowStr;
         if (!std::getline(is, modeStr, ';')) return std::nullopt;
         if (!std::getline(is, timeStr, ';')) return std::nullopt;
         if (!std::getline(is, piecesStr, ';')) return std::nullopt;
-        std::getline(is, tickStr);
+        std::getline(is, tickStr, ';');
+        std::getline(is, seedStr, ';');
+        std::getline(is, stepStr, ';');
+        std::getline(is, delayStr, ';');
+        std::getline(is, windowStr);
 
         StartGame payload{
             static_cast<GameMode>(std::stoi(modeStr)),
@@ -197,6 +281,16 @@ std::optional<Message> deserialize(const std::string& line)
             static_cast<std::uint32_t>(std::stoul(piecesStr)),
             static_cast<Tick>(std::stoull(tickStr))
         };
+        if (!seedStr.empty()) {
+            payload.pieceSeed = static_cast<std::uint64_t>(std::stoull(seedStr));
+        }
+        if (!stepStr.empty()) {
+            payload.lockstepTickMs = static_cast<std::uint32_t>(std::stoul(stepStr));
+            payload.inputDelayTicks = delayStr.empty() ? 0u : static_cast<std::uint32_t>(std::stoul(delayStr));
+            if (!windowStr.empty()) {
+                payload.rollbackWindowTicks = static_cast<std::uint32_t>(std::stoul(windowStr));
+            }
+        }
         msg.kind = MessageKind::StartGame;
         msg.payload = std::move(payload);
         return msg;
@@ -305,6 +399,42 @@ std::optional<Message> deserialize(const std::string& line)
                 update.players.push_back(std::move(dto));
             }
 
+            std::string marker;
+            if (std::getline(is, marker, ';') && marker == "PREDICTION") {
+                std::string predCountStr;
+                if (!std::getline(is, predCountStr, ';')) return std::nullopt;
+                const auto predCount = static_cast<std::size_t>(std::stoul(predCountStr));
+
+                for (std::size_t i = 0; i < predCount; ++i) {
+                    std::string idStr, ackStr, hexStr, timingStr;
+                    if (!std::getline(is, idStr, ';'))  return std::nullopt;
+                    if (!std::getline(is, ackStr, ';')) return std::nullopt;
+                    if (!std::getline(is, hexStr, ';')) return std::nullopt;
+                    std::getline(is, timingStr, ';');
+
+                    auto snapshot = fromHex(hexStr);
+                    if (!snapshot) return std::nullopt;
+
+                    const auto id = static_cast<PlayerId>(std::stoul(idStr));
+                    for (auto& dto : update.players) {
+                        if (dto.id != id) continue;
+                        if (!ackStr.empty()) {
+                            dto.lastInputTick = static_cast<Tick>(std::stoull(ackStr));
+                        }
+                        dto.gameSnapshot = std::move(*snapshot);
+                        if (!timingStr.empty()) {
+                            const auto pos = timingStr.find(':');
+                            if (pos == std::string::npos) return std::nullopt;
+                            SnapshotTimingDTO timing;
+                            timing.sinceInputMs = static_cast<std::uint32_t>(std::stoul(timingStr.substr(0, pos)));
+                            timing.gravityMs = static_cast<std::uint32_t>(std::stoul(timingStr.substr(pos + 1)));
+                            dto.snapshotTiming = timing;
+                        }
+                        break;
+                    }
+                }
+            }
+
             msg.kind = MessageKind::StateUpdate;
             msg.payload = std::move(update);
             return msg;
@@ -336,6 +466,36 @@ std::optional<Message> deserialize(const std::string& line)
             msg.kind = MessageKind::KeepAlive;
             msg.payload = KeepAlive{};
             return msg;
+        } else if (type == "LOCKSTEP_INPUTS") {
+            std::string pidStr, tickStr, actionsStr;
+            if (!std::getline(is, pidStr, ';')) return std::nullopt;
+            if (!std::getline(is, tickStr, ';')) return std::nullopt;
+            std::getline(is, actionsStr);
+
+            LockstepInputs payload;
+            payload.playerId = static_cast<PlayerId>(std::stoul(pidStr));
+            payload.tick = static_cast<Tick>(std::stoull(tickStr));
+            for (const auto& token : splitSimple(actionsStr, ',')) {
+                payload.actions.push_back(static_cast<tetris::controller::InputAction>(std::stoi(token)));
+            }
+
+            msg.kind = MessageKind::LockstepInputs;
+            msg.payload = std::move(payload);
+            return msg;
+        } else if (type == "LOCKSTEP_HASH") {
+            std::string pidStr, tickStr, hashStr;
+            if (!std::getline(is, pidStr, ';')) return std::nullopt;
+            if (!std::getline(is, tickStr, ';')) return std::nullopt;
+            std::getline(is, hashStr);
+
+            LockstepHash payload;
+            payload.playerId = static_cast<PlayerId>(std::stoul(pidStr));
+            payload.tick = static_cast<Tick>(std::stoull(tickStr));
+            payload.hash = static_cast<std::uint64_t>(std::stoull(hashStr));
+
+            msg.kind = MessageKind::LockstepHash;
+            msg.payload = std::move(payload);
+            return msg;
         }
 
     return std::nullopt;
@@ -4,8 +4,7 @@
 
 namespace tetris::net {
 
-using tetris::core::Board;
-using tetris::core::CellState;
+using tetris::core::StandardBoard;
 using tetris::core::GameStatus;
 
 PlayerStateDTO StateUpdateMapper::toPlayerDTO(
@@ -14,6 +13,18 @@ PlayerStateDTO StateUpdateMapper::toPlayerDTO(
     const tetris::core::GameState& gs)
 {
     PlayerStateDTO dto;
+    BoardCache cache;
+    updatePlayerDTO(dto, cache, playerId, playerName, gs);
+    return dto;
+}
+
+void StateUpdateMapper::updatePlayerDTO(
+    PlayerStateDTO& dto,
+    BoardCache& cache,
+    PlayerId playerId,
+    const std::string& playerName,
+    const tetris::core::GameState& gs)
+{
     dto.id   = playerId;
     dto.name = playerName;
 
@@ -24,31 +35,47 @@ PlayerStateDTO StateUpdateMapper::toPlayerDTO(
     dto.isAlive = (gs.status() != GameStatus::GameOver);
 
     // --- Board snapshot ---
-    const Board& board = gs.board();
-    dto.board.width  = board.cols(); // width = number of columns
-    dto.board.height = board.rows(); // height = number of rows
+    const StandardBoard& board = gs.board();
+    const int width  = board.cols(); // width = number of columns
+    const int height = board.rows(); // height = number of rows
 
-    const int width  = dto.board.width;
-    const int height = dto.board.height;
-
-    dto.board.cells.clear();
-    dto.board.cells.resize(width * height);
+    if (dto.board.width != width || dto.board.height != height
+        || dto.board.cells.size() != static_cast<std::size_t>(width * height)) {
+        dto.board.width  = width;
+        dto.board.height = height;
+        dto.board.cells.assign(static_cast<std::size_t>(width * height), BoardCellDTO{});
+        cache = BoardCache{}; // nothing reusable
+    }
+    if (cache.board != &board) {
+        cache = BoardCache{ &board, 0 }; // DTO was built from a different board
+    }
 
-    for (int row = 0; row < height; ++row) {
-        for (int col = 0; col < width; ++col) {
-            const auto state = board.cell(row, col);
-            const bool occupied = (state == CellState::Filled);
+    // Only rows touched since the last refresh are rewritten.
+    StandardBoard::RowSet dirty = board.dirtyRowsSince(cache.epoch);
+    cache.epoch = board.epoch();
 
-            BoardCellDTO cellDto;
-            cellDto.occupied   = occupied;
-            cellDto.colorIndex = occupied ? 0 : -1;
+    for (int row = 0; dirty != 0; ++row, dirty >>= 1) {
+        if (!(dirty & 1U)) continue;
 
-            const int index = row * width + col;
-            dto.board.cells[index] = cellDto;
+        const auto view = board.row(row);
+        auto out = dto.board.cells.begin() + row * width;
+        for (int col = 0; col < width; ++col, ++out) {
+            const bool occupied = view.filled(col);
+            out->occupied   = occupied;
+            out->colorIndex = occupied ? 0 : -1;
         }
     }
+}
 
-    return dto;
+void StateUpdateMapper::writeGameSnapshot(
+    PlayerStateDTO& dto,
+    const tetris::core::GameState& gs)
+{
+    // The size varies with the piece queue; reserving the maximum once
+    // keeps later refreshes of the same DTO from reallocating.
+    dto.gameSnapshot.reserve(tetris::core::GameState::MaxSnapshotBytes);
+    dto.gameSnapshot.resize(gs.snapshotSize());
+    gs.saveSnapshot(tetris::core::Span<std::uint8_t>{dto.gameSnapshot.data(), dto.gameSnapshot.size()});
 }
 
 } // namespace tetris::net
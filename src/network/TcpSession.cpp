@@ -1,5 +1,4 @@
 #include "network/TcpSession.hpp"
-#include "network/Serialization.hpp"
 
 #include <atomic>
 #include <thread>
@@ -49,10 +48,16 @@ void ensure_winsock_initialized() {}
 
 namespace tetris::net {
 
-TcpSession::TcpSession(int socketFd)
+TcpSession::TcpSession(int socketFd, bool offerBinary)
     : m_socket(socketFd)
     , m_connected(true)
 {
+    if (offerBinary) {
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        m_codec.offerBinary(m_sendBuffer);
+        writeAll(m_sendBuffer);
+    }
+
     // Start background read loop
     m_thread = std::thread(&TcpSession::readLoop, this);
 }
@@ -89,16 +94,23 @@ INetworkSessionPtr TcpSession::createClient(const std::string& host, std::uint16
         return nullptr;
     }
 
-    return INetworkSessionPtr(new TcpSession(static_cast<int>(sock)));
+    return INetworkSessionPtr(new TcpSession(static_cast<int>(sock), /*offerBinary=*/true));
 }
 
 void TcpSession::send(const Message& msg)
 {
     if (!m_connected) return;
 
-    const std::string line = serialize(msg) + "\n";
-    const char* data = line.c_str();
-    std::size_t total = line.size();
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+    m_sendBuffer.clear();
+    m_codec.encode(msg, m_sendBuffer);
+    writeAll(m_sendBuffer);
+}
+
+void TcpSession::writeAll(const std::vector<std::uint8_t>& bytes)
+{
+    const char* data = reinterpret_cast<const char*>(bytes.data());
+    std::size_t total = bytes.size();
 
     while (total > 0 && m_connected) {
         int sent = ::send(m_socket, data, static_cast<int>(total), 0);
@@ -124,10 +136,10 @@ void TcpSession::setMessageHandler(MessageHandler handler)
 
 void TcpSession::readLoop()
 {
-    std::string buffer;
-    buffer.reserve(4096);
+    std::vector<Message> messages;
+    std::vector<std::uint8_t> reply;
 
-    char tmp[1024];
+    char tmp[4096];
 
     while (m_connected) {
         int received = ::recv(m_socket, tmp, sizeof(tmp), 0);
@@ -137,36 +149,28 @@ void TcpSession::readLoop()
             break;
         }
 
-        buffer.append(tmp, tmp + received);
-
-        // Extract complete lines (terminated by '\n')
-        std::size_t pos = 0;
-        while (true) {
-            auto newlinePos = buffer.find('\n', pos);
-            if (newlinePos == std::string::npos)
-                break;
-
-            std::string line = buffer.substr(pos, newlinePos - pos);
-            pos = newlinePos + 1;
-
-            if (!line.empty()) {
-                auto msgOpt = deserialize(line);
-                if (msgOpt) {
-                    MessageHandler handlerCopy;
-                    {
-                        std::lock_guard<std::mutex> lock(m_handlerMutex);
-                        handlerCopy = m_handler;
-                    }
-                    if (handlerCopy) {
-                        handlerCopy(*msgOpt);
-                    }
-                }
-            }
+        messages.clear();
+        reply.clear();
+        if (!m_codec.receive(tmp, static_cast<std::size_t>(received), messages, reply)) {
+            // Corrupt binary framing; there is no way to resync
+            m_connected = false;
+            break;
+        }
+
+        if (!reply.empty()) {
+            std::lock_guard<std::mutex> lock(m_sendMutex);
+            writeAll(reply);
         }
 
-        // Discard processed part
-        if (pos > 0) {
-            buffer.erase(0, pos);
+        for (const auto& msg : messages) {
+            MessageHandler handlerCopy;
+            {
+                std::lock_guard<std::mutex> lock(m_handlerMutex);
+                handlerCopy = m_handler;
+            }
+            if (handlerCopy) {
+                handlerCopy(msg);
+            }
         }
     }
 
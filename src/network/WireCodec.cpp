@@ -0,0 +1,109 @@
+#include "network/WireCodec.hpp"
+
+#include "network/BinarySerialization.hpp"
+#include "network/Serialization.hpp"
+
+#include <stdexcept>
+
+namespace tetris::net {
+namespace {
+    constexpr char kCodecPrefix[] = "CODEC;";
+    constexpr std::size_t kCodecPrefixSize = sizeof(kCodecPrefix) - 1;
+
+    void appendLine(const std::string& line, std::vector<std::uint8_t>& out)
+    {
+        out.insert(out.end(), line.begin(), line.end());
+        out.push_back('\n');
+    }
+
+    std::string codecLine()
+    {
+        return kCodecPrefix + std::to_string(BinaryWireVersion);
+    }
+}
+
+void WireCodec::offerBinary(std::vector<std::uint8_t>& out)
+{
+    m_offered = true;
+    appendLine(codecLine(), out);
+}
+
+void WireCodec::encode(const Message& msg, std::vector<std::uint8_t>& out) const
+{
+    if (m_binary) {
+        encodeBinary(msg, out);
+    } else {
+        appendLine(serialize(msg), out);
+    }
+}
+
+void WireCodec::handleCodecLine(const std::string& line, std::vector<std::uint8_t>& reply)
+{
+    // A peer offers the newest version it has; only an exact match of ours
+    // is accepted, so a later version has to keep offering version 1 too
+    // if it wants to talk to this one.
+    if (line != codecLine() || m_binary) {
+        return;
+    }
+    if (!m_offered) {
+        appendLine(codecLine(), reply);
+    }
+    m_binary = true;
+}
+
+bool WireCodec::receive(const char* data, std::size_t size,
+                        std::vector<Message>& messages,
+                        std::vector<std::uint8_t>& reply)
+{
+    m_received.append(data, size);
+
+    std::size_t pos = 0;
+    while (pos < m_received.size()) {
+        if (static_cast<std::uint8_t>(m_received[pos]) == BinaryFrameMarker) {
+            const tetris::core::Span<const std::uint8_t> rest{
+                reinterpret_cast<const std::uint8_t*>(m_received.data()) + pos,
+                m_received.size() - pos
+            };
+
+            std::size_t frameSize = 0;
+            try {
+                frameSize = binaryFrameSize(rest);
+            } catch (const std::invalid_argument&) {
+                m_received.clear();
+                return false;
+            }
+            if (frameSize == 0) {
+                break; // wait for the rest of the frame
+            }
+
+            if (auto msg = decodeBinary(tetris::core::Span<const std::uint8_t>{rest.data(), frameSize})) {
+                messages.push_back(std::move(*msg));
+            }
+            pos += frameSize;
+            continue;
+        }
+
+        const auto newlinePos = m_received.find('\n', pos);
+        if (newlinePos == std::string::npos) {
+            break; // wait for the rest of the line
+        }
+
+        const std::string line = m_received.substr(pos, newlinePos - pos);
+        pos = newlinePos + 1;
+
+        if (line.empty()) {
+            continue;
+        }
+        if (line.compare(0, kCodecPrefixSize, kCodecPrefix) == 0) {
+            handleCodecLine(line, reply);
+        } else if (auto msg = deserialize(line)) {
+            messages.push_back(std::move(*msg));
+        }
+    }
+
+    // Discard processed part
+    m_received.erase(0, pos);
+    return true;
+}
+
+} // namespace tetris::net
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "controller/BotPlayer.hpp"
+#include "controller/GameController.hpp"
+#include "core/BatchSimulator.hpp"
+#include "core/GameState.hpp"
+#include "core/Random.hpp"
+
+using namespace tetris::core;
+using tetris::controller::BotPlayer;
+using tetris::controller::GameController;
+using tetris::controller::InputAction;
+
+namespace {
+
+void requireSameGame(const BatchSimulator& batch, std::size_t g, const GameState& game) {
+    REQUIRE(batch.status(g) == game.status());
+    REQUIRE(batch.score(g) == game.score());
+    REQUIRE(batch.level(g) == game.level());
+    REQUIRE(batch.lockedPieces(g) == game.lockedPieces());
+
+    const auto expected = game.activeTetromino();
+    const auto actual = batch.activeTetromino(g);
+    REQUIRE(actual.has_value() == expected.has_value());
+    if (expected) {
+        REQUIRE(actual->type() == expected->type());
+        REQUIRE(actual->rotation() == expected->rotation());
+        REQUIRE(actual->origin().row == expected->origin().row);
+        REQUIRE(actual->origin().col == expected->origin().col);
+    }
+
+    const auto& board = game.board();
+    for (int r = 0; r < BatchSimulator::Rows; ++r) {
+        REQUIRE(batch.rowMask(g, r) == board.rowMask(r));
+        for (int c = 0; c < BatchSimulator::Cols; ++c) {
+            REQUIRE(batch.cellType(g, r, c) == board.cellType(r, c));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("BatchSimulator: matches GameState + GameController step for step", "[batch]") {
+    constexpr std::size_t kGames = 24;
+    constexpr std::uint64_t kSeed = 900;
+
+    BatchSimulator batch{kGames};
+    std::vector<std::unique_ptr<GameState>> games;
+    std::vector<std::unique_ptr<GameController>> controllers;
+    for (std::size_t g = 0; g < kGames; ++g) {
+        games.push_back(std::make_unique<GameState>());
+        controllers.push_back(std::make_unique<GameController>(*games.back()));
+        games[g]->setSeed(kSeed + g);
+        games[g]->start();
+    }
+    batch.startAll(kSeed);
+
+    // Odd games get random inputs (PauseResume rare but exercised); even
+    // games are played by a bot so that lines get cleared and levels rise.
+    BotPlayer bot;
+    std::vector<InputAction> planned;
+    Pcg32 rng{1234};
+    const InputAction actions[] = {
+        InputAction::MoveLeft, InputAction::MoveLeft, InputAction::MoveRight, InputAction::MoveRight,
+        InputAction::RotateCW, InputAction::RotateCCW, InputAction::SoftDrop, InputAction::SoftDrop,
+        InputAction::HardDrop, InputAction::PauseResume,
+    };
+
+    bool anyLines = false;
+    for (int step = 0; step < 600; ++step) {
+        for (std::size_t g = 0; g < kGames; ++g) {
+            const std::uint32_t roll = rng.bounded(40);
+            if (g % 2 == 0) {
+                if (roll < 10 && bot.plan(*games[g], planned)) {
+                    for (InputAction action : planned) {
+                        controllers[g]->handleAction(action);
+                        batch.applyAction(g, action);
+                    }
+                }
+            } else if (roll < 10 && !(roll == 9 && rng.bounded(4) != 0)) {
+                controllers[g]->handleAction(actions[roll]);
+                batch.applyAction(g, actions[roll]);
+            }
+            const GameController::Duration elapsed{rng.bounded(120)};
+            controllers[g]->update(elapsed);
+            batch.update(g, elapsed);
+            requireSameGame(batch, g, *games[g]);
+            anyLines = anyLines || batch.linesCleared(g) > 0;
+        }
+    }
+    REQUIRE(anyLines);
+}
+
+TEST_CASE("BatchSimulator: updateAll and restarts", "[batch]") {
+    BatchSimulator batch{3};
+    REQUIRE(batch.status(0) == GameStatus::NotStarted);
+    batch.startAll(5);
+
+    GameState reference;
+    GameController controller{reference};
+    reference.setSeed(6);
+    reference.start();
+
+    for (int i = 0; i < 200; ++i) {
+        batch.updateAll(BatchSimulator::Duration{400});
+        controller.update(GameController::Duration{400});
+    }
+    requireSameGame(batch, 1, reference);
+
+    // Restarting one game leaves the others alone
+    const auto before = batch.lockedPieces(2);
+    batch.start(0, 5);
+    REQUIRE(batch.lockedPieces(0) == 0);
+    REQUIRE(batch.lockedPieces(2) == before);
+    REQUIRE(batch.rowData()[BatchSimulator::Rows - 1] == 0);
+}
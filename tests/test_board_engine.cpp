@@ -0,0 +1,582 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "core/Board.hpp"
+#include "core/Tetromino.hpp"
+#include "core/Types.hpp"
+
+using namespace tetris::core;
+
+// ----------------------------
+// Reference implementation
+// ----------------------------
+
+// Straightforward cell-by-cell board (the original Board implementation),
+// kept here as an oracle for the packed engine.
+namespace {
+
+class ReferenceBoard {
+public:
+    ReferenceBoard(int rows, int cols)
+        : rows_{rows}
+        , cols_{cols}
+        , grid_(rows * cols, CellState::Empty)
+        , typeGrid_(rows * cols, std::nullopt)
+    {
+    }
+
+    CellState cell(int row, int col) const { return grid_[index(row, col)]; }
+    std::optional<TetrominoType> cellType(int row, int col) const { return typeGrid_[index(row, col)]; }
+
+    void setCell(int row, int col, CellState state) {
+        grid_[index(row, col)] = state;
+        if (state == CellState::Empty) {
+            typeGrid_[index(row, col)] = std::nullopt;
+        }
+    }
+
+    bool canPlace(const Tetromino& tetromino) const {
+        for (const auto& b : tetromino.blocks()) {
+            if (!isInside(b.row, b.col)) return false;
+            if (grid_[index(b.row, b.col)] == CellState::Filled) return false;
+        }
+        return true;
+    }
+
+    void lockTetromino(const Tetromino& tetromino) {
+        for (const auto& b : tetromino.blocks()) {
+            if (isInside(b.row, b.col)) {
+                grid_[index(b.row, b.col)] = CellState::Filled;
+                typeGrid_[index(b.row, b.col)] = tetromino.type();
+            }
+        }
+    }
+
+    // Step the piece down one row at a time until it no longer fits.
+    int dropDistance(Tetromino t) const {
+        if (!canPlace(t)) return 0;
+        int distance = 0;
+        while (true) {
+            Position p = t.origin();
+            t.setOrigin(Position{p.row + 1, p.col});
+            if (!canPlace(t)) return distance;
+            ++distance;
+        }
+    }
+
+    int columnHeight(int col) const {
+        for (int r = 0; r < rows_; ++r) {
+            if (grid_[index(r, col)] == CellState::Filled) return rows_ - r;
+        }
+        return 0;
+    }
+
+    int clearFullLines() {
+        int cleared = 0;
+        for (int row = rows_ - 1; row >= 0; --row) {
+            bool full = true;
+            for (int col = 0; col < cols_; ++col) {
+                if (grid_[index(row, col)] == CellState::Empty) {
+                    full = false;
+                    break;
+                }
+            }
+            if (full) {
+                for (int r = row; r > 0; --r) {
+                    for (int c = 0; c < cols_; ++c) {
+                        grid_[index(r, c)] = grid_[index(r - 1, c)];
+                        typeGrid_[index(r, c)] = typeGrid_[index(r - 1, c)];
+                    }
+                }
+                for (int c = 0; c < cols_; ++c) {
+                    grid_[index(0, c)] = CellState::Empty;
+                    typeGrid_[index(0, c)] = std::nullopt;
+                }
+                ++cleared;
+                ++row;
+            }
+        }
+        return cleared;
+    }
+
+    bool isGameOver() const {
+        for (int col = 0; col < cols_; ++col) {
+            if (grid_[index(0, col)] == CellState::Filled) return true;
+        }
+        return false;
+    }
+
+private:
+    int rows_;
+    int cols_;
+    std::vector<CellState> grid_;
+    std::vector<std::optional<TetrominoType>> typeGrid_;
+
+    int index(int row, int col) const { return row * cols_ + col; }
+    bool isInside(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+};
+
+template <typename BoardT>
+void requireSameCells(const BoardT& board, const ReferenceBoard& ref, int rows, int cols)
+{
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            REQUIRE(board.cell(r, c) == ref.cell(r, c));
+            REQUIRE(board.cellType(r, c) == ref.cellType(r, c));
+        }
+    }
+}
+
+template <typename BoardT>
+void requireSameSkyline(const BoardT& board, const ReferenceBoard& ref, int cols)
+{
+    for (int c = 0; c < cols; ++c) {
+        REQUIRE(board.columnHeight(c) == ref.columnHeight(c));
+    }
+}
+
+// Emptying a copy cell by cell must take the incremental hash back to 0;
+// any drift in the per-cell / per-clear updates would leave a residue.
+template <typename BoardT>
+void requireHashUnwindsToZero(const BoardT& board)
+{
+    BoardT copy = board;
+    for (int r = 0; r < copy.rows(); ++r) {
+        for (int c = 0; c < copy.cols(); ++c) {
+            copy.setCell(r, c, CellState::Empty);
+        }
+    }
+    REQUIRE(copy.hash() == 0);
+}
+
+Tetromino randomPiece(std::mt19937& rng, int rows, int cols)
+{
+    std::uniform_int_distribution<int> typeDist(0, 6);
+    std::uniform_int_distribution<int> rotDist(0, 3);
+    std::uniform_int_distribution<int> rowDist(-2, rows + 1);
+    std::uniform_int_distribution<int> colDist(-2, cols + 1);
+    return Tetromino{
+        static_cast<TetrominoType>(typeDist(rng)),
+        static_cast<Rotation>(rotDist(rng)),
+        Position{rowDist(rng), colDist(rng)}
+    };
+}
+
+// The original switch-based shape definitions, used to check the
+// compile-time tables.
+Tetromino::Shape referenceShape(TetrominoType type, Rotation rotation)
+{
+    using S = Tetromino::Shape;
+    const bool flat = rotation == Rotation::R0 || rotation == Rotation::R180;
+
+    switch (type) {
+    case TetrominoType::I:
+        return flat ? S{{ {0, -1}, {0, 0}, {0, 1}, {0, 2} }}
+                    : S{{ {-1, 0}, {0, 0}, {1, 0}, {2, 0} }};
+    case TetrominoType::O:
+        return S{{ {0, 0}, {0, 1}, {1, 0}, {1, 1} }};
+    case TetrominoType::T:
+        switch (rotation) {
+        case Rotation::R0:   return S{{ {0, -1}, {0, 0}, {0, 1}, {1, 0} }};
+        case Rotation::R90:  return S{{ {-1, 0}, {0, 0}, {1, 0}, {0, 1} }};
+        case Rotation::R180: return S{{ {0, -1}, {0, 0}, {0, 1}, {-1, 0} }};
+        case Rotation::R270: return S{{ {-1, 0}, {0, 0}, {1, 0}, {0, -1} }};
+        }
+        break;
+    case TetrominoType::L:
+        switch (rotation) {
+        case Rotation::R0:   return S{{ {0, -1}, {0, 0}, {0, 1}, {1, 1} }};
+        case Rotation::R90:  return S{{ {-1, 0}, {0, 0}, {1, 0}, {1, -1} }};
+        case Rotation::R180: return S{{ {0, -1}, {0, 0}, {0, 1}, {-1, -1} }};
+        case Rotation::R270: return S{{ {-1, 0}, {0, 0}, {1, 0}, {-1, 1} }};
+        }
+        break;
+    case TetrominoType::J:
+        switch (rotation) {
+        case Rotation::R0:   return S{{ {0, -1}, {0, 0}, {0, 1}, {1, -1} }};
+        case Rotation::R90:  return S{{ {-1, 0}, {0, 0}, {1, 0}, {-1, -1} }};
+        case Rotation::R180: return S{{ {0, -1}, {0, 0}, {0, 1}, {-1, 1} }};
+        case Rotation::R270: return S{{ {-1, 0}, {0, 0}, {1, 0}, {1, 1} }};
+        }
+        break;
+    case TetrominoType::S:
+        return flat ? S{{ {0, 0}, {0, 1}, {1, -1}, {1, 0} }}
+                    : S{{ {-1, 0}, {0, 0}, {0, 1}, {1, 1} }};
+    case TetrominoType::Z:
+        return flat ? S{{ {0, -1}, {0, 0}, {1, 0}, {1, 1} }}
+                    : S{{ {-1, 1}, {0, 0}, {0, 1}, {1, 0} }};
+    }
+    return S{};
+}
+
+} // namespace
+
+// ============================
+// Differential tests
+// ============================
+
+TEST_CASE("BoardEngine: packed board matches the reference board", "[board][engine][differential]")
+{
+    struct Dims { int rows; int cols; };
+    const Dims dims[] = { {20, 10}, {4, 4}, {12, 7}, {6, 32} };
+
+    for (const auto& d : dims) {
+        std::mt19937 rng(1234u + static_cast<unsigned>(d.rows * 100 + d.cols));
+        std::uniform_int_distribution<int> opDist(0, 9);
+        std::uniform_int_distribution<int> rDist(0, d.rows - 1);
+        std::uniform_int_distribution<int> cDist(0, d.cols - 1);
+
+        Board board{d.rows, d.cols};
+        ReferenceBoard ref{d.rows, d.cols};
+
+        for (int step = 0; step < 4000; ++step) {
+            const int op = opDist(rng);
+            if (op <= 5) {
+                // Mostly lock pieces that fit, like real gameplay does.
+                const Tetromino t = randomPiece(rng, d.rows, d.cols);
+                const bool fits = ref.canPlace(t);
+                REQUIRE(board.canPlace(t) == fits);
+                REQUIRE(board.dropDistance(t) == ref.dropDistance(t));
+                if (fits) {
+                    board.lockTetromino(t);
+                    ref.lockTetromino(t);
+                }
+            } else if (op <= 7) {
+                const int r = rDist(rng);
+                const int c = cDist(rng);
+                const auto state = (op == 6) ? CellState::Filled : CellState::Empty;
+                board.setCell(r, c, state);
+                ref.setCell(r, c, state);
+            } else {
+                // Occasionally fill a row so clears actually happen.
+                if (op == 9) {
+                    const int r = rDist(rng);
+                    for (int c = 0; c < d.cols; ++c) {
+                        board.setCell(r, c, CellState::Filled);
+                        ref.setCell(r, c, CellState::Filled);
+                    }
+                }
+                REQUIRE(board.clearFullLines() == ref.clearFullLines());
+            }
+
+            REQUIRE(board.isGameOver() == ref.isGameOver());
+            requireSameSkyline(board, ref, d.cols);
+            if (step % 97 == 0) {
+                requireSameCells(board, ref, d.rows, d.cols);
+                requireHashUnwindsToZero(board);
+            }
+        }
+
+        requireSameCells(board, ref, d.rows, d.cols);
+    }
+}
+
+TEST_CASE("BoardEngine: row masks expose packed occupancy", "[board][engine]")
+{
+    Board b{4, 5};
+
+    CHECK(b.fullRowMask() == 0x1Fu);
+    CHECK(b.rowMask(3) == 0u);
+
+    b.setCell(3, 0, CellState::Filled);
+    b.setCell(3, 4, CellState::Filled);
+    CHECK(b.rowMask(3) == 0x11u);
+
+    b.setCell(3, 0, CellState::Empty);
+    CHECK(b.rowMask(3) == 0x10u);
+
+    CHECK_THROWS(Board{4, Board::MaxCols + 1});
+}
+
+TEST_CASE("BoardEngine: row views match the checked accessors", "[board][engine]")
+{
+    std::mt19937 rng(77u);
+    StandardBoard b{20, 10};
+    for (int i = 0; i < 40; ++i) {
+        const Tetromino t = randomPiece(rng, 20, 10);
+        if (b.canPlace(t)) b.lockTetromino(t);
+    }
+    b.setCell(19, 0, CellState::Filled); // filled, type unknown
+
+    for (int r = 0; r < b.rows(); ++r) {
+        const auto view = b.row(r);
+        REQUIRE(view.bits == b.rowMask(r));
+        REQUIRE(view.cols == b.cols());
+        for (int c = 0; c < b.cols(); ++c) {
+            REQUIRE(view.filled(c) == (b.cell(r, c) == CellState::Filled));
+            REQUIRE(view.type(c) == b.cellType(r, c));
+        }
+        // Rows are laid out back to back, so a full sweep is linear
+        if (r + 1 < b.rows()) {
+            REQUIRE(b.row(r + 1).codes == view.codes + b.cols());
+        }
+    }
+}
+
+// ============================
+// Shape tables
+// ============================
+
+static_assert(shapeInfo(TetrominoType::I, Rotation::R0).width == 4, "I is 4 wide when flat");
+static_assert(shapeInfo(TetrominoType::I, Rotation::R90).height == 4, "I is 4 tall when upright");
+static_assert(shapeInfo(TetrominoType::O, Rotation::R0).rowMasks[0] == 0b11, "O covers two columns");
+
+TEST_CASE("BoardEngine: shape tables match the reference shapes", "[tetromino][engine][tables]")
+{
+    for (int t = 0; t < 7; ++t) {
+        for (int r = 0; r < 4; ++r) {
+            const auto type = static_cast<TetrominoType>(t);
+            const auto rot  = static_cast<Rotation>(r);
+            const ShapeInfo& info = shapeInfo(type, rot);
+            const Tetromino::Shape ref = referenceShape(type, rot);
+
+            // Offsets are identical, in the same order
+            for (int i = 0; i < Tetromino::BlockCount; ++i) {
+                REQUIRE(info.blocks[i].row == ref[i].row);
+                REQUIRE(info.blocks[i].col == ref[i].col);
+            }
+
+            // Tetromino::blocks() applies the origin to the table offsets
+            const Tetromino piece{type, rot, Position{5, 4}};
+            const auto abs = piece.blocks();
+            for (int i = 0; i < Tetromino::BlockCount; ++i) {
+                REQUIRE(abs[i].row == ref[i].row + 5);
+                REQUIRE(abs[i].col == ref[i].col + 4);
+            }
+
+            // Bounding box, row masks and column profiles derived by brute force
+            int minR = ref[0].row, maxR = ref[0].row, minC = ref[0].col, maxC = ref[0].col;
+            for (const auto& b : ref) {
+                minR = std::min(minR, b.row); maxR = std::max(maxR, b.row);
+                minC = std::min(minC, b.col); maxC = std::max(maxC, b.col);
+            }
+            REQUIRE(info.minRow == minR);
+            REQUIRE(info.maxRow == maxR);
+            REQUIRE(info.minCol == minC);
+            REQUIRE(info.maxCol == maxC);
+            REQUIRE(info.height == maxR - minR + 1);
+            REQUIRE(info.width == maxC - minC + 1);
+
+            for (int i = 0; i < info.height; ++i) {
+                unsigned mask = 0;
+                for (const auto& b : ref) {
+                    if (b.row == minR + i) mask |= 1U << (b.col - minC);
+                }
+                REQUIRE(info.rowMasks[i] == mask);
+            }
+
+            for (int j = 0; j < info.width; ++j) {
+                int bottom = minR - 1;
+                int top = maxR + 1;
+                for (const auto& b : ref) {
+                    if (b.col == minC + j) {
+                        bottom = std::max(bottom, b.row);
+                        top = std::min(top, b.row);
+                    }
+                }
+                REQUIRE(info.colBottom[j] == bottom);
+                REQUIRE(info.colTop[j] == top);
+            }
+        }
+    }
+}
+
+TEST_CASE("BoardEngine: drop distance sees through overhangs", "[board][engine][skyline]")
+{
+    Board board{8, 4};
+
+    // Overhang on row 2 over columns 0-1, one floor cell at the bottom of column 1
+    board.setCell(2, 0, CellState::Filled);
+    board.setCell(2, 1, CellState::Filled);
+    board.setCell(7, 1, CellState::Filled);
+    REQUIRE(board.columnHeight(0) == 6);
+    REQUIRE(board.columnHeight(1) == 6);
+    REQUIRE(board.columnHeight(2) == 0);
+
+    // Vertical I tucked under the overhang (rows 3..6) still falls one row
+    Tetromino under{TetrominoType::I, Rotation::R90, Position{4, 0}};
+    REQUIRE(board.canPlace(under));
+    REQUIRE(board.dropDistance(under) == 1);
+
+    // Next to it the floor cell stops it right away
+    under.setOrigin(Position{4, 1});
+    REQUIRE(board.canPlace(under));
+    REQUIRE(board.dropDistance(under) == 0);
+
+    // Above the skyline, a flat I lands on the overhang
+    Tetromino above{TetrominoType::I, Rotation::R0, Position{0, 1}};
+    REQUIRE(board.dropDistance(above) == 1);
+
+    // Removing the overhang lowers the skyline again
+    board.setCell(2, 0, CellState::Empty);
+    board.setCell(2, 1, CellState::Empty);
+    REQUIRE(board.columnHeight(0) == 0);
+    REQUIRE(board.columnHeight(1) == 1);
+    REQUIRE(board.dropDistance(above) == 6);
+}
+
+// ============================
+// Fixed-size board
+// ============================
+
+static_assert(std::is_trivially_copyable_v<StandardBoard>,
+              "StandardBoard keeps all of its state inline");
+static_assert(sizeof(StandardBoard) <= 20 * sizeof(StandardBoard::RowMask)  // occupancy
+                                     + 20 * 10                              // one byte per cell
+                                     + 10 * sizeof(int)                     // skyline
+                                     + 20 * sizeof(StandardBoard::Epoch)    // dirty rows
+                                     + 20 * sizeof(StandardBoard::Hash)     // row hashes
+                                     + sizeof(StandardBoard::Hash)
+                                     + 3 * sizeof(int),
+              "StandardBoard stores one byte of type data per cell");
+
+static_assert(BoardTypes::decodeType(BoardTypes::NoType) == std::nullopt);
+static_assert(BoardTypes::decodeType(BoardTypes::encodeType(TetrominoType::Z)) == TetrominoType::Z);
+
+TEST_CASE("BoardEngine: fixed-size board matches the dynamic board", "[board][engine][differential]")
+{
+    std::mt19937 rng(4242u);
+    std::uniform_int_distribution<int> opDist(0, 9);
+    std::uniform_int_distribution<int> rDist(0, 19);
+    std::uniform_int_distribution<int> cDist(0, 9);
+
+    StandardBoard fixed{20, 10};
+    Board dynamic{20, 10};
+    ReferenceBoard ref{20, 10};
+
+    for (int step = 0; step < 3000; ++step) {
+        const int op = opDist(rng);
+        if (op <= 6) {
+            const Tetromino t = randomPiece(rng, 20, 10);
+            REQUIRE(fixed.canPlace(t) == dynamic.canPlace(t));
+            REQUIRE(fixed.dropDistance(t) == dynamic.dropDistance(t));
+            if (fixed.canPlace(t)) {
+                fixed.lockTetromino(t);
+                dynamic.lockTetromino(t);
+                ref.lockTetromino(t);
+            }
+        } else if (op <= 8) {
+            const int r = rDist(rng);
+            const int c = cDist(rng);
+            fixed.setCell(r, c, CellState::Empty);
+            dynamic.setCell(r, c, CellState::Empty);
+            ref.setCell(r, c, CellState::Empty);
+        } else {
+            const auto a = fixed.clearLines();
+            const auto b = dynamic.clearLines();
+            REQUIRE(a.count == b.count);
+            REQUIRE(a.rows == b.rows);
+            ref.clearFullLines();
+        }
+        requireSameSkyline(fixed, ref, 10);
+    }
+
+    requireSameCells(fixed, ref, 20, 10);
+
+    fixed.clear();
+    for (int c = 0; c < 10; ++c) {
+        REQUIRE(fixed.columnHeight(c) == 0);
+        REQUIRE(fixed.rowMask(19) == 0);
+    }
+}
+
+TEST_CASE("BoardEngine: fixed-size board rejects other dimensions", "[board][engine]")
+{
+    CHECK_THROWS_AS((StandardBoard{20, 11}), std::invalid_argument);
+    CHECK_THROWS_AS((StandardBoard{10, 10}), std::invalid_argument);
+    CHECK_NOTHROW(StandardBoard{20, 10});
+}
+
+// ============================
+// Dirty rows
+// ============================
+
+TEST_CASE("BoardEngine: dirty rows follow every mutation", "[board][engine][dirty]")
+{
+    Board b{8, 4};
+    const Board::RowSet allRows = 0xFFu;
+
+    // A fresh board is entirely dirty for a consumer that never synced
+    REQUIRE(b.dirtyRowsSince(0) == allRows);
+
+    // Two consumers sync at different times
+    const auto renderer = b.epoch();
+    REQUIRE(b.dirtyRowsSince(renderer) == 0);
+
+    b.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{6, 0}});
+    const auto network = b.epoch();
+    CHECK(b.dirtyRowsSince(renderer) == ((1u << 6) | (1u << 7)));
+    CHECK(b.dirtyRowsSince(network) == 0);
+
+    b.setCell(2, 3, CellState::Filled);
+    CHECK(b.dirtyRowsSince(network) == (1u << 2));
+    CHECK(b.dirtyRowsSince(renderer) == ((1u << 2) | (1u << 6) | (1u << 7)));
+
+    // Clearing row 7 shifts everything above it
+    const auto beforeClear = b.epoch();
+    b.setCell(7, 2, CellState::Filled);
+    b.setCell(7, 3, CellState::Filled);
+    REQUIRE(b.clearLines().count == 1);
+    CHECK(b.dirtyRowsSince(beforeClear) == allRows);
+
+    // No-op clear does not dirty anything
+    const auto afterClear = b.epoch();
+    REQUIRE(b.clearLines().count == 0);
+    CHECK(b.dirtyRowsSince(afterClear) == 0);
+
+    b.clear();
+    CHECK(b.dirtyRowsSince(afterClear) == allRows);
+}
+
+// ============================
+// Board hash
+// ============================
+
+TEST_CASE("BoardEngine: hash depends only on board contents", "[board][engine][hash]")
+{
+    const Tetromino t{TetrominoType::T, Rotation::R0, Position{3, 1}};
+    const Tetromino flatI{TetrominoType::I, Rotation::R0, Position{5, 1}};
+
+    Board empty{6, 4};
+    CHECK(empty.hash() == 0);
+
+    // Order of locks does not matter
+    Board a{6, 4};
+    a.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 0}});
+    a.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 2}});
+    Board b{6, 4};
+    b.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 2}});
+    b.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 0}});
+    CHECK(a.hash() == b.hash());
+    CHECK(a.hash() != 0);
+
+    // Type matters, not only occupancy
+    Board c{6, 4};
+    c.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 0}});
+    c.lockTetromino(Tetromino{TetrominoType::O, Rotation::R0, Position{4, 2}});
+    c.setCell(5, 3, CellState::Empty);
+    CHECK(c.hash() != a.hash());
+    c.setCell(5, 3, CellState::Filled); // filled again, but with unknown type
+    CHECK(c.hash() != a.hash());
+
+    // A line clear lands on the same hash as building the result directly
+    Board cleared{6, 4};
+    cleared.lockTetromino(flatI);
+    cleared.lockTetromino(t);
+    REQUIRE(cleared.clearLines().count == 1);
+
+    Board direct{6, 4};
+    direct.lockTetromino(Tetromino{TetrominoType::T, Rotation::R0, Position{4, 1}});
+    CHECK(cleared.hash() == direct.hash());
+
+    cleared.clear();
+    CHECK(cleared.hash() == 0);
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/Board.hpp"
+#include "core/BoardKernels.hpp"
+#include "core/Tetromino.hpp"
+
+using namespace tetris::core;
+
+namespace {
+
+using RowBits = BatchSimulator::RowBits;
+constexpr int Rows = BatchSimulator::Rows;
+constexpr int Cols = BatchSimulator::Cols;
+
+// Random boards in BatchSimulator layout; some rows are full, and the top
+// of each board is left sparse so pieces fit somewhere.
+std::vector<RowBits> randomBoards(std::size_t count, std::mt19937& rng) {
+    std::vector<RowBits> rows(count * Rows);
+    std::uniform_int_distribution<int> pct{0, 99};
+    std::uniform_int_distribution<int> bits{0, BatchSimulator::FullRow};
+    for (std::size_t b = 0; b < count; ++b) {
+        const int top = pct(rng) % Rows;
+        for (int r = top; r < Rows; ++r) {
+            const int roll = pct(rng);
+            rows[b * Rows + r] = roll < 20 ? BatchSimulator::FullRow
+                               : roll < 30 ? RowBits{0}
+                               : static_cast<RowBits>(bits(rng));
+        }
+    }
+    return rows;
+}
+
+StandardBoard toBoard(const RowBits* rows) {
+    StandardBoard board{Rows, Cols};
+    for (int r = 0; r < Rows; ++r) {
+        for (int c = 0; c < Cols; ++c) {
+            if ((rows[r] >> c) & 1U) {
+                board.setCell(r, c, CellState::Filled);
+            }
+        }
+    }
+    return board;
+}
+
+std::vector<KernelIsa> availableIsas() {
+    std::vector<KernelIsa> isas;
+    for (KernelIsa isa : {KernelIsa::Scalar, KernelIsa::SSE2, KernelIsa::AVX2}) {
+        if (kernelIsaAvailable(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+} // namespace
+
+TEST_CASE("BoardKernels: scalar is always available and best is available", "[kernels]") {
+    REQUIRE(kernelIsaAvailable(KernelIsa::Scalar));
+    REQUIRE(kernelIsaAvailable(bestKernelIsa()));
+}
+
+TEST_CASE("BoardKernels: every ISA matches Board on random boards", "[kernels]") {
+    std::mt19937 rng{2024};
+
+    // Counts around the 4- and 16-board group sizes exercise the tails
+    for (std::size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 15u, 16u, 17u, 37u, 100u}) {
+        const auto rows = randomBoards(count, rng);
+        std::vector<StandardBoard> boards;
+        for (std::size_t b = 0; b < count; ++b) {
+            boards.push_back(toBoard(rows.data() + b * Rows));
+        }
+
+        for (KernelIsa isa : availableIsas()) {
+            std::vector<std::uint32_t> full(count);
+            batchFullRows(rows.data(), count, full.data(), isa);
+
+            std::vector<std::uint8_t> heights(count * Cols);
+            batchColumnHeights(rows.data(), count, heights.data(), isa);
+
+            for (std::size_t b = 0; b < count; ++b) {
+                std::uint32_t expected = 0;
+                for (int r = 0; r < Rows; ++r) {
+                    if (boards[b].rowMask(r) == boards[b].fullRowMask()) {
+                        expected |= std::uint32_t{1} << r;
+                    }
+                }
+                REQUIRE(full[b] == expected);
+                for (int c = 0; c < Cols; ++c) {
+                    REQUIRE(heights[b * Cols + c] == boards[b].columnHeight(c));
+                }
+            }
+
+            std::vector<std::uint8_t> hits(count);
+            for (int type = 0; type < 7; ++type) {
+                for (int rot = 0; rot < 4; ++rot) {
+                    for (int row = -2; row < Rows + 1; row += 3) {
+                        for (int col = -1; col <= Cols; ++col) {
+                            const Tetromino piece{static_cast<TetrominoType>(type),
+                                                  static_cast<Rotation>(rot), Position{row, col}};
+                            batchCollisions(rows.data(), count, piece, hits.data(), isa);
+                            for (std::size_t b = 0; b < count; ++b) {
+                                REQUIRE((hits[b] != 0) == !boards[b].canPlace(piece));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "controller/BotPlayer.hpp"
+#include "controller/GameController.hpp"
+#include "core/GameState.hpp"
+
+using namespace tetris::core;
+using namespace tetris::controller;
+
+namespace {
+
+BotConfig unhurriedConfig() {
+    BotConfig config;
+    config.thinkBudget = std::chrono::seconds{5};
+    config.placementInterval = std::chrono::milliseconds{0};
+    return config;
+}
+
+// Plays `pieces` pieces and records every plan.
+std::vector<std::vector<InputAction>> playSeeded(BotPlayer& bot, std::uint64_t seed, int pieces,
+                                                 GameState& game) {
+    GameController controller{game};
+    game.setSeed(seed);
+    game.start();
+
+    std::vector<std::vector<InputAction>> plans;
+    std::vector<InputAction> inputs;
+    for (int i = 0; i < pieces && game.status() == GameStatus::Running; ++i) {
+        REQUIRE(bot.plan(game, inputs));
+        plans.push_back(inputs);
+        REQUIRE(bot.playPiece(game, controller));
+    }
+    return plans;
+}
+
+} // namespace
+
+TEST_CASE("BotPlayer: survives a long seeded game and clears lines", "[bot]") {
+    BotWorkerPool pool{2};
+    BotPlayer bot{unhurriedConfig(), &pool};
+    GameState game;
+    playSeeded(bot, 42, 300, game);
+
+    REQUIRE(game.status() == GameStatus::Running);
+    REQUIRE(game.lockedPieces() == 300);
+    REQUIRE(game.score() > 0);
+    REQUIRE(bot.lastSearchDepth() == 2);
+}
+
+TEST_CASE("BotPlayer: worker pool does not change the chosen moves", "[bot]") {
+    BotPlayer serial{unhurriedConfig()};
+    BotWorkerPool pool{3};
+    BotPlayer parallel{unhurriedConfig(), &pool};
+
+    GameState a;
+    GameState b;
+    REQUIRE(playSeeded(serial, 7, 60, a) == playSeeded(parallel, 7, 60, b));
+    REQUIRE(a.board().hash() == b.board().hash());
+}
+
+TEST_CASE("BotPlayer: exhausted think budget still yields a move", "[bot]") {
+    BotConfig config;
+    config.thinkBudget = std::chrono::microseconds{0};
+    config.lookahead = 3;
+    BotPlayer bot{config};
+
+    GameState game;
+    game.setSeed(1);
+    game.start();
+
+    std::vector<InputAction> inputs;
+    REQUIRE(bot.plan(game, inputs));
+    REQUIRE(bot.lastSearchDepth() == 1);
+    REQUIRE_FALSE(inputs.empty());
+    REQUIRE(inputs.back() == InputAction::HardDrop);
+}
+
+TEST_CASE("BotPlayer: update paces placements by placementInterval", "[bot]") {
+    BotConfig config;
+    config.placementInterval = std::chrono::milliseconds{100};
+    BotPlayer bot{config};
+
+    GameState game;
+    GameController controller{game};
+    game.setSeed(3);
+    game.start();
+
+    REQUIRE_FALSE(bot.update(game, controller, std::chrono::milliseconds{60}));
+    REQUIRE(game.lockedPieces() == 0);
+    REQUIRE(bot.update(game, controller, std::chrono::milliseconds{60}));
+    REQUIRE(game.lockedPieces() == 1);
+
+    // A long stall places one piece, not a burst
+    REQUIRE(bot.update(game, controller, std::chrono::milliseconds{1000}));
+    REQUIRE(game.lockedPieces() == 2);
+
+    game.pause();
+    REQUIRE_FALSE(bot.update(game, controller, std::chrono::milliseconds{1000}));
+}
+
+TEST_CASE("BotWorkerPool: runs every index exactly once", "[bot]") {
+    BotWorkerPool pool{4};
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> hits(97, 0);
+        std::atomic<bool> badSlot{false};
+        pool.parallelFor(hits.size(), [&](std::size_t i, std::size_t slot) {
+            if (slot >= pool.slotCount()) {
+                badSlot = true;
+            }
+            ++hits[i];
+        });
+        REQUIRE_FALSE(badSlot);
+        for (int h : hits) {
+            REQUIRE(h == 1);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "network/ClientPredictor.hpp"
+#include "core/GameState.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+using namespace tetris::net;
+using tetris::controller::InputAction;
+using tetris::core::GameState;
+using tetris::core::Span;
+
+namespace {
+
+std::vector<std::uint8_t> snapshotOf(const GameState& game)
+{
+    std::vector<std::uint8_t> bytes(game.snapshotSize());
+    game.saveSnapshot(Span<std::uint8_t>{bytes.data(), bytes.size()});
+    return bytes;
+}
+
+Span<const std::uint8_t> view(const std::vector<std::uint8_t>& bytes)
+{
+    return Span<const std::uint8_t>{bytes.data(), bytes.size()};
+}
+
+} // namespace
+
+TEST_CASE("Client prediction: inputs apply before the host answers", "[network][prediction]")
+{
+    ClientPredictor predictor;
+    predictor.reset(42);
+    const int startCol = predictor.game().activeTetromino()->origin().col;
+
+    predictor.applyLocal(InputAction::MoveLeft, 0);
+    CHECK(predictor.game().activeTetromino()->origin().col == startCol - 1);
+    CHECK(predictor.pendingInputs() == 1);
+}
+
+TEST_CASE("Client prediction: reconcile replays unacknowledged inputs", "[network][prediction]")
+{
+    ClientPredictor predictor;
+    predictor.reset(7);
+
+    // Host copy of the same game
+    GameState host;
+    host.setSeed(7);
+    host.start();
+    tetris::controller::GameController hostCtrl(host);
+
+    const InputAction inputs[] = {
+        InputAction::MoveLeft, InputAction::HardDrop, InputAction::RotateCW,
+        InputAction::MoveRight, InputAction::HardDrop, InputAction::MoveLeft
+    };
+    for (Tick t = 0; t < 6; ++t) {
+        predictor.applyLocal(inputs[t], t);
+    }
+
+    // The host has applied the first three
+    for (Tick t = 0; t < 3; ++t) {
+        hostCtrl.handleAction(inputs[t]);
+    }
+    REQUIRE(predictor.reconcile(view(snapshotOf(host)), Tick{2}));
+    CHECK(predictor.pendingInputs() == 3);
+    CHECK(predictor.corrections() == 0);
+
+    for (Tick t = 3; t < 6; ++t) {
+        hostCtrl.handleAction(inputs[t]);
+    }
+    CHECK(snapshotOf(predictor.game()) == snapshotOf(host));
+
+    // Everything acknowledged
+    REQUIRE(predictor.reconcile(view(snapshotOf(host)), Tick{5}));
+    CHECK(predictor.pendingInputs() == 0);
+    CHECK(snapshotOf(predictor.game()) == snapshotOf(host));
+}
+
+TEST_CASE("Client prediction: host state wins when it differs", "[network][prediction]")
+{
+    ClientPredictor predictor;
+    predictor.reset(11);
+    predictor.applyLocal(InputAction::MoveRight, 0);
+
+    // Host applied the input, then a gravity tick the client did not predict
+    GameState host;
+    host.setSeed(11);
+    host.start();
+    tetris::controller::GameController hostCtrl(host);
+    hostCtrl.handleAction(InputAction::MoveRight);
+    host.tick();
+
+    REQUIRE(predictor.reconcile(view(snapshotOf(host)), Tick{0}));
+    CHECK(predictor.corrections() == 1);
+    CHECK(predictor.game().activeTetromino()->origin().row == host.activeTetromino()->origin().row);
+
+    // Bad snapshots are rejected and leave the prediction alone
+    const auto before = snapshotOf(predictor.game());
+    std::vector<std::uint8_t> corrupt(8, 0xAB);
+    CHECK_FALSE(predictor.reconcile(view(corrupt), Tick{0}));
+    CHECK(snapshotOf(predictor.game()) == before);
+}
+
+TEST_CASE("Client prediction: reconcile replays gravity since the snapshot", "[network][prediction]")
+{
+    using Duration = ClientPredictor::Duration;
+    constexpr Duration kFrame{16};
+
+    ClientPredictor predictor;
+    predictor.reset(3);
+    GameState host;
+    host.setSeed(3);
+    host.start();
+    tetris::controller::GameController hostCtrl(host);
+    const int startRow = host.activeTetromino()->origin().row;
+
+    // Client: MoveLeft at 0 ms, MoveRight at 960 ms, now at 1920 ms
+    predictor.applyLocal(InputAction::MoveLeft, 0);
+    for (int i = 0; i < 60; ++i) predictor.update(kFrame);
+    predictor.applyLocal(InputAction::MoveRight, 1);
+    for (int i = 0; i < 60; ++i) predictor.update(kFrame);
+    REQUIRE(predictor.game().activeTetromino()->origin().row > startRow);
+
+    // Host: applied MoveLeft, then ran 480 ms of gravity before the snapshot
+    hostCtrl.handleAction(InputAction::MoveLeft);
+    for (int i = 0; i < 30; ++i) hostCtrl.update(kFrame);
+    const SnapshotTimingDTO early{ 480u, static_cast<std::uint32_t>(hostCtrl.accumulatedTime().count()) };
+    const auto earlySnapshot = snapshotOf(host);
+
+    const auto predicted = snapshotOf(predictor.game());
+    REQUIRE(predictor.reconcile(view(earlySnapshot), Tick{0}, early));
+    CHECK(predictor.corrections() == 0);
+    CHECK(snapshotOf(predictor.game()) == predicted);
+
+    // A later snapshot, after the host applied MoveRight, changes nothing either
+    for (int i = 30; i < 60; ++i) hostCtrl.update(kFrame);
+    hostCtrl.handleAction(InputAction::MoveRight);
+    for (int i = 0; i < 20; ++i) hostCtrl.update(kFrame);
+    const SnapshotTimingDTO late{ 320u, static_cast<std::uint32_t>(hostCtrl.accumulatedTime().count()) };
+    REQUIRE(predictor.reconcile(view(snapshotOf(host)), Tick{1}, late));
+    CHECK(predictor.corrections() == 0);
+    CHECK(predictor.pendingInputs() == 0);
+    CHECK(snapshotOf(predictor.game()) == predicted);
+
+    // Without the timing the piece snaps back up to where the host saw it
+    ClientPredictor untimed;
+    untimed.reset(3);
+    untimed.applyLocal(InputAction::MoveLeft, 0);
+    for (int i = 0; i < 120; ++i) untimed.update(kFrame);
+    REQUIRE(untimed.reconcile(view(earlySnapshot), Tick{0}));
+    CHECK(untimed.corrections() == 1);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "controller/FixedTimestep.hpp"
+#include "controller/GameController.hpp"
+#include "core/GameState.hpp"
+
+using tetris::controller::FixedTimestep;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::chrono::nanoseconds kSecond = 1s;
+
+// Feeds exactly `total` of real time as frames of `frame` (the last one
+// shorter), running every due tick.
+std::uint64_t runFor(FixedTimestep& clock, std::chrono::nanoseconds total, std::chrono::nanoseconds frame)
+{
+    std::uint64_t ran = 0;
+    for (std::chrono::nanoseconds t{0}; t < total; t += frame) {
+        clock.accumulate(std::min(frame, total - t));
+        while (clock.step()) ++ran;
+    }
+    return ran;
+}
+
+} // namespace
+
+TEST_CASE("FixedTimestep: tick count does not depend on the frame rate", "[controller][timestep]")
+{
+    FixedTimestep vsync60(240);
+    FixedTimestep vsync144(240);
+    FixedTimestep uneven(240);
+
+    // 3 seconds at 60 Hz and at 144 Hz
+    CHECK(runFor(vsync60, 3s, kSecond / 60) == 720);
+    CHECK(runFor(vsync144, 3s, kSecond / 144) == 720);
+
+    // Jittery frames that add up to 3 s
+    const std::chrono::nanoseconds frames[] = { 3ms, 17ms, 9ms, 21ms };
+    std::uint64_t ran = 0;
+    for (int i = 0; i < 240; ++i) {
+        uneven.accumulate(frames[i % 4]);
+        while (uneven.step()) ++ran;
+    }
+    CHECK(ran == 720);
+    CHECK(uneven.tick() == 720);
+    CHECK(uneven.elapsed() == 3000ms);
+    CHECK(uneven.droppedTicks() == 0);
+}
+
+TEST_CASE("FixedTimestep: millisecond tick lengths add up without drift", "[controller][timestep]")
+{
+    FixedTimestep clock(240);
+    clock.accumulate(10s);
+
+    std::int64_t sumMs = 0;
+    while (clock.pending() > 0) {
+        clock.step();
+        sumMs += clock.lastTickDuration().count();
+        CHECK((clock.lastTickDuration() == 4ms || clock.lastTickDuration() == 5ms));
+    }
+    CHECK(sumMs == clock.elapsed().count());
+    CHECK(clock.timeAt(240) == 1000ms);
+    CHECK(clock.timeAt(1) == 4ms);
+    CHECK(clock.timeAt(3) == 12ms);
+}
+
+TEST_CASE("FixedTimestep: catch-up is bounded and the rest is dropped", "[controller][timestep]")
+{
+    FixedTimestep clock(240, 24);
+
+    clock.accumulate(1s); // 240 ticks due
+    CHECK(clock.pending() == 24);
+    CHECK(clock.droppedTicks() == 216);
+
+    // Unconsumed ticks stay pending but never above the bound
+    clock.consume(4);
+    CHECK(clock.tick() == 4);
+    clock.accumulate(1s);
+    CHECK(clock.pending() == 24);
+
+    // A huge hitch does not overflow
+    clock.accumulate(std::chrono::hours{24 * 365});
+    CHECK(clock.pending() == 24);
+}
+
+TEST_CASE("FixedTimestep: alpha is the fraction of the next tick", "[controller][timestep]")
+{
+    auto clock = FixedTimestep::withPeriod(16ms);
+
+    clock.accumulate(40ms);
+    CHECK(clock.pending() == 2);
+    CHECK(clock.alpha() == 0.5f);
+
+    clock.consume(2);
+    CHECK(clock.elapsed() == 32ms);
+    CHECK(clock.alpha() == 0.5f);
+    CHECK_FALSE(clock.step());
+
+    clock.reset();
+    CHECK(clock.tick() == 0);
+    CHECK(clock.pending() == 0);
+    CHECK(clock.alpha() == 0.0f);
+}
+
+TEST_CASE("FixedTimestep: gravity matches across frame rates", "[controller][timestep]")
+{
+    using tetris::controller::GameController;
+
+    auto play = [](std::chrono::nanoseconds frame) {
+        tetris::core::GameState game;
+        game.setSeed(12);
+        game.start();
+        GameController ctrl(game);
+        FixedTimestep clock;
+        const std::chrono::nanoseconds total = 5s;
+        for (std::chrono::nanoseconds t{0}; t < total; t += frame) {
+            clock.accumulate(std::min(frame, total - t));
+            while (clock.step()) ctrl.update(clock.lastTickDuration());
+        }
+        return game.activeTetromino()->origin().row;
+    };
+
+    const int row = play(kSecond / 60);
+    CHECK(row > 0);
+    CHECK(play(kSecond / 144) == row);
+    CHECK(play(kSecond / 30) == row);
+}
+
+TEST_CASE("FixedTimestep: alpha carries gravity progress between ticks", "[controller][timestep]")
+{
+    using tetris::controller::GameController;
+
+    tetris::core::GameState game;
+    game.start();
+    GameController ctrl(game);
+    const auto interval = std::chrono::milliseconds{game.gravityIntervalMs()};
+    REQUIRE(interval > 32ms);
+
+    auto clock = FixedTimestep::withPeriod(16ms);
+    clock.accumulate(40ms);
+    while (clock.step()) ctrl.update(clock.lastTickDuration());
+
+    const float simulated = ctrl.gravityProgress();
+    CHECK(simulated == 32.0f / interval.count());
+    const float drawn = ctrl.gravityProgress(clock.alpha() * clock.lastTickDuration());
+    CHECK(drawn == 40.0f / interval.count());
+
+    ctrl.update(interval);
+    CHECK(ctrl.gravityProgress() == simulated);
+    CHECK(ctrl.gravityProgress(interval * 2) == 1.0f);
+
+    game.pause();
+    CHECK(ctrl.gravityProgress() == 0.0f);
+}
@@ -1,6 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include "core/GameState.hpp"
+#include "controller/BotPlayer.hpp"
 #include "controller/GameController.hpp"
 #include "controller/InputAction.hpp"
 
@@ -180,3 +187,396 @@ TEST_CASE("GameplayLoop: reset clears score and returns to NotStarted", "[gamepl
     CHECK(game.score() == 0);
     CHECK_FALSE(game.activeTetromino().has_value());
 }
+
+TEST_CASE("GameplayLoop: custom board sizes run on DynamicGameState", "[gameplay][loop][board]")
+{
+    using tetris::core::DynamicGameState;
+    using tetris::controller::DynamicGameController;
+
+    DynamicGameState game{12, 6, 0};
+    DynamicGameController controller{game};
+    game.start();
+
+    REQUIRE(game.status() == GameStatus::Running);
+    CHECK(game.board().rows() == 12);
+    CHECK(game.board().cols() == 6);
+
+    // Hard drops on a small board end the game quickly and cleanly.
+    for (int i = 0; i < 200 && game.status() == GameStatus::Running; ++i) {
+        controller.handleAction(InputAction::HardDrop);
+    }
+    CHECK(game.status() == GameStatus::GameOver);
+
+    game.reset();
+    game.start();
+    REQUIRE(game.status() == GameStatus::Running);
+    CHECK(game.board().columnHeight(0) == 0);
+}
+
+TEST_CASE("GameplayLoop: fork copies a game into an arena and evolves independently", "[gameplay][fork]")
+{
+    using tetris::core::ForkArena;
+
+    GameState game{20, 10, 0};
+    game.setSeed(99);
+    game.start();
+    GameController controller{game};
+    for (int i = 0; i < 5; ++i) {
+        controller.handleAction(InputAction::MoveLeft);
+        controller.handleAction(InputAction::HardDrop);
+    }
+
+    alignas(GameState) unsigned char buffer[sizeof(GameState) * 3];
+    ForkArena arena{buffer, sizeof(buffer)};
+
+    GameState* fork = game.fork(arena);
+    REQUIRE(fork != nullptr);
+    CHECK(fork->board().hash() == game.board().hash());
+    CHECK(fork->score() == game.score());
+    CHECK(fork->lockedPieces() == game.lockedPieces());
+    CHECK(fork->activeTetromino()->type() == game.activeTetromino()->type());
+
+    // Same future pieces: the RNG and bag state were copied too
+    GameState* other = game.fork(arena);
+    REQUIRE(other != nullptr);
+    for (int i = 0; i < 20; ++i) {
+        fork->hardDrop();
+        other->hardDrop();
+        REQUIRE(fork->activeTetromino()->type() == other->activeTetromino()->type());
+    }
+    CHECK(fork->board().hash() == other->board().hash());
+    CHECK(game.lockedPieces() == 5); // the original is untouched
+
+    // Arena exhaustion is reported, reset makes room again
+    CHECK(game.fork(arena) != nullptr);
+    CHECK(game.fork(arena) == nullptr);
+    arena.reset();
+    CHECK(game.fork(arena) != nullptr);
+}
+
+TEST_CASE("GameplayLoop: snapshot round trip continues the game identically", "[gameplay][snapshot]")
+{
+    using tetris::core::Span;
+
+    GameState game{20, 10, 0};
+    game.setSeed(2024);
+    game.setPreviewDepth(3);
+    game.start();
+    GameController controller{game};
+    // Spread the pieces across the board so the game is still running
+    for (int i = 0; i < 12; ++i) {
+        const int shift = (i % 5 - 2) * 2;
+        for (int k = 0; k < (shift < 0 ? -shift : shift); ++k) {
+            controller.handleAction(shift < 0 ? InputAction::MoveLeft : InputAction::MoveRight);
+        }
+        controller.handleAction(InputAction::HardDrop);
+    }
+    controller.handleAction(InputAction::MoveRight);
+    REQUIRE(game.status() == GameStatus::Running);
+
+    std::array<std::uint8_t, GameState::MaxSnapshotBytes> buffer{};
+    const std::size_t size = game.saveSnapshot(Span<std::uint8_t>{buffer.data(), buffer.size()});
+    CHECK(size == game.snapshotSize());
+    CHECK(size < 200);
+
+    GameState restored{20, 10, 0};
+    restored.loadSnapshot(Span<const std::uint8_t>{buffer.data(), size});
+    CHECK(restored.board().hash() == game.board().hash());
+    CHECK(restored.score() == game.score());
+    CHECK(restored.level() == game.level());
+    CHECK(restored.lockedPieces() == game.lockedPieces());
+    CHECK(restored.status() == game.status());
+    CHECK(restored.previewDepth() == 3);
+    REQUIRE(restored.activeTetromino().has_value());
+    CHECK(restored.activeTetromino()->origin().col == game.activeTetromino()->origin().col);
+
+    // Same future: pieces, scores and boards stay in lockstep
+    GameController restoredController{restored};
+    for (int i = 0; i < 40; ++i) {
+        const InputAction action = (i % 3 == 0) ? InputAction::MoveRight : InputAction::HardDrop;
+        controller.handleAction(action);
+        restoredController.handleAction(action);
+        REQUIRE(restored.board().hash() == game.board().hash());
+        REQUIRE(restored.score() == game.score());
+        REQUIRE(restored.status() == game.status());
+    }
+}
+
+TEST_CASE("GameplayLoop: bad snapshots are rejected and leave the game unchanged", "[gameplay][snapshot]")
+{
+    using tetris::core::Span;
+
+    GameState game{20, 10, 0};
+    game.setSeed(5);
+    game.start();
+    game.hardDrop();
+
+    std::array<std::uint8_t, GameState::MaxSnapshotBytes> buffer{};
+    const std::size_t size = game.saveSnapshot(Span<std::uint8_t>{buffer.data(), buffer.size()});
+
+    GameState target{20, 10, 0};
+    target.setSeed(77);
+    target.start();
+    const auto hashBefore = target.board().hash();
+    const auto typeBefore = target.activeTetromino()->type();
+
+    auto rejects = [&](std::array<std::uint8_t, GameState::MaxSnapshotBytes> bytes, std::size_t length) {
+        CHECK_THROWS_AS(target.loadSnapshot(Span<const std::uint8_t>{bytes.data(), length}), std::invalid_argument);
+        CHECK(target.board().hash() == hashBefore);
+        CHECK(target.activeTetromino()->type() == typeBefore);
+    };
+
+    rejects(buffer, size - 1);     // truncated
+    rejects(buffer, size + 1);     // trailing byte
+    auto badMagic = buffer;
+    badMagic[0] = 'X';
+    rejects(badMagic, size);
+    auto badVersion = buffer;
+    badVersion[4] = GameState::SnapshotVersion + 1;
+    rejects(badVersion, size);
+    auto badCell = buffer;
+    badCell[size - 1] = 0xFF;
+    rejects(badCell, size);
+
+    // Board size must match
+    tetris::core::DynamicGameState small{12, 6, 0};
+    CHECK_THROWS_AS(small.loadSnapshot(Span<const std::uint8_t>{buffer.data(), size}), std::invalid_argument);
+
+    // Too small an output buffer
+    std::array<std::uint8_t, 16> tiny{};
+    CHECK_THROWS_AS(game.saveSnapshot(Span<std::uint8_t>{tiny.data(), tiny.size()}), std::length_error);
+}
+
+TEST_CASE("GameplayLoop: events record spawns, locks and game over", "[gameplay][events]")
+{
+    using tetris::core::GameEvent;
+    using tetris::core::GameEventKind;
+
+    GameState game;
+    game.setSeed(5);
+    game.start();
+
+    std::vector<GameEvent> seen;
+    auto cursor = game.events().forEachSince(0, [&](const GameEvent& e) { seen.push_back(e); });
+    REQUIRE(seen.size() == 1);
+    CHECK(seen[0].kind == GameEventKind::PieceSpawned);
+    CHECK(seen[0].piece == game.activeTetromino()->type());
+    CHECK(seen[0].origin().row == game.activeTetromino()->origin().row);
+    CHECK(seen[0].origin().col == game.activeTetromino()->origin().col);
+
+    // The lock carries the landing position
+    auto landed = *game.activeTetromino();
+    auto origin = landed.origin();
+    origin.row += game.board().dropDistance(landed);
+    landed.setOrigin(origin);
+    game.hardDrop();
+
+    seen.clear();
+    cursor = game.events().forEachSince(cursor, [&](const GameEvent& e) { seen.push_back(e); });
+    REQUIRE(seen.size() == 2);
+    CHECK(seen[0].kind == GameEventKind::PieceLocked);
+    CHECK(seen[0].piece == landed.type());
+    CHECK(seen[0].tetromino().origin().row == landed.origin().row);
+    CHECK(seen[0].tetromino().origin().col == landed.origin().col);
+    CHECK(seen[1].kind == GameEventKind::PieceSpawned);
+
+    // Stacking hard drops ends the game exactly once
+    while (game.status() == GameStatus::Running) {
+        game.hardDrop();
+        int gameOvers = 0;
+        std::uint64_t locks = 0;
+        cursor = game.events().forEachSince(cursor, [&](const GameEvent& e) {
+            gameOvers += (e.kind == GameEventKind::GameOver);
+            locks += (e.kind == GameEventKind::PieceLocked);
+        });
+        CHECK(locks == 1);
+        CHECK(gameOvers == (game.status() == GameStatus::GameOver ? 1 : 0));
+    }
+    game.hardDrop(); // ignored once over
+    CHECK(game.events().head() == cursor);
+}
+
+TEST_CASE("GameplayLoop: line clears and level-ups are reported with their rows", "[gameplay][events]")
+{
+    using tetris::core::GameEvent;
+    using tetris::core::GameEventKind;
+
+    tetris::controller::BotConfig config;
+    config.thinkBudget = std::chrono::seconds{5};
+    config.placementInterval = std::chrono::milliseconds{0};
+    tetris::controller::BotPlayer bot{config};
+
+    GameState game;
+    GameController controller{game};
+    game.setSeed(42);
+    game.start();
+
+    std::uint64_t cursor = game.events().head();
+    std::uint64_t locks = 0;
+    int lines = 0;
+    int levelUps = 0;
+    for (int i = 0; i < 150 && game.status() == GameStatus::Running; ++i) {
+        const auto scoreBefore = game.score();
+        REQUIRE(bot.playPiece(game, controller));
+        cursor = game.events().forEachSince(cursor, [&](const GameEvent& e) {
+            if (e.kind == GameEventKind::PieceLocked) {
+                ++locks;
+            } else if (e.kind == GameEventKind::LinesCleared) {
+                int rows = 0;
+                for (int r = 0; r < game.board().rows(); ++r) {
+                    rows += (e.rows >> r) & 1U;
+                }
+                CHECK(e.lines == rows);
+                CHECK(game.score() > scoreBefore);
+                lines += e.lines;
+            } else if (e.kind == GameEventKind::LevelUp) {
+                ++levelUps;
+                CHECK(e.level == lines / 10);
+            }
+        });
+    }
+
+    CHECK(locks == game.lockedPieces());
+    CHECK(lines >= 10);
+    CHECK(levelUps == game.level());
+}
+
+TEST_CASE("GameplayLoop: the event log keeps only the newest events", "[gameplay][events]")
+{
+    using tetris::core::GameEventLog;
+
+    // Tall board so twenty hard drops fit
+    tetris::core::DynamicGameState game{40, 10, 0};
+    game.setSeed(1);
+    game.start();
+    for (int i = 0; i < 20 && game.status() == GameStatus::Running; ++i) {
+        game.hardDrop();
+    }
+
+    const auto& log = game.events();
+    REQUIRE(log.head() > GameEventLog::Capacity);
+    CHECK(log.oldest() == log.head() - GameEventLog::Capacity);
+
+    std::size_t visited = 0;
+    CHECK(log.forEachSince(0, [&](const tetris::core::GameEvent&) { ++visited; }) == log.head());
+    CHECK(visited == GameEventLog::Capacity);
+
+    // Copies carry the log; reset() keeps counting
+    const auto copy = game;
+    CHECK(copy.events().head() == log.head());
+    game.reset();
+    game.start();
+    CHECK(game.events().head() == copy.events().head() + 1);
+}
+
+TEST_CASE("GameplayLoop: applyCommands matches applying commands one by one", "[gameplay][batch]")
+{
+    using tetris::core::PieceCommand;
+    using tetris::core::Span;
+
+    GameState batched;
+    GameState single;
+    for (GameState* g : { &batched, &single }) {
+        g->setSeed(77);
+        g->start();
+    }
+
+    // DAS-style floods of moves, rotations and soft drops, with hard drops mixed in
+    std::vector<PieceCommand> commands;
+    std::uint32_t x = 12345;
+    for (int i = 0; i < 2000; ++i) {
+        x = x * 1103515245u + 12345u;
+        const auto pick = (x >> 16) % 20;
+        commands.push_back(pick < 6 ? PieceCommand::MoveLeft
+                         : pick < 12 ? PieceCommand::MoveRight
+                         : pick < 15 ? PieceCommand::SoftDrop
+                         : pick < 17 ? PieceCommand::RotateCW
+                         : pick < 19 ? PieceCommand::RotateCCW
+                                     : PieceCommand::HardDrop);
+    }
+
+    std::unique_ptr<bool[]> flags(new bool[commands.size()]);
+    const std::size_t applied = batched.applyCommands(
+        Span<const PieceCommand>{commands.data(), commands.size()}, Span<bool>{flags.get(), commands.size()});
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const bool running = single.status() == GameStatus::Running;
+        const auto before = single.activeTetromino();
+        const auto scoreBefore = single.score();
+        switch (commands[i]) {
+        case PieceCommand::MoveLeft:  single.moveLeft(); break;
+        case PieceCommand::MoveRight: single.moveRight(); break;
+        case PieceCommand::SoftDrop:  single.softDrop(); break;
+        case PieceCommand::HardDrop:  single.hardDrop(); break;
+        case PieceCommand::RotateCW:  single.rotateClockwise(); break;
+        case PieceCommand::RotateCCW: single.rotateCounterClockwise(); break;
+        }
+        const bool changed = running
+            && (commands[i] == PieceCommand::HardDrop
+                || single.activeTetromino()->origin().row != before->origin().row
+                || single.activeTetromino()->origin().col != before->origin().col
+                || single.activeTetromino()->rotation() != before->rotation()
+                || single.score() != scoreBefore);
+        CHECK(flags[i] == changed);
+        expected += changed;
+    }
+
+    CHECK(applied == expected);
+    CHECK(batched.lockedPieces() == single.lockedPieces());
+    CHECK(batched.lockedPieces() > 10);
+    CHECK(batched.score() == single.score());
+    CHECK(batched.board().hash() == single.board().hash());
+    CHECK(batched.status() == single.status());
+
+    // Nothing is accepted once the game is over
+    while (batched.status() == GameStatus::Running) {
+        batched.hardDrop();
+    }
+    CHECK(batched.applyCommands(Span<const PieceCommand>{commands.data(), 10}, Span<bool>{flags.get(), 10}) == 0);
+    CHECK_FALSE(flags[0]);
+    CHECK_THROWS_AS(batched.applyCommands(Span<const PieceCommand>{commands.data(), 10},
+                                          Span<bool>{flags.get(), 3}),
+                    std::length_error);
+}
+
+TEST_CASE("GameplayLoop: handleActions rejects stale actions and honours pause", "[gameplay][controller][batch]")
+{
+    using tetris::controller::TimedInputAction;
+    using tetris::core::Span;
+
+    GameState game;
+    game.setSeed(3);
+    game.start();
+    GameController controller{game};
+    const int startCol = game.activeTetromino()->origin().col;
+
+    const TimedInputAction actions[] = {
+        { InputAction::MoveLeft, 10 },
+        { InputAction::MoveLeft, 11 },
+        { InputAction::MoveRight, 9 },   // older than the action before it
+        { InputAction::PauseResume, 12 },
+        { InputAction::MoveLeft, 13 },   // paused
+        { InputAction::PauseResume, 14 },
+        { InputAction::MoveLeft, 14 },
+    };
+    bool accepted[7] = {};
+    CHECK(controller.handleActions(Span<const TimedInputAction>{actions, 7}, Span<bool>{accepted, 7}) == 5);
+
+    CHECK(accepted[0]);
+    CHECK(accepted[1]);
+    CHECK_FALSE(accepted[2]);
+    CHECK(accepted[3]);
+    CHECK_FALSE(accepted[4]);
+    CHECK(accepted[5]);
+    CHECK(accepted[6]);
+    CHECK(game.activeTetromino()->origin().col == startCol - 3);
+    CHECK(game.status() == GameStatus::Running);
+
+    // A hard drop restarts the gravity timer, as with handleAction()
+    controller.update(GameController::Duration{300});
+    const TimedInputAction drop[] = { { InputAction::HardDrop, 20 } };
+    CHECK(controller.handleActions(Span<const TimedInputAction>{drop, 1}) == 1);
+    CHECK(controller.accumulatedTime() == GameController::Duration{0});
+    CHECK(game.lockedPieces() == 1);
+}
@@ -0,0 +1,394 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+
+#include "network/HostLoop.hpp"
+#include "network/HostGameSession.hpp"
+#include "network/NetworkHost.hpp"
+#include "network/INetworkSession.hpp"
+#include "network/MessageTypes.hpp"
+#include "core/GameState.hpp"
+#include "core/MatchRules.hpp"
+#include "controller/BotPlayer.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+// Test hook: every allocation in this executable goes through the
+// operators below, and is counted while g_countAllocations is set. They
+// replace the whole set (plain, array, nothrow and aligned, with their
+// deletes), so nothing is paired with the standard allocator. This file
+// builds on its own (tetris_host_loop_tests) to keep the replacement away
+// from the other tests.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// GCC pairs the replaced operators below with the standard ones when inlining
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+std::atomic<bool> g_countAllocations{false};
+std::atomic<std::size_t> g_allocations{0};
+
+void* countedAlloc(std::size_t size, std::size_t alignment) noexcept
+{
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    void* p = nullptr;
+    return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+void* countedAllocOrThrow(std::size_t size, std::size_t alignment)
+{
+    if (void* p = countedAlloc(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+} // namespace
+
+void* operator new(std::size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return countedAllocOrThrow(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al) { return countedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return countedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlloc(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlloc(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+using namespace tetris::net;
+using tetris::controller::GameController;
+using tetris::controller::InputAction;
+
+namespace {
+
+// Session that only counts what it is sent: FakeNetworkSession records
+// every message, which would allocate inside the measured region.
+class CountingSession final : public INetworkSession {
+public:
+    void send(const Message& msg) override
+    {
+        ++sent;
+        if (const auto* ja = std::get_if<JoinAccept>(&msg.payload)) {
+            assignedId = ja->assignedId;
+        }
+        if (const auto* su = std::get_if<StateUpdate>(&msg.payload)) {
+            ++stateUpdates;
+            for (const auto& p : su->players) {
+                if (!p.gameSnapshot.empty()) {
+                    ++snapshots;
+                    snapshotOwner = p.id;
+                }
+                if (p.lastInputTick) {
+                    ack = p.lastInputTick;
+                }
+            }
+        }
+    }
+    void poll() override {}
+    void setMessageHandler(MessageHandler handler) override { m_handler = std::move(handler); }
+    bool isConnected() const override { return true; }
+
+    void deliver(const Message& msg)
+    {
+        if (m_handler) {
+            m_handler(msg);
+        }
+    }
+
+    std::size_t sent = 0;
+    PlayerId assignedId = 0;
+    std::size_t stateUpdates = 0;
+    std::size_t snapshots = 0; // players' game snapshots across StateUpdates
+    PlayerId snapshotOwner = 0;
+    std::optional<Tick> ack; // latest lastInputTick sent for any player
+
+private:
+    MessageHandler m_handler;
+};
+
+// TimeAttack rules that only count the pieces they are told about
+class LockCountingRules final : public tetris::core::IMatchRules {
+public:
+    explicit LockCountingRules(std::size_t& locks) : m_locks(locks) {}
+
+    void initializePlayers(const std::vector<tetris::core::PlayerSnapshot>&) override {}
+    void onMatchStart(Tick) override {}
+    void onPieceLocked(PlayerId, const std::vector<tetris::core::PlayerSnapshot>&) override { ++m_locks; }
+    std::vector<MatchResult> update(Tick, const std::vector<tetris::core::PlayerSnapshot>&) override { return {}; }
+    bool isFinished() const override { return false; }
+    GameMode mode() const override { return GameMode::TimeAttack; }
+
+private:
+    std::size_t& m_locks;
+};
+
+// The host's own player and one joined client, each with a started game
+// and a controller, driven by a HostLoop under `mode`'s rules (or
+// `rules`, if given).
+struct TwoPlayerMatch {
+    explicit TwoPlayerMatch(GameMode mode, std::unique_ptr<tetris::core::IMatchRules> rules = nullptr)
+        : cfg(configFor(mode))
+        , host(cfg)
+        , client(std::make_shared<CountingSession>())
+        , session(host, cfg, rules ? std::move(rules) : rulesFor(cfg))
+    {
+        host.addClient(client);
+        Message jr;
+        jr.kind = MessageKind::JoinRequest;
+        jr.payload = JoinRequest{ "Client" };
+        client->deliver(jr);
+        cid = client->assignedId;
+        REQUIRE(cid != 0);
+
+        hostGame.setSeed(1);
+        clientGame.setSeed(2);
+        hostGame.start();
+        clientGame.start();
+        session.start(0, { { NetworkHost::HostPlayerId, 0, true }, { cid, 0, true } });
+
+        loop = std::make_unique<HostLoop>(
+            session,
+            HostLoop::GameStateMap{ { NetworkHost::HostPlayerId, &hostGame }, { cid, &clientGame } },
+            HostLoop::GameControllerMap{ { NetworkHost::HostPlayerId, &hostCtrl }, { cid, &clientCtrl } },
+            HostLoop::PlayerNameMap{ { NetworkHost::HostPlayerId, "Host" }, { cid, "Client" } });
+    }
+
+    static MultiplayerConfig configFor(GameMode mode)
+    {
+        MultiplayerConfig cfg;
+        cfg.isHost = true;
+        cfg.mode = mode;
+        return cfg;
+    }
+
+    static std::unique_ptr<tetris::core::IMatchRules> rulesFor(const MultiplayerConfig& cfg)
+    {
+        if (cfg.mode == GameMode::SharedTurns) {
+            return std::make_unique<tetris::core::SharedTurnRules>(cfg.piecesPerTurn);
+        }
+        return std::make_unique<tetris::core::TimeAttackRules>(1'000'000);
+    }
+
+    void deliverInput(Tick clientTick, InputAction action)
+    {
+        Message input;
+        input.kind = MessageKind::InputActionMessage;
+        input.payload = InputActionMessage{ cid, clientTick, action };
+        client->deliver(input);
+    }
+
+    MultiplayerConfig cfg;
+    NetworkHost host;
+    std::shared_ptr<CountingSession> client;
+    PlayerId cid = 0;
+    tetris::core::GameState hostGame;
+    tetris::core::GameState clientGame;
+    GameController hostCtrl{ hostGame };
+    GameController clientCtrl{ clientGame };
+    HostGameSession session;
+    std::unique_ptr<HostLoop> loop;
+};
+
+constexpr InputAction kScript[] = {
+    InputAction::MoveLeft, InputAction::RotateCW, InputAction::MoveRight,
+    InputAction::SoftDrop, InputAction::RotateCCW, InputAction::MoveRight
+};
+
+} // namespace
+
+TEST_CASE("HostLoop: a running match steps without allocating", "[network][hostloop]")
+{
+    TwoPlayerMatch match(GameMode::TimeAttack);
+    auto& client = match.client;
+    auto& loop = *match.loop;
+    const PlayerId cid = match.cid;
+
+    Message input;
+    input.kind = MessageKind::InputActionMessage;
+    input.payload = InputActionMessage{ cid, 0, InputAction::MoveLeft };
+    auto& action = std::get<InputActionMessage>(input.payload);
+
+    // No assertions inside the measured region: they may allocate.
+    Tick tick = 0;
+    bool finished = false;
+    auto run = [&](int steps) {
+        for (int i = 0; i < steps; ++i, ++tick) {
+            // Two inputs on most steps, none on some
+            for (int k = 0; k < 2 && tick % 5 != 0; ++k) {
+                action.clientTick = tick * 2 + k;
+                action.action = kScript[(tick + k) % 6];
+                client->deliver(input);
+            }
+            finished |= !loop.step(GameController::Duration{16}, tick).empty();
+        }
+    };
+
+    run(200); // warm-up: buffers grow to their working size
+
+    const std::size_t sentBefore = client->sent;
+    const std::size_t snapshotsBefore = client->snapshots;
+    g_allocations = 0;
+    g_countAllocations = true;
+    run(10'000);
+    g_countAllocations = false;
+
+    CHECK_FALSE(finished);
+    CHECK(g_allocations.load() == 0);
+    CHECK(client->sent - sentBefore >= 3'000); // StateUpdates did go out
+    // Only the predicting client's game is attached, not the host's
+    CHECK(client->snapshots - snapshotsBefore == client->sent - sentBefore);
+    CHECK(client->snapshotOwner == cid);
+    CHECK(match.clientGame.lockedPieces() > 0);
+}
+
+TEST_CASE("HostLoop: SharedTurns sends no prediction data", "[network][hostloop]")
+{
+    TwoPlayerMatch match(GameMode::SharedTurns);
+
+    for (Tick tick = 0; tick < 12; ++tick) {
+        match.deliverInput(tick, InputAction::MoveLeft);
+        match.loop->step(GameController::Duration{16}, tick);
+    }
+
+    CHECK(match.client->stateUpdates >= 3);
+    CHECK(match.client->snapshots == 0);
+    CHECK_FALSE(match.client->ack.has_value());
+}
+
+TEST_CASE("HostLoop: acks only inputs that took effect", "[network][hostloop]")
+{
+    TwoPlayerMatch match(GameMode::TimeAttack);
+    const auto& client = match.client;
+    const auto& clientGame = match.clientGame;
+
+    Tick tick = 0;
+    auto broadcastStep = [&] {
+        for (int i = 0; i < 4; ++i, ++tick) { // 64 ms: one StateUpdate
+            match.loop->step(GameController::Duration{16}, tick);
+        }
+    };
+
+    // Twelve moves left: the piece stops at the wall well before the last
+    const int startCol = clientGame.activeTetromino()->origin().col;
+    for (Tick t = 1; t <= 12; ++t) {
+        match.deliverInput(t, InputAction::MoveLeft);
+    }
+    broadcastStep();
+    const auto moved = static_cast<Tick>(startCol - clientGame.activeTetromino()->origin().col);
+    REQUIRE(moved > 0);
+    REQUIRE(moved < 12);
+    REQUIRE(client->ack.has_value());
+    CHECK(*client->ack == moved);
+
+    // An older clientTick arriving late does not move the ack back
+    match.deliverInput(1, InputAction::MoveRight);
+    broadcastStep();
+    REQUIRE(client->ack.has_value());
+    CHECK(*client->ack == moved);
+}
+
+TEST_CASE("HostLoop: reports every lock of a batch longer than the event log", "[network][hostloop]")
+{
+    std::size_t locks = 0;
+    TwoPlayerMatch match(GameMode::TimeAttack, std::make_unique<LockCountingRules>(locks));
+
+    // One step's worth of hard drops, spread over three columns: four
+    // events each, far more than GameEventLog holds
+    Tick clientTick = 0;
+    for (int piece = 0; piece < 24; ++piece) {
+        const auto shift = piece % 3 == 1 ? InputAction::MoveLeft : InputAction::MoveRight;
+        for (int k = 0; k < 4 * (piece % 3 != 0); ++k) {
+            match.deliverInput(clientTick++, shift);
+        }
+        match.deliverInput(clientTick++, InputAction::HardDrop);
+    }
+    match.loop->step(GameController::Duration{16}, 0);
+
+    REQUIRE(match.clientGame.lockedPieces() * 4 > tetris::core::GameEventLog::Capacity);
+    CHECK(locks == match.clientGame.lockedPieces());
+}
+
+TEST_CASE("HostLoop: bots share one think budget per step", "[network][hostloop][bot]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kBots = 6;
+
+    MultiplayerConfig cfg;
+    cfg.isHost = true;
+    cfg.mode = GameMode::TimeAttack;
+    NetworkHost host(cfg);
+
+    // Each bot alone may think for 20 ms: six of them in a row would take 120 ms
+    tetris::controller::BotConfig botConfig;
+    botConfig.beamWidth = 64;
+    botConfig.lookahead = 5;
+    botConfig.thinkBudget = std::chrono::milliseconds{20};
+    botConfig.placementInterval = std::chrono::milliseconds{0};
+
+    std::vector<std::unique_ptr<tetris::core::GameState>> games;
+    std::vector<std::unique_ptr<GameController>> controllers;
+    std::vector<std::unique_ptr<tetris::controller::BotPlayer>> bots;
+    HostLoop::GameStateMap gameMap;
+    HostLoop::GameControllerMap controllerMap;
+    HostLoop::PlayerNameMap names;
+    HostLoop::BotMap botMap;
+    std::vector<tetris::core::PlayerSnapshot> players;
+    for (int i = 0; i < kBots; ++i) {
+        const PlayerId pid = static_cast<PlayerId>(100 + i);
+        games.push_back(std::make_unique<tetris::core::GameState>());
+        games.back()->setSeed(static_cast<std::uint64_t>(i + 1));
+        games.back()->start();
+        controllers.push_back(std::make_unique<GameController>(*games.back()));
+        bots.push_back(std::make_unique<tetris::controller::BotPlayer>(botConfig));
+        gameMap[pid] = games.back().get();
+        controllerMap[pid] = controllers.back().get();
+        names[pid] = "Bot";
+        botMap[pid] = bots.back().get();
+        players.push_back({ pid, 0, true });
+    }
+
+    HostGameSession session(host, cfg, std::make_unique<tetris::core::TimeAttackRules>(1'000'000));
+    session.start(0, players);
+
+    HostLoop loop(session, gameMap, controllerMap, names);
+    loop.setBots(botMap, std::chrono::milliseconds{4});
+
+    Clock::duration slowest{0};
+    for (Tick tick = 0; tick < 18; ++tick) {
+        const auto start = Clock::now();
+        loop.step(GameController::Duration{16}, tick);
+        slowest = std::max(slowest, Clock::now() - start);
+    }
+
+    // 4 ms plus at most one bot's first search level, far below 6 x 20 ms;
+    // the margin absorbs scheduling noise on a loaded machine
+    CHECK(slowest < std::chrono::milliseconds{40});
+    for (const auto& game : games) {
+        CHECK(game->lockedPieces() > 0); // the rotation lets every bot play
+    }
+}
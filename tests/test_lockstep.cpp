@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "network/LockstepSession.hpp"
+#include "network/MessageTypes.hpp"
+#include "network/Serialization.hpp"
+#include "controller/InputAction.hpp"
+
+using namespace tetris::net;
+using tetris::controller::InputAction;
+
+namespace {
+
+// Moves every pending message from one session to the other, through the
+// text protocol like a real connection would.
+void deliver(LockstepSession& from, LockstepSession& to)
+{
+    std::vector<Message> out;
+    from.takeOutgoing(out);
+    for (const auto& msg : out) {
+        const auto parsed = deserialize(serialize(msg));
+        REQUIRE(parsed.has_value());
+        to.receive(*parsed);
+    }
+}
+
+LockstepSession::Config smallConfig(GameMode mode = GameMode::TimeAttack)
+{
+    LockstepSession::Config cfg;
+    cfg.mode = mode;
+    cfg.piecesPerTurn = 2;
+    cfg.tickMs = 16;
+    cfg.inputDelayTicks = 2;
+    cfg.hashIntervalTicks = 10;
+    return cfg;
+}
+
+constexpr InputAction kScript[] = {
+    InputAction::MoveLeft, InputAction::RotateCW, InputAction::HardDrop,
+    InputAction::MoveRight, InputAction::MoveRight, InputAction::SoftDrop,
+    InputAction::RotateCCW, InputAction::HardDrop
+};
+
+} // namespace
+
+TEST_CASE("Lockstep: two peers simulate identical matches from inputs only", "[network][lockstep]")
+{
+    for (GameMode mode : { GameMode::TimeAttack, GameMode::SharedTurns }) {
+        LockstepSession a(1, { 1, 2 }, 777, smallConfig(mode));
+        LockstepSession b(2, { 1, 2 }, 777, smallConfig(mode));
+
+        for (int frame = 0; frame < 400; ++frame) {
+            a.addLocalInput(kScript[frame % 8]);
+            if (frame % 3 == 0) {
+                b.addLocalInput(kScript[(frame / 3) % 8]);
+            }
+            a.advance();
+            b.advance();
+            deliver(a, b);
+            deliver(b, a);
+        }
+
+        // Each peer runs at most inputDelayTicks ahead of the other's frames
+        CHECK(a.tick() > 390);
+        CHECK(b.tick() > 390);
+
+        while (a.tick() != b.tick()) {
+            (a.tick() < b.tick() ? a : b).advance();
+            deliver(a, b);
+            deliver(b, a);
+        }
+        CHECK(a.stateHash() == b.stateHash());
+        CHECK(a.game(1).board().hash() == b.game(1).board().hash());
+        CHECK(a.game(2).score() == b.game(2).score());
+        CHECK(a.game(1).lockedPieces() > 0);
+        CHECK_FALSE(a.desynced());
+        CHECK_FALSE(b.desynced());
+
+        if (mode == GameMode::SharedTurns) {
+            CHECK(a.turnPlayerId() == b.turnPlayerId());
+            CHECK(a.piecesLeftThisTurn() == b.piecesLeftThisTurn());
+        }
+    }
+}
+
+TEST_CASE("Lockstep: a session waits for the remote frame of each tick", "[network][lockstep]")
+{
+    LockstepSession a(1, { 1, 2 }, 5, smallConfig());
+    LockstepSession b(2, { 1, 2 }, 5, smallConfig());
+
+    // Ticks inside the input delay need no remote frame
+    CHECK(a.advance(10) == 2);
+    CHECK(a.tick() == 2);
+    CHECK(a.waitingFor(2));
+    CHECK_FALSE(a.waitingFor(1));
+
+    b.advance(0);
+    deliver(b, a);
+    CHECK(a.advance(10) == 1);
+    CHECK(a.waitingFor(2));
+}
+
+TEST_CASE("Lockstep: local inputs apply after the input delay", "[network][lockstep]")
+{
+    LockstepSession a(1, { 1, 2 }, 9, smallConfig());
+    LockstepSession b(2, { 1, 2 }, 9, smallConfig());
+
+    a.addLocalInput(InputAction::HardDrop);
+    for (int i = 0; i < 2; ++i) {
+        a.advance();
+        b.advance();
+        deliver(a, b);
+        deliver(b, a);
+        CHECK(a.game(1).lockedPieces() == 0);
+    }
+
+    a.advance();
+    b.advance();
+    CHECK(a.game(1).lockedPieces() == 1);
+    CHECK(b.game(1).lockedPieces() == 1);
+    CHECK(b.game(2).lockedPieces() == 0);
+}
+
+TEST_CASE("Lockstep: mismatched hashes mark the session as desynced", "[network][lockstep]")
+{
+    // Different seeds stand in for any divergence between the peers
+    LockstepSession a(1, { 1, 2 }, 100, smallConfig());
+    LockstepSession b(2, { 1, 2 }, 101, smallConfig());
+
+    for (int frame = 0; frame < 30; ++frame) {
+        a.advance();
+        b.advance();
+        deliver(a, b);
+        deliver(b, a);
+    }
+
+    REQUIRE(a.desynced());
+    REQUIRE(b.desynced());
+    CHECK(*a.desyncTick() == 10);
+    CHECK(*b.desyncTick() == 10);
+}
+
+TEST_CASE("Lockstep: unknown players are rejected", "[network][lockstep]")
+{
+    CHECK_THROWS_AS(LockstepSession(3, { 1, 2 }, 0, smallConfig()), std::invalid_argument);
+
+    LockstepSession a(1, { 1, 2 }, 0, smallConfig());
+    CHECK_THROWS_AS(a.game(7), std::out_of_range);
+
+    // Frames from strangers are ignored
+    Message msg;
+    msg.kind = MessageKind::LockstepInputs;
+    msg.payload = LockstepInputs{ 7u, 2u, { InputAction::HardDrop } };
+    a.receive(msg);
+    CHECK(a.advance(5) == 2);
+}
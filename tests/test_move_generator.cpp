@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "controller/InputAction.hpp"
+#include "core/Board.hpp"
+#include "core/MoveGenerator.hpp"
+#include "core/Tetromino.hpp"
+
+using namespace tetris::core;
+using tetris::controller::InputAction;
+
+namespace {
+
+using Cells = std::array<std::pair<int, int>, 4>;
+
+Cells sortedCells(const Tetromino& t) {
+    Cells cells{};
+    const auto blocks = t.blocks();
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        cells[i] = {blocks[i].row, blocks[i].col};
+    }
+    std::sort(cells.begin(), cells.end());
+    return cells;
+}
+
+// Applies one input the way GameState does (no kicks, blocked moves are no-ops).
+template <typename BoardT>
+Tetromino apply(const BoardT& board, Tetromino t, InputAction action) {
+    Tetromino next = t;
+    Position p = t.origin();
+    switch (action) {
+    case InputAction::MoveLeft: --p.col; next.setOrigin(p); break;
+    case InputAction::MoveRight: ++p.col; next.setOrigin(p); break;
+    case InputAction::SoftDrop: ++p.row; next.setOrigin(p); break;
+    case InputAction::RotateCW:
+        next = Tetromino{t.type(), nextRotation(t.rotation()), p};
+        break;
+    case InputAction::RotateCCW:
+        next = Tetromino{t.type(), static_cast<Rotation>((static_cast<int>(t.rotation()) + 3) % 4), p};
+        break;
+    case InputAction::HardDrop:
+        p.row += board.dropDistance(t);
+        next.setOrigin(p);
+        break;
+    default: break;
+    }
+    return board.canPlace(next) ? next : t;
+}
+
+// Brute-force oracle: plain BFS over poses keyed by std::set, returning the
+// shortest input count (HardDrop included) for every distinct landing.
+template <typename BoardT>
+std::map<Cells, int> referencePlacements(const BoardT& board, const Tetromino& start) {
+    std::map<Cells, int> result;
+    if (!board.canPlace(start)) {
+        return result;
+    }
+    using Key = std::tuple<int, int, int>;
+    auto key = [](const Tetromino& t) {
+        return Key{static_cast<int>(t.rotation()), t.origin().row, t.origin().col};
+    };
+    std::set<Key> seen{key(start)};
+    std::queue<std::pair<Tetromino, int>> open;
+    open.push({start, 0});
+    const InputAction moves[] = {InputAction::MoveLeft, InputAction::MoveRight, InputAction::SoftDrop,
+                                 InputAction::RotateCW, InputAction::RotateCCW};
+    while (!open.empty()) {
+        auto [t, depth] = open.front();
+        open.pop();
+        const Cells landed = sortedCells(apply(board, t, InputAction::HardDrop));
+        auto it = result.find(landed);
+        if (it == result.end() || it->second > depth + 1) {
+            result[landed] = depth + 1;
+        }
+        for (InputAction a : moves) {
+            const Tetromino next = apply(board, t, a);
+            if (seen.insert(key(next)).second) {
+                open.push({next, depth + 1});
+            }
+        }
+    }
+    return result;
+}
+
+template <typename BoardT>
+void fillRandom(BoardT& board, std::mt19937& rng, int fromRow, int density) {
+    std::uniform_int_distribution<int> pct{0, 99};
+    for (int r = fromRow; r < board.rows(); ++r) {
+        for (int c = 0; c < board.cols(); ++c) {
+            if (pct(rng) < density) {
+                board.setCell(r, c, CellState::Filled);
+            }
+        }
+    }
+}
+
+template <typename BoardT>
+void checkAgainstReference(const BoardT& board, const Tetromino& start, MoveGenerator& gen) {
+    const auto expected = referencePlacements(board, start);
+    const auto placements = gen.generate(board, start);
+    REQUIRE(placements.size() == expected.size());
+
+    std::set<Cells> distinct;
+    std::vector<InputAction> inputs;
+    for (const Placement& p : placements) {
+        const Cells cells = sortedCells(p.piece);
+        REQUIRE(distinct.insert(cells).second);
+        auto it = expected.find(cells);
+        REQUIRE(it != expected.end());
+        REQUIRE(p.inputCount == it->second);
+
+        // Replaying the path lands exactly on the placement
+        gen.path(p, inputs);
+        REQUIRE(static_cast<int>(inputs.size()) == p.inputCount);
+        REQUIRE(inputs.back() == InputAction::HardDrop);
+        Tetromino t = start;
+        for (InputAction a : inputs) {
+            t = apply(board, t, a);
+        }
+        REQUIRE(sortedCells(t) == cells);
+        REQUIRE(board.dropDistance(p.piece) == 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("MoveGenerator: canonical rotations merge poses covering the same cells", "[movegen]") {
+    REQUIRE(shapeInfo(TetrominoType::I, Rotation::R180).canonicalRotation == 0);
+    REQUIRE(shapeInfo(TetrominoType::S, Rotation::R180).canonicalRotation == 0);
+    for (int r = 0; r < 4; ++r) {
+        REQUIRE(shapeInfo(TetrominoType::O, static_cast<Rotation>(r)).canonicalRotation == 0);
+        REQUIRE(shapeInfo(TetrominoType::T, static_cast<Rotation>(r)).canonicalRotation == r);
+    }
+}
+
+TEST_CASE("MoveGenerator: empty board yields one placement per column and orientation", "[movegen]") {
+    StandardBoard board{20, 10};
+    MoveGenerator gen;
+
+    const auto o = gen.generate(board, Tetromino{TetrominoType::O, Rotation::R0, Position{0, 4}});
+    REQUIRE(o.size() == 9);
+
+    const auto t = gen.generate(board, Tetromino{TetrominoType::T, Rotation::R0, Position{0, 4}});
+    std::set<Cells> distinct;
+    for (const Placement& p : t) {
+        distinct.insert(sortedCells(p.piece));
+    }
+    REQUIRE(distinct.size() == t.size());
+    REQUIRE(t.size() >= 34);
+
+    // Blocked spawn yields nothing
+    board.setCell(1, 4, CellState::Filled);
+    REQUIRE(gen.generate(board, Tetromino{TetrominoType::O, Rotation::R0, Position{0, 4}}).empty());
+}
+
+TEST_CASE("MoveGenerator: finds a tuck under an overhang", "[movegen]") {
+    StandardBoard board{20, 10};
+    // Roof over columns 0..2 at row 17 leaves a pocket at rows 18..19
+    for (int c = 0; c < 3; ++c) {
+        board.setCell(17, c, CellState::Filled);
+    }
+    MoveGenerator gen;
+    const Tetromino start{TetrominoType::O, Rotation::R0, Position{0, 4}};
+    const auto placements = gen.generate(board, start);
+
+    const Cells pocket = sortedCells(Tetromino{TetrominoType::O, Rotation::R0, Position{18, 0}});
+    auto it = std::find_if(placements.begin(), placements.end(),
+                           [&](const Placement& p) { return sortedCells(p.piece) == pocket; });
+    REQUIRE(it != placements.end());
+
+    std::vector<InputAction> inputs;
+    gen.path(*it, inputs);
+    Tetromino t = start;
+    for (InputAction a : inputs) {
+        t = apply(board, t, a);
+    }
+    REQUIRE(sortedCells(t) == pocket);
+}
+
+TEST_CASE("MoveGenerator: matches brute-force search on random boards", "[movegen]") {
+    std::mt19937 rng{12345};
+    MoveGenerator gen;
+    for (int iter = 0; iter < 60; ++iter) {
+        StandardBoard board{20, 10};
+        fillRandom(board, rng, 8, 35);
+        for (int type = 0; type < 7; ++type) {
+            const Tetromino start{static_cast<TetrominoType>(type), Rotation::R0, Position{0, 4}};
+            checkAgainstReference(board, start, gen);
+        }
+    }
+}
+
+TEST_CASE("MoveGenerator: works on dynamic boards", "[movegen]") {
+    std::mt19937 rng{777};
+    MoveGenerator gen;
+    Board board{12, 7};
+    fillRandom(board, rng, 5, 30);
+    for (int type = 0; type < 7; ++type) {
+        checkAgainstReference(board, Tetromino{static_cast<TetrominoType>(type), Rotation::R0, Position{0, 3}}, gen);
+    }
+}
@@ -3,10 +3,13 @@
 #include <algorithm>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "network/Serialization.hpp"
+#include "network/BinarySerialization.hpp"
+#include "network/WireCodec.hpp"
 #include "network/NetworkClient.hpp"
 #include "network/NetworkHost.hpp"
 #include "network/HostGameSession.hpp"
@@ -131,6 +134,24 @@ TEST_CASE("Network serialization round-trips core message types", "[network][ser
         CHECK(p->timeLimitSeconds == 123u);
         CHECK(p->piecesPerTurn == 7u);
         CHECK(p->startTick == 555u);
+        CHECK_FALSE(p->pieceSeed.has_value());
+        CHECK(line == "START_GAME;0;123;7;555"); // unchanged for peers without seeds
+    }
+
+    SECTION("StartGame with piece seed")
+    {
+        Message original;
+        original.kind = MessageKind::StartGame;
+        original.payload = StartGame{ GameMode::SharedTurns, 0u, 2u, 9u, 0xFEEDFACECAFEBEEFULL };
+
+        const auto parsed = deserialize(serialize(original));
+        REQUIRE(parsed.has_value());
+
+        const auto* p = std::get_if<StartGame>(&parsed->payload);
+        REQUIRE(p != nullptr);
+        CHECK(p->startTick == 9u);
+        REQUIRE(p->pieceSeed.has_value());
+        CHECK(*p->pieceSeed == 0xFEEDFACECAFEBEEFULL);
     }
 
     SECTION("InputActionMessage")
@@ -195,6 +216,41 @@ TEST_CASE("Network serialization round-trips core message types", "[network][ser
         CHECK(incoming.piecesLeftThisTurn == 2);
     }
 
+    SECTION("StateUpdate with prediction data")
+    {
+        auto up = makeSmallStateUpdate();
+        up.players[0].lastInputTick = 0u;
+        up.players[0].gameSnapshot = { 0x00, 0x7F, 0xFF };
+        up.players[0].snapshotTiming = SnapshotTimingDTO{ 120u, 35u };
+
+        PlayerStateDTO other = up.players[0];
+        other.id = 2u;
+        other.lastInputTick.reset();
+        other.gameSnapshot.clear();
+        other.snapshotTiming.reset();
+        up.players.push_back(other);
+
+        Message original;
+        original.kind = MessageKind::StateUpdate;
+        original.payload = up;
+
+        const auto parsed = deserialize(serialize(original));
+        REQUIRE(parsed.has_value());
+
+        const auto& incoming = std::get<StateUpdate>(parsed->payload);
+        REQUIRE(incoming.players.size() == 2);
+        REQUIRE(incoming.players[0].lastInputTick.has_value());
+        CHECK(*incoming.players[0].lastInputTick == 0u);
+        CHECK(incoming.players[0].gameSnapshot == std::vector<std::uint8_t>{ 0x00, 0x7F, 0xFF });
+        REQUIRE(incoming.players[0].snapshotTiming.has_value());
+        CHECK(incoming.players[0].snapshotTiming->sinceInputMs == 120u);
+        CHECK(incoming.players[0].snapshotTiming->gravityMs == 35u);
+        CHECK_FALSE(incoming.players[1].snapshotTiming.has_value());
+        CHECK_FALSE(incoming.players[1].lastInputTick.has_value());
+        CHECK(incoming.players[1].gameSnapshot.empty());
+        CHECK(incoming.players[1].board.cells.size() == 2);
+    }
+
     SECTION("PlayerLeft")
     {
         Message original;
@@ -214,6 +270,95 @@ TEST_CASE("Network serialization round-trips core message types", "[network][ser
         CHECK(p->reason == "LEFT_TO_MENU");
     }
 
+    SECTION("StartGame with lockstep settings")
+    {
+        StartGame start{ GameMode::TimeAttack, 60u, 0u, 0u };
+        start.lockstepTickMs = 16u;
+        start.inputDelayTicks = 3u;
+
+        Message original;
+        original.kind = MessageKind::StartGame;
+        original.payload = start;
+
+        const auto line = serialize(original);
+        CHECK(line == "START_GAME;0;60;0;0;;16;3");
+
+        const auto parsed = deserialize(line);
+        REQUIRE(parsed.has_value());
+        const auto* p = std::get_if<StartGame>(&parsed->payload);
+        REQUIRE(p != nullptr);
+        CHECK_FALSE(p->pieceSeed.has_value());
+        CHECK(p->lockstepTickMs == 16u);
+        CHECK(p->inputDelayTicks == 3u);
+        CHECK(p->rollbackWindowTicks == 0u);
+    }
+
+    SECTION("StartGame with a rollback window")
+    {
+        StartGame start{ GameMode::TimeAttack, 60u, 0u, 0u };
+        start.pieceSeed = 9u;
+        start.lockstepTickMs = 16u;
+        start.inputDelayTicks = 1u;
+        start.rollbackWindowTicks = 8u;
+
+        Message original;
+        original.kind = MessageKind::StartGame;
+        original.payload = start;
+
+        const auto line = serialize(original);
+        CHECK(line == "START_GAME;0;60;0;0;9;16;1;8");
+
+        const auto parsed = deserialize(line);
+        REQUIRE(parsed.has_value());
+        const auto* p = std::get_if<StartGame>(&parsed->payload);
+        REQUIRE(p != nullptr);
+        CHECK(p->inputDelayTicks == 1u);
+        CHECK(p->rollbackWindowTicks == 8u);
+    }
+
+    SECTION("LockstepInputs")
+    {
+        Message original;
+        original.kind = MessageKind::LockstepInputs;
+        original.payload = LockstepInputs{ 2u, 77u, {
+            tetris::controller::InputAction::MoveLeft,
+            tetris::controller::InputAction::HardDrop
+        } };
+
+        const auto parsed = deserialize(serialize(original));
+        REQUIRE(parsed.has_value());
+        CHECK(parsed->kind == MessageKind::LockstepInputs);
+
+        const auto* p = std::get_if<LockstepInputs>(&parsed->payload);
+        REQUIRE(p != nullptr);
+        CHECK(p->playerId == 2u);
+        CHECK(p->tick == 77u);
+        REQUIRE(p->actions.size() == 2);
+        CHECK(p->actions[0] == tetris::controller::InputAction::MoveLeft);
+        CHECK(p->actions[1] == tetris::controller::InputAction::HardDrop);
+
+        // A tick without input still has a frame
+        original.payload = LockstepInputs{ 2u, 78u, {} };
+        const auto empty = deserialize(serialize(original));
+        REQUIRE(empty.has_value());
+        CHECK(std::get<LockstepInputs>(empty->payload).actions.empty());
+    }
+
+    SECTION("LockstepHash")
+    {
+        Message original;
+        original.kind = MessageKind::LockstepHash;
+        original.payload = LockstepHash{ 1u, 600u, 0xFFFFFFFFFFFFFFFFULL };
+
+        const auto parsed = deserialize(serialize(original));
+        REQUIRE(parsed.has_value());
+        const auto* p = std::get_if<LockstepHash>(&parsed->payload);
+        REQUIRE(p != nullptr);
+        CHECK(p->playerId == 1u);
+        CHECK(p->tick == 600u);
+        CHECK(p->hash == 0xFFFFFFFFFFFFFFFFULL);
+    }
+
     SECTION("Unknown message type fails")
     {
         const auto parsed = deserialize("TOTALLY_UNKNOWN;something;else");
@@ -221,6 +366,283 @@ TEST_CASE("Network serialization round-trips core message types", "[network][ser
     }
 }
 
+// ============================
+// Binary codec tests
+// ============================
+
+namespace {
+
+Message makeMessage(MessageKind kind, MessagePayload payload)
+{
+    Message msg;
+    msg.kind = kind;
+    msg.payload = std::move(payload);
+    return msg;
+}
+
+std::vector<Message> oneOfEachKind()
+{
+    using tetris::controller::InputAction;
+
+    StartGame start{ GameMode::SharedTurns, 90u, 3u, 12u, 0xFEEDFACECAFEBEEFULL };
+    start.lockstepTickMs = 16u;
+    start.inputDelayTicks = 2u;
+    start.rollbackWindowTicks = 8u;
+
+    auto update = makeSmallStateUpdate(); // non-default colours
+    update.players[0].lastInputTick = 0u;
+    update.players[0].gameSnapshot = { 0x00, 0x7F, 0xFF };
+    update.players[0].snapshotTiming = SnapshotTimingDTO{ 300u, 16u };
+
+    return {
+        makeMessage(MessageKind::JoinRequest, JoinRequest{ "Player;One\\Weird" }),
+        makeMessage(MessageKind::JoinAccept, JoinAccept{ 99u, "Welcome" }),
+        makeMessage(MessageKind::StartGame, start),
+        makeMessage(MessageKind::StartGame, StartGame{ GameMode::TimeAttack, 123u, 7u, 555u }),
+        makeMessage(MessageKind::InputActionMessage, InputActionMessage{ 42u, Tick{1} << 40, InputAction::RotateCW }),
+        makeMessage(MessageKind::StateUpdate, update),
+        makeMessage(MessageKind::MatchResult, MatchResult{ 9999u, 7u, MatchOutcome::Lose, -5 }),
+        makeMessage(MessageKind::PlayerLeft, PlayerLeft{ 2u, true, "DISCONNECTED" }),
+        makeMessage(MessageKind::Error, ErrorMessage{ "" }),
+        makeMessage(MessageKind::RematchDecision, RematchDecision{ true }),
+        makeMessage(MessageKind::KeepAlive, KeepAlive{}),
+        makeMessage(MessageKind::LockstepInputs, LockstepInputs{ 2u, 77u, { InputAction::MoveLeft, InputAction::HardDrop } }),
+        makeMessage(MessageKind::LockstepInputs, LockstepInputs{ 2u, 78u, {} }),
+        makeMessage(MessageKind::LockstepHash, LockstepHash{ 1u, 600u, 0xFFFFFFFFFFFFFFFFULL })
+    };
+}
+
+tetris::core::Span<const std::uint8_t> bytesOf(const std::vector<std::uint8_t>& v)
+{
+    return { v.data(), v.size() };
+}
+
+// A 20 x 10 board the way StateUpdateMapper fills it
+StateUpdate makeStandardStateUpdate()
+{
+    auto update = makeSmallStateUpdate();
+    auto& board = update.players[0].board;
+    board.width = 10;
+    board.height = 20;
+    board.cells.assign(200, BoardCellDTO{ false, -1 });
+    for (int i = 150; i < 200; ++i) {
+        if (i % 7 != 0) board.cells[i] = BoardCellDTO{ true, 0 };
+    }
+    return update;
+}
+
+} // namespace
+
+TEST_CASE("Binary codec round-trips every message kind", "[network][serialization][binary]")
+{
+    // The text form covers every field, so equal text means equal messages.
+    for (const auto& original : oneOfEachKind()) {
+        std::vector<std::uint8_t> frame;
+        encodeBinary(original, frame);
+        CHECK(binaryFrameSize(bytesOf(frame)) == frame.size());
+
+        const auto decoded = decodeBinary(bytesOf(frame));
+        REQUIRE(decoded.has_value());
+        CHECK(decoded->kind == original.kind);
+        CHECK(serialize(*decoded) == serialize(original));
+    }
+}
+
+TEST_CASE("Binary codec packs boards into bits", "[network][serialization][binary]")
+{
+    const auto original = makeMessage(MessageKind::StateUpdate, makeStandardStateUpdate());
+
+    std::vector<std::uint8_t> frame;
+    encodeBinary(original, frame);
+    CHECK(frame.size() < 60);
+    CHECK(frame.size() * 10 < serialize(original).size());
+
+    const auto decoded = decodeBinary(bytesOf(frame));
+    REQUIRE(decoded.has_value());
+    const auto& cells = std::get<StateUpdate>(decoded->payload).players[0].board.cells;
+    REQUIRE(cells.size() == 200);
+    CHECK(cells[151].occupied);
+    CHECK(cells[151].colorIndex == 0);
+    CHECK_FALSE(cells[154].occupied);
+    CHECK(cells[154].colorIndex == -1);
+    CHECK(serialize(*decoded) == serialize(original));
+}
+
+TEST_CASE("Binary codec packs per-piece colours into nibbles", "[network][serialization][binary]")
+{
+    // The way the GUI host fills boards: a colour per piece type, 0 when empty
+    auto update = makeStandardStateUpdate();
+    auto& board = update.players[0].board;
+    for (int i = 0; i < 200; ++i) {
+        auto& cell = board.cells[i];
+        cell.colorIndex = cell.occupied ? 1 + i % 7 : 0;
+    }
+    const auto original = makeMessage(MessageKind::StateUpdate, update);
+
+    std::vector<std::uint8_t> frame;
+    encodeBinary(original, frame);
+    CHECK(frame.size() < 90); // 43 occupied cells: 22 colour bytes
+    auto decoded = decodeBinary(bytesOf(frame));
+    REQUIRE(decoded.has_value());
+    CHECK(serialize(*decoded) == serialize(original));
+
+    // A colour out of nibble range falls back to one varint per cell
+    board.cells[160].colorIndex = 42;
+    const auto wide = makeMessage(MessageKind::StateUpdate, update);
+    std::vector<std::uint8_t> wideFrame;
+    encodeBinary(wide, wideFrame);
+    CHECK(wideFrame.size() > frame.size() + 150);
+    decoded = decodeBinary(bytesOf(wideFrame));
+    REQUIRE(decoded.has_value());
+    CHECK(serialize(*decoded) == serialize(wide));
+}
+
+TEST_CASE("Binary codec rejects truncated and corrupt frames", "[network][serialization][binary]")
+{
+    std::vector<std::uint8_t> frame;
+    encodeBinary(makeMessage(MessageKind::StateUpdate, makeSmallStateUpdate()), frame);
+
+    // Incomplete: wait for more bytes
+    for (std::size_t n = 0; n < frame.size(); ++n) {
+        CHECK(binaryFrameSize({ frame.data(), n }) == 0);
+    }
+
+    // Not a frame, or a version this peer does not know
+    const std::vector<std::uint8_t> text = { 'K', 'E', 'E', 'P' };
+    CHECK_THROWS_AS(binaryFrameSize(bytesOf(text)), std::invalid_argument);
+    auto newer = frame;
+    newer[1] = BinaryWireVersion + 1;
+    CHECK_THROWS_AS(binaryFrameSize(bytesOf(newer)), std::invalid_argument);
+    const std::vector<std::uint8_t> huge = { BinaryFrameMarker, BinaryWireVersion, 0xFF, 0xFF, 0xFF };
+    CHECK_THROWS_AS(binaryFrameSize(bytesOf(huge)), std::invalid_argument);
+
+    // Well framed but malformed bodies
+    auto badKind = frame;
+    badKind[3] = 0x7F;
+    CHECK_FALSE(decodeBinary(bytesOf(badKind)).has_value());
+
+    auto cut = frame;
+    cut.pop_back();
+    cut[2] = static_cast<std::uint8_t>(cut[2] - 1);
+    CHECK_FALSE(decodeBinary(bytesOf(cut)).has_value());
+}
+
+TEST_CASE("Binary codec bounds list counts by the bytes left", "[network][serialization][binary]")
+{
+    // A StateUpdate claiming `count` players, followed by `zeros` zero
+    // bytes; ten of those make the smallest player (empty everything).
+    auto forge = [](std::size_t count, std::size_t zeros) {
+        std::vector<std::uint8_t> body{ static_cast<std::uint8_t>(MessageKind::StateUpdate), 0, 0, 0, 0 };
+        for (std::size_t v = count; ; v >>= 7) {
+            body.push_back(static_cast<std::uint8_t>((v & 0x7F) | (v >= 0x80 ? 0x80 : 0)));
+            if (v < 0x80) break;
+        }
+        body.resize(body.size() + zeros, 0);
+
+        std::vector<std::uint8_t> frame{ BinaryFrameMarker, BinaryWireVersion };
+        for (std::size_t v = body.size(); ; v >>= 7) {
+            frame.push_back(static_cast<std::uint8_t>((v & 0x7F) | (v >= 0x80 ? 0x80 : 0)));
+            if (v < 0x80) break;
+        }
+        frame.insert(frame.end(), body.begin(), body.end());
+        return frame;
+    };
+
+    const auto fits = decodeBinary(bytesOf(forge(5, 50)));
+    REQUIRE(fits.has_value());
+    CHECK(std::get<StateUpdate>(fits->payload).players.size() == 5);
+
+    // One byte per claimed player is not enough for a player
+    CHECK_FALSE(decodeBinary(bytesOf(forge(6, 50))).has_value());
+    CHECK_FALSE(decodeBinary(bytesOf(forge(100'000, 100'000))).has_value());
+}
+
+TEST_CASE("WireCodec switches to binary only when both peers support it", "[network][serialization][binary]")
+{
+    const auto messages = oneOfEachKind();
+
+    // Feeds `bytes` to `to` in small chunks so lines and frames get split.
+    auto deliver = [](WireCodec& to, const std::vector<std::uint8_t>& bytes,
+                      std::vector<Message>& received, std::vector<std::uint8_t>& reply) {
+        for (std::size_t i = 0; i < bytes.size(); i += 5) {
+            const std::size_t n = std::min<std::size_t>(5, bytes.size() - i);
+            REQUIRE(to.receive(reinterpret_cast<const char*>(bytes.data() + i), n, received, reply));
+        }
+    };
+
+    SECTION("New client and new host")
+    {
+        WireCodec client, host;
+        std::vector<std::uint8_t> toHost, toClient, unused;
+        std::vector<Message> atHost, atClient;
+
+        client.offerBinary(toHost);
+        client.encode(messages[0], toHost); // sent before the answer: text
+        deliver(host, toHost, atHost, toClient);
+        CHECK(host.sendsBinary());
+        REQUIRE(atHost.size() == 1);
+        CHECK(serialize(atHost[0]) == serialize(messages[0]));
+
+        for (const auto& msg : messages) {
+            host.encode(msg, toClient);
+        }
+        deliver(client, toClient, atClient, unused);
+        CHECK(client.sendsBinary());
+        CHECK(unused.empty()); // the offering side does not answer
+        REQUIRE(atClient.size() == messages.size());
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            CHECK(serialize(atClient[i]) == serialize(messages[i]));
+        }
+
+        std::vector<std::uint8_t> frame;
+        client.encode(messages[4], frame);
+        CHECK(frame.front() == BinaryFrameMarker);
+    }
+
+    SECTION("Old client: the host stays on text")
+    {
+        WireCodec host;
+        std::vector<std::uint8_t> fromClient, reply;
+        std::vector<Message> atHost;
+
+        const std::string line = serialize(messages[0]) + "\n";
+        fromClient.assign(line.begin(), line.end());
+        deliver(host, fromClient, atHost, reply);
+        CHECK(atHost.size() == 1);
+        CHECK(reply.empty());
+        CHECK_FALSE(host.sendsBinary());
+
+        std::vector<std::uint8_t> out;
+        host.encode(messages[1], out);
+        CHECK(std::string(out.begin(), out.end()) == serialize(messages[1]) + "\n");
+    }
+
+    SECTION("Old host: the offer is dropped and the client stays on text")
+    {
+        WireCodec client;
+        std::vector<std::uint8_t> toHost;
+        client.offerBinary(toHost);
+
+        // What an older host does with each line: parse it or drop it
+        const std::string offer(toHost.begin(), toHost.end() - 1);
+        CHECK_FALSE(deserialize(offer).has_value());
+
+        std::vector<std::uint8_t> out;
+        client.encode(messages[0], out);
+        CHECK_FALSE(client.sendsBinary());
+        CHECK(deserialize(std::string(out.begin(), out.end() - 1)).has_value());
+    }
+
+    SECTION("A corrupt frame header closes the stream")
+    {
+        WireCodec host;
+        std::vector<Message> received;
+        std::vector<std::uint8_t> reply;
+        const char bad[] = { static_cast<char>(BinaryFrameMarker), 9, 0 };
+        CHECK_FALSE(host.receive(bad, sizeof(bad), received, reply));
+    }
+}
+
 // ============================
 // NetworkClient tests
 // ============================
@@ -392,6 +814,101 @@ TEST_CASE("NetworkHost stores incoming InputActionMessage (queue)", "[network][h
     CHECK(q[0].action == tetris::controller::InputAction::SoftDrop);
 }
 
+TEST_CASE("NetworkHost relays lockstep frames to the other clients", "[network][host][lockstep]")
+{
+    MultiplayerConfig cfg;
+    cfg.isHost = true;
+    cfg.lockstep = true;
+    cfg.lockstepTickMs = 10;
+    cfg.inputDelayTicks = 4;
+
+    NetworkHost host(cfg);
+    auto s1 = std::make_shared<FakeNetworkSession>();
+    auto s2 = std::make_shared<FakeNetworkSession>();
+    host.addClient(s1);
+    host.addClient(s2);
+
+    Message req;
+    req.kind = MessageKind::JoinRequest;
+    req.payload = JoinRequest{ "A" };
+    s1->injectIncoming(req);
+    s2->injectIncoming(req);
+    const PlayerId id1 = extractAssignedIdOrFail(s1);
+
+    host.startMatch();
+    const auto start = s1->lastOfKind(MessageKind::StartGame);
+    REQUIRE(start.has_value());
+    CHECK(std::get<StartGame>(start->payload).lockstepTickMs == 10u);
+    CHECK(std::get<StartGame>(start->payload).inputDelayTicks == 4u);
+
+    s1->sentMessages.clear();
+    s2->sentMessages.clear();
+
+    Message frame;
+    frame.kind = MessageKind::LockstepInputs;
+    frame.payload = LockstepInputs{ id1, 4u, { tetris::controller::InputAction::RotateCW } };
+    s1->injectIncoming(frame);
+
+    CHECK(s1->countKind(MessageKind::LockstepInputs) == 0);
+    CHECK(s2->countKind(MessageKind::LockstepInputs) == 1);
+    auto q = host.consumeLockstepMessages();
+    REQUIRE(q.size() == 1);
+    CHECK(std::get<LockstepInputs>(q[0].payload).tick == 4u);
+
+    // A client cannot send frames on behalf of another player
+    frame.payload = LockstepInputs{ id1 + 1, 5u, {} };
+    s1->injectIncoming(frame);
+    CHECK(s2->countKind(MessageKind::LockstepInputs) == 1);
+    CHECK(host.consumeLockstepMessages().empty());
+}
+
+TEST_CASE("NetworkHost broadcast can be re-entered from a send", "[network][host]")
+{
+    // A session whose first send broadcasts again, as a handler may
+    class EchoingSession final : public FakeNetworkSession {
+    public:
+        explicit EchoingSession(NetworkHost& host) : m_host(host) {}
+        void send(const Message& msg) override
+        {
+            FakeNetworkSession::send(msg);
+            if (msg.kind == MessageKind::Error && !m_echoed) {
+                m_echoed = true;
+                Message ka;
+                ka.kind = MessageKind::KeepAlive;
+                ka.payload = KeepAlive{};
+                m_host.broadcast(ka);
+            }
+        }
+    private:
+        NetworkHost& m_host;
+        bool m_echoed{false};
+    };
+
+    MultiplayerConfig cfg;
+    cfg.isHost = true;
+    NetworkHost host(cfg);
+    NetworkHost otherHost(cfg);
+    auto echoing = std::make_shared<EchoingSession>(host);
+    auto plain = std::make_shared<FakeNetworkSession>();
+    auto other = std::make_shared<FakeNetworkSession>();
+    host.addClient(echoing);
+    host.addClient(plain);
+    otherHost.addClient(other);
+
+    Message error;
+    error.kind = MessageKind::Error;
+    error.payload = ErrorMessage{ "boom" };
+    host.broadcast(error);
+    otherHost.broadcast(error);
+
+    for (const auto* s : { static_cast<FakeNetworkSession*>(echoing.get()), plain.get() }) {
+        CHECK(s->countKind(MessageKind::Error) == 1);
+        CHECK(s->countKind(MessageKind::KeepAlive) == 1);
+    }
+    CHECK(other->countKind(MessageKind::Error) == 1);
+    CHECK(other->countKind(MessageKind::KeepAlive) == 0);
+}
+
 // ============================
 // HostGameSession tests (using SharedTurnRules only, no TimeAttackRules header)
 // ============================
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "core/Random.hpp"
+#include "core/TetrominoFactory.hpp"
+#include "core/GameState.hpp"
+#include "core/PieceQueue.hpp"
+
+using namespace tetris::core;
+
+TEST_CASE("Randomizer: Pcg32 matches the reference sequence", "[random][pcg]")
+{
+    // pcg32_srandom_r(42, 54) from the reference implementation
+    Pcg32 rng{42u, 54u};
+    CHECK(rng.next() == 0xa15c02b7u);
+    CHECK(rng.next() == 0x7b47f409u);
+    CHECK(rng.next() == 0xba1d3330u);
+    CHECK(rng.next() == 0x83d2f293u);
+
+    Pcg32 bounded{7u};
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(bounded.bounded(7u) < 7u);
+    }
+}
+
+TEST_CASE("Randomizer: every bag of seven holds each piece once", "[random][bag]")
+{
+    SevenBagRandomizer bag{123u};
+    for (int round = 0; round < 50; ++round) {
+        std::array<int, 7> seen{};
+        for (int i = 0; i < 7; ++i) {
+            ++seen[static_cast<int>(bag.next())];
+        }
+        for (int count : seen) {
+            REQUIRE(count == 1);
+        }
+    }
+}
+
+TEST_CASE("Randomizer: same seed deals the same pieces", "[random][seed]")
+{
+    TetrominoFactory a{99u};
+    TetrominoFactory b{99u};
+    TetrominoFactory c{100u};
+
+    std::vector<TetrominoType> seqA, seqB, seqC;
+    for (int i = 0; i < 70; ++i) {
+        seqA.push_back(a.createRandom(Position{0, 0}).type());
+        seqB.push_back(b.createRandom(Position{0, 0}).type());
+        seqC.push_back(c.createRandom(Position{0, 0}).type());
+    }
+    CHECK(seqA == seqB);
+    CHECK(seqA != seqC);
+
+    // Reseeding restarts the sequence
+    a.setSeed(99u);
+    CHECK(a.seed() == 99u);
+    CHECK(a.createRandom(Position{0, 0}).type() == seqA[0]);
+}
+
+TEST_CASE("Randomizer: seeded GameStates replay identically", "[random][seed][gameplay]")
+{
+    GameState g1{20, 10, 0};
+    GameState g2{20, 10, 0};
+    g1.setSeed(2024u);
+    g2.setSeed(2024u);
+    g1.start();
+    g2.start();
+
+    for (int i = 0; i < 200; ++i) {
+        for (GameState* g : {&g1, &g2}) {
+            if (i % 3 == 0) g->moveLeft();
+            if (i % 5 == 0) g->rotateClockwise();
+            g->hardDrop();
+        }
+        REQUIRE(g1.status() == g2.status());
+        REQUIRE(g1.score() == g2.score());
+        REQUIRE(g1.board().hash() == g2.board().hash());
+        if (g1.status() != GameStatus::Running) break;
+        REQUIRE(g1.activeTetromino()->type() == g2.activeTetromino()->type());
+    }
+}
+
+TEST_CASE("Randomizer: preview queue shows the pieces that spawn next", "[random][preview]")
+{
+    GameState game{20, 10, 0};
+    game.setSeed(5u);
+    game.setPreviewDepth(5);
+    CHECK(game.preview().empty());
+    CHECK_FALSE(game.nextTetromino().has_value());
+
+    game.start();
+    REQUIRE(game.preview().size() == 5u);
+
+    for (int i = 0; i < 40 && game.status() == GameStatus::Running; ++i) {
+        const auto upcoming = game.preview();
+        REQUIRE(upcoming.size() == 5u);
+        REQUIRE(game.nextTetromino()->type() == upcoming[0]);
+
+        const std::vector<TetrominoType> expected(upcoming.begin() + 1, upcoming.end());
+        game.hardDrop();
+        if (game.status() != GameStatus::Running) break;
+
+        // The head became the active piece, everything else moved up one
+        REQUIRE(game.activeTetromino()->type() == upcoming.front());
+        const auto after = game.preview();
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            REQUIRE(after[k] == expected[k]);
+        }
+    }
+
+    game.reset();
+    CHECK(game.preview().empty());
+}
+
+TEST_CASE("Randomizer: preview depth is limited to one bag", "[random][preview]")
+{
+    PieceQueue queue;
+    CHECK(queue.depth() == 1);
+    CHECK_THROWS_AS(queue.setDepth(0), std::invalid_argument);
+    CHECK_THROWS_AS(queue.setDepth(8), std::invalid_argument);
+
+    // Same seed, same stream: the queue only buffers the factory's sequence
+    TetrominoFactory direct{11u};
+    TetrominoFactory queued{11u};
+    queue.setDepth(7);
+    queue.fill(queued);
+    REQUIRE(queue.preview().size() == 7u);
+
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(queue.pop(queued) == direct.nextType());
+        REQUIRE(queue.preview().size() == 7u);
+        REQUIRE(queue.size() <= PieceQueue::Capacity);
+    }
+}
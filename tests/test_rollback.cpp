@@ -0,0 +1,224 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "network/RollbackSession.hpp"
+#include "network/MessageTypes.hpp"
+#include "network/Serialization.hpp"
+#include "controller/GameController.hpp"
+#include "controller/InputAction.hpp"
+
+using namespace tetris::net;
+using tetris::controller::InputAction;
+
+namespace {
+
+// One direction of a connection with a fixed latency in frames. Messages
+// go through the text protocol like a real connection would.
+class Link {
+public:
+    explicit Link(int latencyFrames) : m_latency(latencyFrames) {}
+
+    void pump(RollbackSession& from, RollbackSession& to, int frame)
+    {
+        std::vector<Message> out;
+        from.takeOutgoing(out);
+        for (const auto& msg : out) {
+            m_inFlight.push_back({ frame + m_latency, serialize(msg) });
+        }
+        while (!m_inFlight.empty() && m_inFlight.front().due <= frame) {
+            const auto parsed = deserialize(m_inFlight.front().line);
+            REQUIRE(parsed.has_value());
+            to.receive(*parsed);
+            m_inFlight.pop_front();
+        }
+    }
+
+private:
+    struct Packet {
+        int due;
+        std::string line;
+    };
+    int m_latency;
+    std::deque<Packet> m_inFlight;
+};
+
+RollbackSession::Config smallConfig(std::uint32_t window = 8)
+{
+    RollbackSession::Config cfg;
+    cfg.tickMs = 16;
+    cfg.inputDelayTicks = 1;
+    cfg.rollbackWindowTicks = window;
+    cfg.hashIntervalTicks = 10;
+    return cfg;
+}
+
+constexpr InputAction kScript[] = {
+    InputAction::MoveLeft, InputAction::RotateCW, InputAction::HardDrop,
+    InputAction::MoveRight, InputAction::MoveRight, InputAction::SoftDrop,
+    InputAction::RotateCCW, InputAction::HardDrop
+};
+
+// Runs both peers until every frame is delivered and their ticks match.
+void settle(RollbackSession& a, RollbackSession& b, Link& ab, Link& ba, int& frame)
+{
+    for (int i = 0; i < 64; ++i, ++frame) {
+        if (a.tick() < b.tick()) a.advance();
+        else if (b.tick() < a.tick()) b.advance();
+        else {
+            a.advance(0);
+            b.advance(0);
+        }
+        ab.pump(a, b, frame);
+        ba.pump(b, a, frame);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Rollback: peers keep running on late frames and converge", "[network][rollback]")
+{
+    RollbackSession a(1, { 1, 2 }, 321, smallConfig());
+    RollbackSession b(2, { 1, 2 }, 321, smallConfig());
+    Link ab(3), ba(3);
+
+    int frame = 0;
+    for (; frame < 300; ++frame) {
+        a.addLocalInput(kScript[frame % 8]);
+        if (frame % 3 == 0) {
+            b.addLocalInput(kScript[(frame / 3) % 8]);
+        }
+        CHECK(a.advance() == 1); // never stalls inside the window
+        CHECK(b.advance() == 1);
+        ab.pump(a, b, frame);
+        ba.pump(b, a, frame);
+    }
+
+    CHECK(a.rollbacks() > 0);
+    CHECK(b.rollbacks() > 0);
+    CHECK(a.maxRollbackTicks() <= 8);
+
+    settle(a, b, ab, ba, frame);
+    REQUIRE(a.tick() == b.tick());
+    CHECK(a.confirmedTick() == a.tick());
+    CHECK(a.confirmedGame(2).board().hash() == a.game(2).board().hash());
+    CHECK(a.stateHash() == b.stateHash());
+    CHECK(a.game(2).board().hash() == b.game(2).board().hash());
+    CHECK(a.game(1).lockedPieces() > 0);
+    CHECK(b.game(2).lockedPieces() > 0);
+    CHECK_FALSE(a.desynced());
+    CHECK_FALSE(b.desynced());
+}
+
+TEST_CASE("Rollback: a late input lands at the tick it was made", "[network][rollback]")
+{
+    RollbackSession a(1, { 1, 2 }, 8, smallConfig());
+    RollbackSession b(2, { 1, 2 }, 8, smallConfig());
+
+    b.addLocalInput(InputAction::HardDrop);
+    b.advance();
+
+    // `a` runs ahead predicting that `b` did nothing
+    a.advance(5);
+    CHECK(a.game(2).lockedPieces() == 0);
+
+    std::vector<Message> out;
+    b.takeOutgoing(out);
+    for (const auto& msg : out) {
+        a.receive(msg);
+    }
+    a.advance(0);
+    CHECK(a.rollbacks() == 1);
+    CHECK(a.maxRollbackTicks() == 4); // ticks 1..4 re-simulated
+    CHECK(a.game(2).lockedPieces() == 1);
+}
+
+TEST_CASE("Rollback: a session stops when a peer falls out of the window", "[network][rollback]")
+{
+    RollbackSession a(1, { 1, 2 }, 5, smallConfig(4));
+
+    // Tick 0 needs no remote frame (input delay), then four predicted ticks
+    CHECK(a.advance(20) == 5);
+    CHECK(a.confirmedTick() == 1);
+    CHECK(a.advance(20) == 0);
+
+    Message msg;
+    msg.kind = MessageKind::LockstepInputs;
+    for (Tick t = 1; t <= 3; ++t) {
+        msg.payload = LockstepInputs{ 2u, t, {} };
+        a.receive(msg);
+    }
+    CHECK(a.confirmedTick() == 4);
+    CHECK(a.advance(20) == 3);
+    CHECK(a.rollbacks() == 0); // empty frames matched the prediction
+}
+
+TEST_CASE("Rollback: mismatched hashes mark the session as desynced", "[network][rollback]")
+{
+    RollbackSession a(1, { 1, 2 }, 100, smallConfig());
+    RollbackSession b(2, { 1, 2 }, 101, smallConfig());
+    Link ab(1), ba(1);
+
+    for (int frame = 0; frame < 40; ++frame) {
+        a.advance();
+        b.advance();
+        ab.pump(a, b, frame);
+        ba.pump(b, a, frame);
+    }
+
+    REQUIRE(a.desynced());
+    REQUIRE(b.desynced());
+    CHECK(*a.desyncTick() == 10);
+}
+
+TEST_CASE("Rollback: restoring controller timing replays gravity exactly", "[network][rollback]")
+{
+    using tetris::controller::GameController;
+
+    tetris::core::GameState game;
+    game.setSeed(3);
+    game.start();
+    GameController ctrl(game);
+
+    ctrl.update(GameController::Duration{700});
+    const auto savedGame = game;
+    const auto savedTiming = ctrl.accumulatedTime();
+
+    ctrl.update(GameController::Duration{700});
+    const auto row = game.activeTetromino()->origin().row;
+
+    game = savedGame;
+    ctrl.restoreTiming(savedTiming);
+    ctrl.update(GameController::Duration{700});
+    CHECK(game.activeTetromino()->origin().row == row);
+}
+
+TEST_CASE("Rollback: confirmed games leave out predicted remote ticks", "[network][rollback]")
+{
+    RollbackSession a(1, { 1, 2 }, 8, smallConfig());
+    RollbackSession b(2, { 1, 2 }, 8, smallConfig());
+
+    b.addLocalInput(InputAction::HardDrop);
+    b.advance();
+    a.advance(5);
+    CHECK(a.confirmedTick() == 1);
+    CHECK(a.confirmedElapsedMs() == 16);
+
+    std::vector<Message> out;
+    b.takeOutgoing(out);
+    for (const auto& msg : out) {
+        a.receive(msg);
+    }
+
+    // Frames 1 and 2 are known, but the rollback has not run yet
+    CHECK(a.confirmedTick() == 1);
+    CHECK(a.confirmedGame(2).lockedPieces() == 0);
+
+    a.advance(0);
+    CHECK(a.confirmedTick() == 3);
+    CHECK(a.confirmedGame(2).lockedPieces() == 1);
+    CHECK(a.confirmedGame(2).board().hash() != a.confirmedGame(1).board().hash());
+    CHECK_THROWS_AS(a.confirmedGame(7), std::out_of_range);
+}
@@ -80,6 +80,43 @@ TEST_CASE("ScoringAndLines: Board clears multiple lines", "[scoring][board][line
     }
 }
 
+TEST_CASE("ScoringAndLines: Board reports which rows were cleared", "[scoring][board][lines]")
+{
+    Board b{5, 4};
+
+    // Full rows 1 and 3 with survivors above, between and below them
+    for (int c = 0; c < 4; ++c) {
+        b.setCell(1, c, CellState::Filled);
+        b.setCell(3, c, CellState::Filled);
+    }
+    b.setCell(0, 0, CellState::Filled);
+    b.setCell(2, 1, CellState::Filled);
+    b.setCell(4, 2, CellState::Filled);
+
+    const auto result = b.clearLines();
+    REQUIRE(result.count == 2);
+    CHECK(result.contains(1));
+    CHECK(result.contains(3));
+    CHECK_FALSE(result.contains(0));
+    CHECK_FALSE(result.contains(2));
+    CHECK_FALSE(result.contains(4));
+
+    // Survivors keep their relative order: 0 -> 2, 2 -> 3, 4 stays
+    CHECK(b.cell(4, 2) == CellState::Filled);
+    CHECK(b.cell(3, 1) == CellState::Filled);
+    CHECK(b.cell(2, 0) == CellState::Filled);
+    for (int r = 0; r < 2; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            CHECK(b.cell(r, c) == CellState::Empty);
+        }
+    }
+
+    // Nothing left to clear
+    const auto again = b.clearLines();
+    CHECK(again.count == 0);
+    CHECK(again.rows == 0u);
+}
+
 TEST_CASE("ScoringAndLines: ScoreManager follows classic Tetris scoring", "[scoring][scoremanager]")
 {
     ScoreManager s;
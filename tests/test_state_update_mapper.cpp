@@ -78,4 +78,69 @@ TEST_CASE("StateUpdateMapper: game over state",
 
     // Check isAlive flag
     CHECK(dto.isAlive == false);
-}
\ No newline at end of file
+}
+TEST_CASE("StateUpdateMapper: incremental refresh matches a full export",
+          "[network][stateupdate][mapper][dirty]")
+{
+    using namespace tetris;
+
+    core::GameState gs;
+    gs.start();
+
+    net::PlayerStateDTO cached;
+    net::StateUpdateMapper::BoardCache cache;
+
+    for (int step = 0; step < 300 && gs.status() == core::GameStatus::Running; ++step) {
+        switch (step % 4) {
+        case 0: gs.moveLeft(); break;
+        case 1: gs.rotateClockwise(); break;
+        case 2: gs.moveRight(); gs.moveRight(); break;
+        default: gs.hardDrop(); break;
+        }
+
+        net::StateUpdateMapper::updatePlayerDTO(cached, cache, 7u, "Ann", gs);
+        REQUIRE(cache.epoch == gs.board().epoch());
+
+        const auto full = net::StateUpdateMapper::toPlayerDTO(7u, "Ann", gs);
+        REQUIRE(cached.score == full.score);
+        REQUIRE(cached.board.cells.size() == full.board.cells.size());
+        for (std::size_t i = 0; i < full.board.cells.size(); ++i) {
+            REQUIRE(cached.board.cells[i].occupied == full.board.cells[i].occupied);
+            REQUIRE(cached.board.cells[i].colorIndex == full.board.cells[i].colorIndex);
+        }
+    }
+}
+
+TEST_CASE("StateUpdateMapper: a cache from another board forces a full export",
+          "[network][stateupdate][mapper][dirty]")
+{
+    using namespace tetris;
+
+    // Two games whose boards reach similar epochs with different cells
+    core::GameState first;
+    core::GameState second;
+    first.setSeed(1);
+    second.setSeed(2);
+    first.start();
+    second.start();
+    first.moveLeft();
+    first.moveLeft();
+    first.hardDrop();
+    for (int i = 0; i < 3; ++i) {
+        second.moveRight();
+        second.hardDrop();
+    }
+    REQUIRE(second.board().epoch() >= first.board().epoch());
+
+    net::PlayerStateDTO cached;
+    net::StateUpdateMapper::BoardCache cache;
+    net::StateUpdateMapper::updatePlayerDTO(cached, cache, 7u, "Ann", first);
+    net::StateUpdateMapper::updatePlayerDTO(cached, cache, 7u, "Ann", second);
+    CHECK(cache.board == &second.board());
+
+    const auto full = net::StateUpdateMapper::toPlayerDTO(7u, "Ann", second);
+    REQUIRE(cached.board.cells.size() == full.board.cells.size());
+    for (std::size_t i = 0; i < full.board.cells.size(); ++i) {
+        REQUIRE(cached.board.cells[i].occupied == full.board.cells[i].occupied);
+    }
+}